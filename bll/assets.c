@@ -0,0 +1,288 @@
+#include "assets.h"
+#include <stdlib.h>
+
+// Scales down, never up, to fit inside maxWidth x maxHeight
+static void FitImage(Image *image, int maxWidth, int maxHeight) {
+    float scale = 1.0f;
+    if (maxWidth > 0 && image->width > maxWidth) scale = (float)maxWidth / image->width;
+    if (maxHeight > 0 && image->height * scale > maxHeight) scale = (float)maxHeight / image->height;
+    if (scale >= 1.0f) return;
+
+    int width = (int)(image->width * scale + 0.5f);
+    int height = (int)(image->height * scale + 0.5f);
+    ImageResize(image, (width > 0) ? width : 1, (height > 0) ? height : 1);
+}
+
+static bool ImageIsOpaque(Image image) {
+    if (image.format == PIXELFORMAT_UNCOMPRESSED_GRAYSCALE || image.format == PIXELFORMAT_UNCOMPRESSED_R8G8B8 ||
+        image.format == PIXELFORMAT_UNCOMPRESSED_R5G6B5) return true;
+    Color *pixels = LoadImageColors(image);
+    if (pixels == NULL) return false;
+    bool opaque = true;
+    for (int i = 0; i < image.width * image.height && opaque; i++) opaque = (pixels[i].a == 255);
+    UnloadImageColors(pixels);
+    return opaque;
+}
+
+// GPU memory of a texture, mip chain included
+static int TextureBytes(int width, int height, int format, int mipmaps) {
+    int bytes = 0;
+    for (int level = 0; level < mipmaps; level++) {
+        bytes += GetPixelDataSize(width, height, format);
+        width = (width > 1) ? width / 2 : 1;
+        height = (height > 1) ? height / 2 : 1;
+    }
+    return bytes;
+}
+
+static const char *PixelFormatName(int format) {
+    switch (format) {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: return "L8";
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5: return "RGB565";
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8: return "RGB8";
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8: return "RGBA8";
+        default: return TextFormat("format %d", format);
+    }
+}
+
+// Worker thread safe: file IO and CPU image work only
+static void DecodeAsset(Asset *asset) {
+    if (!FileExists(asset->path)) TraceLog(LOG_WARNING, "ASSETS: %s missing!", asset->path);
+    if (asset->kind == ASSET_TEXTURE) {
+        asset->image = LoadImage(asset->path);
+        if (asset->image.data != NULL) {
+            if (asset->shrink > 1) {
+                ImageResize(&asset->image, asset->image.width / asset->shrink, asset->image.height / asset->shrink);
+            }
+            FitImage(&asset->image, asset->maxWidth, asset->maxHeight);
+            // Dither before the mips so the large level shows no banding
+            if (asset->compact && ImageIsOpaque(asset->image)) ImageDither(&asset->image, 5, 6, 5, 0);
+            if (asset->mipmaps) ImageMipmaps(&asset->image);
+        }
+    } else {
+        asset->wave = LoadWave(asset->path);
+    }
+    atomic_store(&asset->state, ASSET_DECODED);
+}
+
+// Main thread only: GL and the audio device live here
+static void UploadAsset(AssetLoader *loader, Asset *asset) {
+    if (asset->kind == ASSET_TEXTURE) {
+        if (asset->image.data != NULL) {
+            Texture2D *texture = asset->texture;
+            *texture = LoadTextureFromImage(asset->image);
+            if (texture->mipmaps > 1) SetTextureFilter(*texture, TEXTURE_FILTER_TRILINEAR);
+            asset->bytes = TextureBytes(texture->width, texture->height, texture->format, texture->mipmaps);
+        }
+        UnloadImage(asset->image);
+        asset->image = (Image){0};
+    } else {
+        if (asset->wave.data != NULL) {
+            *asset->sound = LoadSoundFromWave(asset->wave);
+            asset->bytes = (int)asset->wave.frameCount * asset->wave.channels * asset->wave.sampleSize / 8;
+        }
+        UnloadWave(asset->wave);
+        asset->wave = (Wave){0};
+    }
+    if (loader->residentCount < ASSET_MAX_RESIDENT) loader->resident[loader->residentCount++] = asset;
+    loader->residentBytes += asset->bytes;
+    atomic_store(&asset->state, ASSET_RESIDENT);
+}
+
+// Decoded but nobody wants it any more
+static void DropDecoded(Asset *asset) {
+    UnloadImage(asset->image);
+    UnloadWave(asset->wave);
+    asset->image = (Image){0};
+    asset->wave = (Wave){0};
+    atomic_store(&asset->state, ASSET_UNLOADED);
+}
+
+static void EvictAsset(AssetLoader *loader, Asset *asset) {
+    for (int i = 0; i < loader->residentCount; i++) {
+        if (loader->resident[i] == asset) {
+            loader->resident[i] = loader->resident[--loader->residentCount];
+            break;
+        }
+    }
+    loader->residentBytes -= asset->bytes;
+    if (asset->kind == ASSET_TEXTURE) {
+        if (asset->texture->id != 0) UnloadTexture(*asset->texture);
+        *asset->texture = (Texture2D){0};
+    } else {
+        if (asset->sound->frameCount > 0) UnloadSound(*asset->sound);
+        *asset->sound = (Sound){0};
+    }
+    asset->bytes = 0;
+    atomic_store(&asset->state, ASSET_UNLOADED);
+}
+
+// Evicts released assets, least recently used first, until back in budget
+static void TrimAssets(AssetLoader *loader) {
+    while (loader->residentBytes > loader->budget) {
+        Asset *oldest = NULL;
+        for (int i = 0; i < loader->residentCount; i++) {
+            Asset *asset = loader->resident[i];
+            if (asset->refs == 0 && (oldest == NULL || asset->lastUsed < oldest->lastUsed)) oldest = asset;
+        }
+        if (oldest == NULL) {
+            if (!loader->overBudget) {
+                TraceLog(LOG_WARNING, "ASSETS: held assets use %.1f MB, over the %.1f MB budget",
+                         loader->residentBytes / (1024.0f * 1024.0f), loader->budget / (1024.0f * 1024.0f));
+            }
+            loader->overBudget = true;
+            return;
+        }
+        EvictAsset(loader, oldest);
+    }
+    loader->overBudget = false;
+}
+
+static void DecodeJobs(void *arg) {
+    AssetLoader *loader = (AssetLoader *)arg;
+    for (int i = 0; i < loader->jobCount; i++) DecodeAsset(loader->jobs[i]);
+    atomic_store(&loader->workerDone, 1);
+}
+
+// Uploads or drops the worker's finished decodes
+static void CollectJobs(AssetLoader *loader) {
+    for (int i = 0; i < loader->jobCount; i++) {
+        Asset *asset = loader->jobs[i];
+        if (atomic_load(&asset->state) != ASSET_DECODED) continue;
+        if (asset->refs > 0) UploadAsset(loader, asset);
+        else DropDecoded(asset);
+    }
+}
+
+static void WaitForWorker(AssetLoader *loader) {
+    if (!loader->working) return;
+    JoinThread(&loader->worker);
+    loader->working = false;
+    CollectJobs(loader);
+    loader->jobCount = 0;
+}
+
+void HoldAssetSet(AssetLoader *loader, AssetSet *set, bool hold, bool prefetch) {
+    if (set->held == hold) return;
+    set->held = hold;
+
+    for (int i = 0; i < set->count; i++) {
+        Asset *asset = set->assets[i];
+        if (!hold) {
+            // Resident ones stay cached until TrimAssets; queued or decoding
+            // ones are dropped when they come back
+            if (--asset->refs == 0) asset->lastUsed = loader->frame;
+            continue;
+        }
+        if (asset->refs++ > 0 || atomic_load(&asset->state) != ASSET_UNLOADED) continue;
+        if (prefetch && loader->queued < ASSET_QUEUE_SIZE) {
+            atomic_store(&asset->state, ASSET_QUEUED);
+            loader->queue[loader->queued++] = asset;
+        } else {
+            DecodeAsset(asset);
+            UploadAsset(loader, asset);
+        }
+    }
+    TrimAssets(loader);
+}
+
+void UpdateAssetLoader(AssetLoader *loader) {
+    loader->frame++;
+    TrimAssets(loader);
+    if (loader->working) {
+        // Uploads can start while the worker is still on later files
+        CollectJobs(loader);
+        if (!atomic_load(&loader->workerDone)) return;
+        WaitForWorker(loader);
+    }
+    if (loader->queued == 0) return;
+
+    // Hand over everything still wanted; FinishAssetSet may have loaded some already
+    loader->jobCount = 0;
+    for (int i = 0; i < loader->queued; i++) {
+        Asset *asset = loader->queue[i];
+        if (atomic_load(&asset->state) != ASSET_QUEUED) continue;
+        if (asset->refs == 0) {
+            atomic_store(&asset->state, ASSET_UNLOADED);
+            continue;
+        }
+        loader->jobs[loader->jobCount++] = asset;
+    }
+    loader->queued = 0;
+    if (loader->jobCount == 0) return;
+
+    atomic_store(&loader->workerDone, 0);
+    loader->working = StartThread(&loader->worker, DecodeJobs, loader);
+    if (!loader->working) {
+        // No thread to be had, decode in place
+        DecodeJobs(loader);
+        CollectJobs(loader);
+        loader->jobCount = 0;
+    }
+}
+
+void FinishAssetSet(AssetLoader *loader, AssetSet *set) {
+    if (!set->held || AssetSetResident(set)) return;
+    WaitForWorker(loader);
+    for (int i = 0; i < set->count; i++) {
+        Asset *asset = set->assets[i];
+        int state = atomic_load(&asset->state);
+        // Still in the queue: load it here, the queue skips it later
+        if (state == ASSET_QUEUED) DecodeAsset(asset);
+        if (atomic_load(&asset->state) == ASSET_DECODED) UploadAsset(loader, asset);
+    }
+    TrimAssets(loader);
+}
+
+bool AssetSetResident(const AssetSet *set) {
+    for (int i = 0; i < set->count; i++) {
+        if (atomic_load(&set->assets[i]->state) != ASSET_RESIDENT) return false;
+    }
+    return true;
+}
+
+int AssetSetBytes(const AssetSet *set) {
+    int bytes = 0;
+    for (int i = 0; i < set->count; i++) bytes += set->assets[i]->bytes;
+    return bytes;
+}
+
+long AssetCachedBytes(const AssetLoader *loader) {
+    long bytes = 0;
+    for (int i = 0; i < loader->residentCount; i++) {
+        if (loader->resident[i]->refs == 0) bytes += loader->resident[i]->bytes;
+    }
+    return bytes;
+}
+
+void LogAssetMemory(const AssetLoader *loader) {
+    TraceLog(LOG_INFO, "ASSETS: %.1f MB resident, budget %.1f MB", loader->residentBytes / (1024.0f * 1024.0f),
+             loader->budget / (1024.0f * 1024.0f));
+    for (int i = 0; i < loader->residentCount; i++) {
+        const Asset *asset = loader->resident[i];
+        if (asset->kind == ASSET_TEXTURE) {
+            const Texture2D *texture = asset->texture;
+            TraceLog(LOG_INFO, "ASSETS: %8.1f KB  %4dx%-4d %-6s mips %2d  refs %d  %s", asset->bytes / 1024.0f,
+                     texture->width, texture->height, PixelFormatName(texture->format), texture->mipmaps, asset->refs, asset->path);
+        } else {
+            TraceLog(LOG_INFO, "ASSETS: %8.1f KB  sound                  refs %d  %s", asset->bytes / 1024.0f,
+                     asset->refs, asset->path);
+        }
+    }
+}
+
+void UnloadAssetLoader(AssetLoader *loader) {
+    if (loader->working) {
+        JoinThread(&loader->worker);
+        loader->working = false;
+    }
+    for (int i = 0; i < loader->jobCount; i++) {
+        if (atomic_load(&loader->jobs[i]->state) == ASSET_DECODED) DropDecoded(loader->jobs[i]);
+    }
+    for (int i = 0; i < loader->queued; i++) {
+        if (atomic_load(&loader->queue[i]->state) == ASSET_QUEUED) atomic_store(&loader->queue[i]->state, ASSET_UNLOADED);
+    }
+    loader->jobCount = 0;
+    loader->queued = 0;
+    while (loader->residentCount > 0) EvictAsset(loader, loader->resident[0]);
+}
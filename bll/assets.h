@@ -0,0 +1,98 @@
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "raylib.h"
+#include "thread.h"
+
+// Reference-counted scene assets. Each scene lists what it draws in an
+// AssetSet, and an asset stays resident while any held set uses it. Sets can
+// be held for prefetch: a worker thread reads and decodes the files, which
+// needs no GL or audio calls, and the main thread uploads the results in
+// UpdateAssetLoader. The game's own Texture2D/Sound variables are filled in
+// on upload and zeroed on eviction, so draw code keeps its `.id != 0` checks.
+//
+// Textures are uploaded no larger than they are ever drawn, mipmapped when
+// they are drawn minified, and stored as dithered 16-bit RGB when opaque.
+// Released assets stay cached until the loader's VRAM budget is exceeded,
+// then the least recently used go first.
+#define ASSET_QUEUE_SIZE 64
+#define ASSET_MAX_RESIDENT 64
+
+typedef enum {
+    ASSET_TEXTURE,
+    ASSET_SOUND
+} AssetKind;
+
+typedef enum {
+    ASSET_UNLOADED,
+    ASSET_QUEUED,       // waiting for, or being decoded by, the worker
+    ASSET_DECODED,      // in memory, waiting for upload
+    ASSET_RESIDENT
+} AssetState;
+
+typedef struct {
+    const char *path;
+    AssetKind kind;
+    int shrink;             // textures are divided by this on each side before upload; 0 or 1 for none
+    int maxWidth;           // largest on-screen size, aspect kept; 0 for no limit on that side
+    int maxHeight;
+    bool mipmaps;           // drawn minified: upload a mip chain and sample trilinear
+    bool compact;           // 16-bit RGB if no pixel is transparent
+    Texture2D *texture;     // the game's handle, zeroed while not resident
+    Sound *sound;
+    int refs;               // held sets using it
+    atomic_int state;
+    Image image;            // decoded, waiting for upload
+    Wave wave;
+    int bytes;              // texture or sample memory while resident
+    unsigned lastUsed;      // loader frame of the last release, for eviction
+} Asset;
+
+typedef struct {
+    const char *name;
+    Asset **assets;
+    int count;
+    bool held;
+} AssetSet;
+
+typedef struct {
+    Asset *queue[ASSET_QUEUE_SIZE];     // held for prefetch, not yet handed to the worker
+    int queued;
+    Asset *jobs[ASSET_QUEUE_SIZE];      // the running (or last) worker batch
+    int jobCount;
+    Thread worker;
+    bool working;
+    atomic_int workerDone;
+    Asset *resident[ASSET_MAX_RESIDENT];
+    int residentCount;
+    long residentBytes;
+    long budget;                        // resident bytes to stay under; 0 caches nothing released
+    unsigned frame;
+    bool overBudget;                    // held assets alone exceed the budget (warned once)
+} AssetLoader;
+
+// Takes or drops the set's references. Newly needed assets load right away,
+// or are queued for the worker with prefetch. Holding a held set (or
+// releasing a released one) does nothing.
+void HoldAssetSet(AssetLoader *loader, AssetSet *set, bool hold, bool prefetch);
+
+// Once per frame: uploads what the worker decoded and starts the next batch
+void UpdateAssetLoader(AssetLoader *loader);
+
+// Blocks until every asset of a held set is resident
+void FinishAssetSet(AssetLoader *loader, AssetSet *set);
+
+bool AssetSetResident(const AssetSet *set);
+int AssetSetBytes(const AssetSet *set);
+long AssetCachedBytes(const AssetLoader *loader);
+
+// One TraceLog line per resident asset: size, format, mips, memory, refs
+void LogAssetMemory(const AssetLoader *loader);
+
+// Waits for the worker, drops anything decoded but not uploaded and unloads
+// the cache. Release the sets first.
+void UnloadAssetLoader(AssetLoader *loader);
+
+#endif // ASSETS_H
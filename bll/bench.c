@@ -0,0 +1,801 @@
+// Headless benchmarks for the game's simulation systems.
+// Build: gcc -O2 bench.c spatialhash.c profiler.c dictionary.c wordlehint.c thread.c rigidbody.c throwpath.c bowling.c fallingballs.c framepacer.c vecbatch.c drawlist.c poisson.c -lm -lpthread -o bench
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "raylib.h"
+#define RAYMATH_STATIC_INLINE
+#include "raymath.h"
+#include "spatialhash.h"
+#include "profiler.h"
+#include "dictionary.h"
+#include "wordlehint.h"
+#include "thread.h"
+#include "rigidbody.h"
+#include "throwpath.h"
+#include "bowling.h"
+#include "fallingballs.h"
+#include "framepacer.h"
+#include "vecbatch.h"
+#include "drawlist.h"
+#include "poisson.h"
+
+#define ENEMY_RADIUS 20.0f
+#define MAX_BENCH_ENEMIES 100   // the game's pool sizes
+#define MAX_BENCH_BULLETS 500
+
+static unsigned int rngState = 12345u;
+
+static float RandomFloat(float min, float max) {
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return min + (rngState >> 8) * (1.0f / 16777216.0f) * (max - min);
+}
+
+// ------------ Area of effect ------------
+// Kills within a radius through the spatial hash against a full scan of every
+// enemy. The hash cost should follow the number of enemies inside the circle,
+// the scan cost the total number of enemies.
+static int ScanRadius(const Vector2 *points, int count, Vector2 center, float radius) {
+    int inside = 0;
+    float r = radius + ENEMY_RADIUS;
+    for (int i = 0; i < count; i++) {
+        float dx = points[i].x - center.x;
+        float dy = points[i].y - center.y;
+        if (dx*dx + dy*dy <= r*r) inside++;
+    }
+    return inside;
+}
+
+static void RunAreaOfEffect(int count, float worldSize, float radius) {
+    Vector2 *points = malloc(sizeof(Vector2) * count);
+    int *ids = malloc(sizeof(int) * count);
+    int *hits = malloc(sizeof(int) * count);
+    for (int i = 0; i < count; i++) {
+        points[i] = (Vector2){ RandomFloat(0, worldSize), RandomFloat(0, worldSize) };
+        ids[i] = i;
+    }
+
+    SpatialHash hash = {0};
+    LoadSpatialHash(&hash, count, 40.0f);
+
+    const int builds = 20;
+    double start = ProfilerTime();
+    for (int b = 0; b < builds; b++) BuildSpatialHash(&hash, points, ids, count);
+    double buildNs = (ProfilerTime() - start) * 1e9 / builds;
+
+    const int queries = 2000;
+    Vector2 center = { worldSize / 2, worldSize / 2 };
+    int inside = 0;
+    start = ProfilerTime();
+    for (int q = 0; q < queries; q++) inside = QuerySpatialHash(&hash, center, radius + ENEMY_RADIUS, hits, count);
+    double queryNs = (ProfilerTime() - start) * 1e9 / queries;
+
+    int scanned = 0;
+    const int scans = (count > 100000) ? 20 : 200;
+    start = ProfilerTime();
+    for (int q = 0; q < scans; q++) scanned += ScanRadius(points, count, center, radius);
+    double scanNs = (ProfilerTime() - start) * 1e9 / scans;
+
+    printf("aoe  enemies %7d  world %6.0f  radius %5.0f  inside %6d  build %10.0f ns  query %9.0f ns  scan %10.0f ns%s\n",
+           count, worldSize, radius, inside, buildNs, queryNs, scanNs,
+           (scanned / scans != inside) ? "  MISMATCH" : "");
+
+    UnloadSpatialHash(&hash);
+    free(hits);
+    free(ids);
+    free(points);
+}
+
+static void BenchAreaOfEffect(void) {
+    // Same density, growing horde: the ring holds about the same enemies each time
+    const float density = 1000.0f / (800.0f * 600.0f);
+    for (int count = 1000; count <= 1000000; count *= 10) {
+        float worldSize = sqrtf(count / density);
+        RunAreaOfEffect(count, worldSize, 110.0f);
+    }
+    // Fixed horde, growing ring
+    for (float radius = 25.0f; radius <= 1600.0f; radius *= 4.0f) {
+        RunAreaOfEffect(100000, 8000.0f, radius);
+    }
+}
+
+// ------------ Wordle dictionary ------------
+// Startup load and guess validation for the shipped list, then the same for
+// a synthetic list well past 10k words to show the scaling.
+static void RunDictionary(const char *label, const char *fileName) {
+    WordList list = {0};
+    double start = ProfilerTime();
+    if (!LoadWordList(&list, fileName)) {
+        printf("dict %-10s  could not load %s\n", label, fileName);
+        return;
+    }
+    double loadMs = (ProfilerTime() - start) * 1000.0;
+
+    // Alternate real words with random keys that are mostly misses
+    const int lookups = 1 << 20;
+    WordKey *queries = malloc(sizeof(WordKey) * lookups);
+    for (int i = 0; i < lookups; i++) {
+        queries[i] = (i & 1) ? list.keys[((unsigned int)i * 7919u) % list.count] : (WordKey)(RandomFloat(0, 1) * (1u << 25));
+    }
+    int found = 0;
+    start = ProfilerTime();
+    for (int i = 0; i < lookups; i++) found += WordListContains(&list, queries[i]);
+    double lookupNs = (ProfilerTime() - start) * 1e9 / lookups;
+
+    // A naive table is a pointer plus a heap string of six bytes per word
+    long naiveBytes = (long)list.count * (sizeof(char *) + 16);
+    printf("dict %-10s  words %6d  load %7.3f ms  lookup %6.1f ns  hits %d  memory %7ld bytes (naive ~%ld)\n",
+           label, list.count, loadMs, lookupNs, found, (long)(list.count * sizeof(WordKey)), naiveBytes);
+    free(queries);
+    UnloadWordList(&list);
+}
+
+static void BenchDictionary(void) {
+    RunDictionary("shipped", "resources/words.txt");
+
+    const char *tempName = "bench_words.tmp";
+    FILE *file = fopen(tempName, "wb");
+    if (file == NULL) return;
+    for (int i = 0; i < 16000; i++) {
+        char word[DICTIONARY_WORD_LENGTH + 1];
+        for (int c = 0; c < DICTIONARY_WORD_LENGTH; c++) word[c] = (char)('A' + (int)RandomFloat(0, 26));
+        word[DICTIONARY_WORD_LENGTH] = '\0';
+        fprintf(file, "%s\n", word);
+    }
+    fclose(file);
+    RunDictionary("synthetic", tempName);
+    remove(tempName);
+}
+
+// ------------ Wordle hint ------------
+// The first guess is the worst case: every answer is still a candidate and
+// every allowed word gets scored against all of them. Each hint is run with
+// no cap and with the game's cap, and the slowest of several runs on one
+// thread and on every core is reported. The capped hint should stay well
+// inside a sim step and give up little information against the full search.
+#define BENCH_HINT_MAX_PAIRS 150000   // m.c's WORDLE_HINT_MAX_PAIRS
+
+static double TimeHint(const WordList *allowed, const WordKey *candidates, int count, int maxPairs,
+                       int threadCount, WordleHint *hint) {
+    const int runs = 5;
+    double worstMs = 0.0;
+    for (int r = 0; r < runs; r++) {
+        double start = ProfilerTime();
+        *hint = SuggestWordleGuess(allowed, candidates, count, maxPairs, threadCount);
+        double ms = (ProfilerTime() - start) * 1000.0;
+        if (ms > worstMs) worstMs = ms;
+    }
+    return worstMs;
+}
+
+static void RunHint(const char *label, const WordList *allowed, const WordList *answers) {
+    int threadCounts[2] = { 1, GetCpuCount() };
+    int caps[2] = { 0, BENCH_HINT_MAX_PAIRS };
+    for (int c = 0; c < 2; c++) {
+        WordleHint hints[2];
+        double worstMs[2];
+        for (int t = 0; t < 2; t++) {
+            worstMs[t] = TimeHint(allowed, answers->keys, answers->count, caps[c], threadCounts[t], &hints[t]);
+        }
+        char word[DICTIONARY_WORD_LENGTH + 1];
+        UnpackWord(hints[1].guess, word);
+        printf("hint %-10s %-6s  allowed %6d  answers %5d  best %s %.3f bits  1 thread %8.2f ms  %2d threads %8.2f ms%s\n",
+               label, (c == 0) ? "full" : "capped", allowed->count, answers->count, word, hints[1].entropy,
+               worstMs[0], threadCounts[1], worstMs[1], (hints[0].guess != hints[1].guess) ? "  MISMATCH" : "");
+    }
+}
+
+// The hint after an opening guess, for a spread of answers: the capped hint
+// on one thread against the full search
+static void RunSecondHint(const WordList *allowed, const WordList *answers) {
+    WordleHint opening = SuggestWordleGuess(allowed, answers->keys, answers->count, BENCH_HINT_MAX_PAIRS, 0);
+    WordKey *candidates = malloc(sizeof(WordKey) * answers->count);
+    if (candidates == NULL) return;
+    int games = 0;
+    double worstMs = 0.0, worstFullMs = 0.0, lost = 0.0, worstLost = 0.0;
+    for (int a = 0; a < answers->count; a += 10) {
+        int pattern = WordleFeedback(opening.guess, answers->keys[a]);
+        int count = FilterWordleCandidates(answers, &opening.guess, &pattern, 1, candidates);
+        double start = ProfilerTime();
+        WordleHint capped = SuggestWordleGuess(allowed, candidates, count, BENCH_HINT_MAX_PAIRS, 1);
+        double ms = (ProfilerTime() - start) * 1000.0;
+        start = ProfilerTime();
+        WordleHint full = SuggestWordleGuess(allowed, candidates, count, 0, 1);
+        double fullMs = (ProfilerTime() - start) * 1000.0;
+        if (ms > worstMs) worstMs = ms;
+        if (fullMs > worstFullMs) worstFullMs = fullMs;
+        lost += full.entropy - capped.entropy;
+        if (full.entropy - capped.entropy > worstLost) worstLost = full.entropy - capped.entropy;
+        games++;
+    }
+    free(candidates);
+    char word[DICTIONARY_WORD_LENGTH + 1];
+    UnpackWord(opening.guess, word);
+    printf("hint second      after %s  %4d answers  capped worst %6.2f ms  full worst %8.2f ms  (1 thread)  "
+           "bits lost mean %.3f max %.3f\n", word, games, worstMs, worstFullMs, lost / games, worstLost);
+}
+
+static void BenchHint(void) {
+    WordList allowed = {0}, answers = {0};
+    if (LoadWordList(&allowed, "resources/words.txt") && LoadWordList(&answers, "resources/answers.txt")) {
+        RunHint("shipped", &allowed, &answers);
+        RunSecondHint(&allowed, &answers);
+    } else {
+        printf("hint shipped     could not load the word lists\n");
+    }
+    UnloadWordList(&allowed);
+    UnloadWordList(&answers);
+
+    // Full-size lists: about 13k allowed words and 2.3k answers
+    WordList bigAllowed = { malloc(sizeof(WordKey) * 13000), 13000 };
+    WordList bigAnswers = { malloc(sizeof(WordKey) * 2300), 2300 };
+    for (int i = 0; i < bigAllowed.count; i++) {
+        char word[DICTIONARY_WORD_LENGTH + 1];
+        for (int c = 0; c < DICTIONARY_WORD_LENGTH; c++) word[c] = (char)('A' + (int)RandomFloat(0, 26));
+        word[DICTIONARY_WORD_LENGTH] = '\0';
+        bigAllowed.keys[i] = PackWord(word);
+    }
+    for (int i = 0; i < bigAnswers.count; i++) bigAnswers.keys[i] = bigAllowed.keys[i * 5];
+    RunHint("synthetic", &bigAllowed, &bigAnswers);
+    free(bigAllowed.keys);
+    free(bigAnswers.keys);
+}
+
+// ------------ Bowling pins ------------
+// Replays the revive throw through the game's own rack, launch and ball
+// drive (bowling.c) against growing racks, marking knocked pins every frame
+// as the mini-game does. Reports the mean and worst frame, the broadphase
+// work, how many pins went down, and what a frame costs once the rack rests.
+// The frame rate is a parameter: which pins fall and where they come to rest
+// should not depend on it.
+#define PIN_MATCH_DISTANCE 1.0f   // pixels a pin may end up from where the 60 fps throw left it
+
+typedef struct {
+    int down;
+    bool fallen[MAX_PINS];
+    Vector2 rest[MAX_PINS];
+} PinResult;
+
+static PinResult RunPins(int rows, float angle, float power, float fps, bool quiet) {
+    const float dt = 1.0f / fps;
+
+    RigidWorld world = {0};
+    LoadRigidWorld(&world, MAX_PINS + 1, (Rectangle){0});
+    BowlingThrow bowl = {0};
+    // The game's 800x600 lane: head pin at the top, throw from below the screen
+    RackBowlingPins(&bowl, &world, (Vector2){ 400.0f, 120.0f }, rows, (Vector2){ 400.0f, 520.0f });
+    world.bounds = (Rectangle){ LANE_LEFT, 60.0f, LANE_RIGHT - LANE_LEFT, 640.0f };
+    world.drive = DriveBowlingThrow;
+    world.driveData = &bowl;
+    LaunchBowlingThrow(&bowl, &world, (Vector2){ 400.0f, 650.0f }, angle, BowlingThrowSpeed(power));
+
+    double worst = 0.0, total = 0.0;
+    long pairTests = 0;
+    int frames = 0;
+    float settle = 0.0f;
+    PinResult result = {0};
+    while (settle < BOWLING_SETTLE_TIME) {
+        double start = ProfilerTime();
+        StepRigidWorld(&world, dt);
+        double frame = ProfilerTime() - start;
+        total += frame;
+        if (frame > worst) worst = frame;
+        pairTests += world.pairTests;
+        frames++;
+        for (int i = 0; i < bowl.pinCount; i++) {
+            if (!bowl.pins[i].fallen && BowlingPinKnocked(&bowl, &world, i)) {
+                bowl.pins[i].fallen = true;
+                result.down++;
+            }
+        }
+        if (bowl.released) {
+            settle += dt;
+            if (world.awake == 0) break;
+        }
+    }
+    for (int i = 0; i < bowl.pinCount; i++) {
+        result.fallen[i] = bowl.pins[i].fallen;
+        result.rest[i] = world.bodies[bowl.pins[i].body].position;
+    }
+
+    // Everything asleep: the frame should be a scan of the awake flags
+    const int idleFrames = 100000;
+    double start = ProfilerTime();
+    for (int i = 0; i < idleFrames; i++) StepRigidWorld(&world, dt);
+    double idleNs = (ProfilerTime() - start) * 1e9 / idleFrames;
+
+    if (!quiet) {
+        printf("pins rack %2d  angle %5.2f  power %.2f  fps %3.0f  frames %4d  mean %7.2f us  worst %7.2f us  pairs/frame %6.1f  down %2d/%2d%s  idle %6.1f ns\n",
+               bowl.pinCount, angle, power, fps, frames, total * 1e6 / frames, worst * 1e6, (double)pairTests / frames,
+               result.down, bowl.pinCount, (result.down == bowl.pinCount) ? " STRIKE" : "", idleNs);
+    }
+    UnloadRigidWorld(&world);
+    return result;
+}
+
+// Whether two runs of a rack knocked the same pins and left every pin in the
+// same place; widens *drift to the largest distance between them
+static bool SamePins(const PinResult *a, const PinResult *b, int pinCount, float *drift) {
+    bool same = true;
+    for (int i = 0; i < pinCount; i++) {
+        float d = Vector2Distance(a->rest[i], b->rest[i]);
+        if (d > *drift) *drift = d;
+        if (a->fallen[i] != b->fallen[i] || d > PIN_MATCH_DISTANCE) same = false;
+    }
+    return same;
+}
+
+static void BenchPins(void) {
+    for (int rows = 4; rows <= 6; rows++) {
+        RunPins(rows, 0.0f, 1.0f, 60.0f, false);
+        RunPins(rows, 0.1f, 0.5f, 60.0f, false);
+        RunPins(rows, -0.3f, 0.8f, 60.0f, false);
+    }
+
+    // The same throws at other frame rates should knock down the same pins
+    // and leave them where the 60 fps throw did
+    const int pinCount = PIN_RACK_ROWS * (PIN_RACK_ROWS + 1) / 2;
+    int throws = 0, matching = 0;
+    float drift = 0.0f;
+    for (float power = 0.0f; power <= 1.0f; power += 0.25f) {
+        for (float angle = -0.5f; angle <= 0.5f; angle += 0.1f) {
+            PinResult reference = RunPins(PIN_RACK_ROWS, angle, power, 60.0f, true);
+            PinResult slow = RunPins(PIN_RACK_ROWS, angle, power, 30.0f, true);
+            PinResult fast = RunPins(PIN_RACK_ROWS, angle, power, 144.0f, true);
+            bool same = SamePins(&reference, &slow, pinCount, &drift);
+            same = SamePins(&reference, &fast, pinCount, &drift) && same;
+            throws++;
+            matching += same;
+        }
+    }
+    printf("pins frame rate independence: %d/%d throws knock the same pins and leave them within %.1f px at 30, 60 and 144 fps (worst drift %.3f px)\n",
+           matching, throws, PIN_MATCH_DISTANCE, drift);
+}
+
+// ------------ Falling balls ------------
+// Rain mode: every caught or missed ball falls again, so the count stays
+// constant. Each step is run piece by piece so that the column-sorted catch
+// test, which only looks at balls under the basket, is timed on its own
+// against the per-ball scan the mini-game used to run, on the same
+// positions. The column sort is timed apart: it only runs after a respawn
+// lands a ball in another column.
+static int ScanCatches(const BallRain *rain) {
+    int caught = 0;
+    for (int i = 0; i < rain->capacity; i++) {
+        const Ball *ball = &rain->balls[i];
+        if (ball->active && ball->position.y + rain->radius >= rain->basketY &&
+            ball->position.x >= rain->basketX && ball->position.x <= rain->basketX + rain->basketWidth) caught++;
+    }
+    return caught;
+}
+
+static void RunRain(int count) {
+    const int steps = 1200;
+    BallRain rain = {0};
+    LoadBallRain(&rain, count, 20.0f, 800.0f, 600.0f);
+    ResetBallRain(&rain, count, 99u);
+
+    long tests = 0;
+    int sorts = 0, scanned = 0, caught = 0;
+    double sortTime = 0.0, catchTime = 0.0, scanTime = 0.0;
+    for (int f = 0; f < steps; f++) {
+        MoveBallRain(&rain, BALL_RAIN_STEP, (f / 180) % 2 ? 1 : -1);
+        bool resort = rain.dirty;
+        double start = ProfilerTime();
+        SortBallRain(&rain);
+        double sorted = ProfilerTime();
+        scanned += ScanCatches(&rain);
+        double mid = ProfilerTime();
+        caught += CatchBallRain(&rain);
+        double end = ProfilerTime();
+        RefillBallRain(&rain);
+        sorts += resort;
+        sortTime += sorted - start;
+        scanTime += mid - sorted;
+        catchTime += end - mid;
+        tests += rain.catchTests;
+    }
+
+    printf("rain balls %7d  catch query %9.0f ns/step  catch tests %7ld/step  full scan %9.0f ns/step  sort %9.0f ns/step (%d of %d steps)  caught %d%s\n",
+           count, catchTime * 1e9 / steps, tests / steps, scanTime * 1e9 / steps, sortTime * 1e9 / steps, sorts, steps,
+           caught, (caught == scanned) ? "" : " SCAN DISAGREES");
+    UnloadBallRain(&rain);
+}
+
+// The ten-ball game for 60 seconds with a scripted basket. The rain runs in
+// fixed steps, so the score should not depend on the frame rate.
+typedef struct {
+    int score;
+    int misses;
+} RainScore;
+
+static RainScore RunBallsAtRate(float fps) {
+    BallRain rain = {0};
+    LoadBallRain(&rain, 10, 20.0f, 800.0f, 600.0f);
+    ResetBallRain(&rain, 2, 7u);
+    int frames = (int)(60.0f * fps);
+    for (int f = 0; f < frames; f++) {
+        float time = f / fps;
+        UpdateBallRain(&rain, 1.0f / fps, ((int)(time / 1.5f)) % 2 ? 1 : -1);
+    }
+    printf("rain fps %3.0f  caught %3d  missed %3d\n", fps, rain.score, rain.misses);
+    RainScore result = { rain.score, rain.misses };
+    UnloadBallRain(&rain);
+    return result;
+}
+
+static void BenchRain(void) {
+    for (int count = 1000; count <= 100000; count *= 10) RunRain(count);
+    RainScore reference = RunBallsAtRate(60.0f);
+    RainScore slow = RunBallsAtRate(30.0f);
+    RainScore fast = RunBallsAtRate(144.0f);
+    bool same = slow.score == reference.score && slow.misses == reference.misses &&
+                fast.score == reference.score && fast.misses == reference.misses;
+    printf("rain frame rate independence: %s\n", same ? "same catches and misses at 30, 60 and 144 fps" : "FAILED, the frame rate changes the score");
+}
+
+// ------------ Frame pacing ------------
+// A 144 Hz schedule with 2-4 ms of busy work per frame standing in for the
+// game. The fixed cap only sleeps, so its frames inherit the OS timer's
+// oversleep; the adaptive limiter should hold the interval far more tightly.
+static void RunPacing(PaceMode mode, double hz, int frames) {
+    FramePacer pacer = {0};
+    SetFramePacerMode(&pacer, mode, 1.0 / hz);
+    for (int f = 0; f < frames; f++) {
+        double work = 0.002 + 0.002 * RandomFloat(0.0f, 1.0f);
+        double start = ProfilerTime();
+        while (ProfilerTime() - start < work) { }
+        WaitFramePacer(&pacer);
+    }
+    FramePacerStats stats = GetFramePacerStats(&pacer);
+    printf("pacing %-9s %3.0f Hz  avg %6.3f ms  jitter %6.3f ms  min %6.3f  p99 %6.3f  max %6.3f  late %d/%d\n",
+           PaceModeName(mode), hz, stats.meanMs, stats.jitterMs, stats.minMs, stats.p99Ms, stats.maxMs, stats.late, stats.samples);
+}
+
+static void BenchPacing(void) {
+    RunPacing(PACE_FIXED, 144.0, 300);
+    RunPacing(PACE_ADAPTIVE, 144.0, 300);
+    RunPacing(PACE_ADAPTIVE, 240.0, 300);
+}
+
+// ------------ Vector kernels ------------
+// Each batched kernel against the scalar raymath/raylib call in a loop, at
+// the game's enemy (100) and bullet (500) pool sizes and at 100k. The
+// accuracy pass compares every output bit for bit, including zero, tiny,
+// denormal and huge vectors.
+typedef enum {
+    KERNEL_ADD, KERNEL_SUBTRACT, KERNEL_SCALE, KERNEL_LENGTH,
+    KERNEL_NORMALIZE, KERNEL_MOVE, KERNEL_COLLIDE, KERNEL_COUNT
+} Kernel;
+
+static const char *kernelNames[KERNEL_COUNT] = {
+    "add", "subtract", "scale", "length", "normalize", "move", "collide"
+};
+
+typedef struct {
+    Vector2 *a, *b, *out;
+    float *lengths, *radii;
+    unsigned char *hits;
+    int count;
+} VecData;
+
+// rshapes.c, raylib 5.5; bench does not link raylib
+static bool RaylibCheckCollisionCircles(Vector2 center1, float radius1, Vector2 center2, float radius2) {
+    float dx = center2.x - center1.x;
+    float dy = center2.y - center1.y;
+    float distanceSquared = dx*dx + dy*dy;
+    float radiusSum = radius1 + radius2;
+    return distanceSquared <= (radiusSum*radiusSum);
+}
+
+static const Vector2 collideCenter = { 400.0f, 300.0f };
+
+// One switch per call, as in RunBatchKernel, so only the loops differ
+static int RunScalarKernel(Kernel kernel, VecData *d) {
+    int total = 0;
+    int n = d->count;
+    switch (kernel) {
+        case KERNEL_ADD: for (int i = 0; i < n; i++) d->out[i] = Vector2Add(d->a[i], d->b[i]); break;
+        case KERNEL_SUBTRACT: for (int i = 0; i < n; i++) d->out[i] = Vector2Subtract(d->a[i], d->b[i]); break;
+        case KERNEL_SCALE: for (int i = 0; i < n; i++) d->out[i] = Vector2Scale(d->a[i], 1.5f); break;
+        case KERNEL_LENGTH: for (int i = 0; i < n; i++) d->lengths[i] = Vector2Length(d->a[i]); break;
+        case KERNEL_NORMALIZE: for (int i = 0; i < n; i++) d->out[i] = Vector2Normalize(d->a[i]); break;
+        case KERNEL_MOVE: for (int i = 0; i < n; i++) d->out[i] = Vector2Add(d->out[i], Vector2Scale(d->b[i], 1.0f / 120.0f)); break;
+        case KERNEL_COLLIDE:
+            for (int i = 0; i < n; i++) {
+                d->hits[i] = RaylibCheckCollisionCircles(collideCenter, 20.0f, d->a[i], d->radii[i]);
+                total += d->hits[i];
+            }
+            break;
+        default: break;
+    }
+    return total;
+}
+
+static int RunBatchKernel(Kernel kernel, VecData *d) {
+    switch (kernel) {
+        case KERNEL_ADD: Vector2AddBatch(d->out, d->a, d->b, d->count); break;
+        case KERNEL_SUBTRACT: Vector2SubtractBatch(d->out, d->a, d->b, d->count); break;
+        case KERNEL_SCALE: Vector2ScaleBatch(d->out, d->a, 1.5f, d->count); break;
+        case KERNEL_LENGTH: Vector2LengthBatch(d->lengths, d->a, d->count); break;
+        case KERNEL_NORMALIZE: Vector2NormalizeBatch(d->out, d->a, d->count); break;
+        case KERNEL_MOVE: Vector2MoveBatch(d->out, d->b, 1.0f / 120.0f, d->count); break;
+        case KERNEL_COLLIDE: return CheckCollisionCirclesBatch(collideCenter, 20.0f, d->a, d->radii, d->count, d->hits);
+        default: break;
+    }
+    return 0;
+}
+
+static void LoadVecData(VecData *d, int count) {
+    d->count = count;
+    d->a = malloc(sizeof(Vector2) * count);
+    d->b = malloc(sizeof(Vector2) * count);
+    d->out = calloc(count, sizeof(Vector2));
+    d->lengths = malloc(sizeof(float) * count);
+    d->radii = malloc(sizeof(float) * count);
+    d->hits = malloc(count);
+    for (int i = 0; i < count; i++) {
+        d->a[i] = (Vector2){ RandomFloat(0.0f, 800.0f), RandomFloat(0.0f, 600.0f) };
+        d->b[i] = (Vector2){ RandomFloat(-400.0f, 400.0f), RandomFloat(-400.0f, 400.0f) };
+        d->radii[i] = RandomFloat(5.0f, 200.0f);
+    }
+}
+
+static void UnloadVecData(VecData *d) {
+    free(d->a); free(d->b); free(d->out); free(d->lengths); free(d->radii); free(d->hits);
+}
+
+static double TimeKernel(Kernel kernel, VecData *d, bool batch, int reps, double *sink) {
+    double start = ProfilerTime();
+    int total = 0;
+    for (int r = 0; r < reps; r++) {
+        total += batch ? RunBatchKernel(kernel, d) : RunScalarKernel(kernel, d);
+    }
+    double elapsed = ProfilerTime() - start;
+    // Read the outputs back so neither loop can be dropped
+    *sink += total + d->out[reps % d->count].x + d->lengths[reps % d->count];
+    return elapsed * 1e9 / ((double)reps * d->count);
+}
+
+static void RunVecKernels(int count, const char *label) {
+    VecData d;
+    LoadVecData(&d, count);
+    int reps = 4000000 / count;
+    double sink = 0.0;
+    for (int k = 0; k < KERNEL_COUNT; k++) {
+        double scalar = TimeKernel(k, &d, false, reps, &sink);
+        double batch = TimeKernel(k, &d, true, reps, &sink);
+        printf("vec %-9s %6d %-8s  scalar %6.2f ns  batch %6.2f ns  x%.2f  saves %7.1f ns per step over the pool\n",
+               kernelNames[k], count, label, scalar, batch, scalar / batch, (scalar - batch) * count);
+    }
+    if (sink == 1.2345) printf("\n");
+    UnloadVecData(&d);
+}
+
+static unsigned int FloatBits(float f) {
+    unsigned int bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+// Inputs spanning every exponent range, plus exact zeros
+static float AwkwardFloat(void) {
+    float magnitude = powf(10.0f, RandomFloat(-42.0f, 18.0f));
+    float value = (RandomFloat(0.0f, 1.0f) < 0.5f) ? -magnitude : magnitude;
+    return (RandomFloat(0.0f, 1.0f) < 0.02f) ? 0.0f : value;
+}
+
+static void CheckVecAccuracy(int count) {
+    VecData batch, scalar;
+    LoadVecData(&batch, count);
+    LoadVecData(&scalar, count);
+    for (int i = 0; i < count; i++) {
+        batch.a[i] = (Vector2){ AwkwardFloat(), AwkwardFloat() };
+        batch.b[i] = (Vector2){ AwkwardFloat(), AwkwardFloat() };
+        if (i % 3 == 0) batch.a[i] = (Vector2){ RandomFloat(300.0f, 500.0f), RandomFloat(200.0f, 400.0f) };
+        batch.radii[i] = RandomFloat(0.0f, 100.0f);
+        batch.out[i] = batch.a[i];
+    }
+    memcpy(scalar.a, batch.a, sizeof(Vector2) * count);
+    memcpy(scalar.b, batch.b, sizeof(Vector2) * count);
+    memcpy(scalar.radii, batch.radii, sizeof(float) * count);
+
+    for (int k = 0; k < KERNEL_COUNT; k++) {
+        memcpy(batch.out, batch.a, sizeof(Vector2) * count);
+        memcpy(scalar.out, batch.a, sizeof(Vector2) * count);
+        int batchHits = RunBatchKernel(k, &batch);
+        int scalarHits = RunScalarKernel(k, &scalar);
+        int mismatches = 0;
+        for (int i = 0; i < count; i++) {
+            bool same;
+            if (k == KERNEL_LENGTH) same = FloatBits(batch.lengths[i]) == FloatBits(scalar.lengths[i]);
+            else if (k == KERNEL_COLLIDE) same = batch.hits[i] == scalar.hits[i];
+            else same = FloatBits(batch.out[i].x) == FloatBits(scalar.out[i].x) && FloatBits(batch.out[i].y) == FloatBits(scalar.out[i].y);
+            if (!same) mismatches++;
+        }
+        printf("vec accuracy %-9s %d/%d results differ from the scalar call", kernelNames[k], mismatches, count);
+        if (k == KERNEL_COLLIDE) printf("  (hits %d batch, %d scalar)", batchHits, scalarHits);
+        printf("\n");
+    }
+    UnloadVecData(&batch);
+    UnloadVecData(&scalar);
+}
+
+static void BenchVec(void) {
+    CheckVecAccuracy(1000000);
+    RunVecKernels(MAX_BENCH_ENEMIES, "enemies");
+    RunVecKernels(MAX_BENCH_BULLETS, "bullets");
+    RunVecKernels(100000, "");
+}
+
+// ------------ Draw list ------------
+// A gameplay frame's sprites pushed in slot order, as the game used to draw
+// them, against the same sprites radix-sorted by key: texture switches are
+// the batch breaks rlgl would make. Then the radix sort against qsort on
+// (key, push order), which must give the identical stable order.
+typedef struct {
+    DrawKey key;
+    int order;
+} KeyPair;
+
+static int CompareKeyPairs(const void *a, const void *b) {
+    const KeyPair *x = a, *y = b;
+    if (x->key != y->key) return (x->key < y->key) ? -1 : 1;
+    return x->order - y->order;
+}
+
+static int CountTextureSwitches(const DrawList *list, bool sorted) {
+    int switches = 0;
+    unsigned int last = 0;
+    for (int i = 0; i < list->count; i++) {
+        unsigned int texture = list->commands[sorted ? list->order[i] : i].texture.id;
+        if (i > 0 && texture != last) switches++;
+        last = texture;
+    }
+    return switches;
+}
+
+static void RunFrameSprites(int enemies, int bullets, int obstacles) {
+    DrawList list = {0};
+    LoadDrawList(&list, 1 + bullets + enemies + 4 + obstacles);
+    DrawCommand command = {0};
+    command.texture = (Texture2D){ 1 };
+    PushDrawCommand(&list, 0, 0, &command);
+    command.texture.id = 2;
+    for (int i = 0; i < bullets; i++) PushDrawCommand(&list, 1, 0, &command);
+    for (int i = 0; i < enemies; i++) {
+        command.texture.id = 3 + (int)RandomFloat(0.0f, 2.999f);
+        PushDrawCommand(&list, 2, 0, &command);
+    }
+    for (int i = 0; i < 4; i++) {
+        command.texture.id = 6 + i;
+        PushDrawCommand(&list, 3, 0, &command);
+    }
+    command.texture.id = 10;
+    for (int i = 0; i < obstacles; i++) PushDrawCommand(&list, 4, 0, &command);
+
+    int before = CountTextureSwitches(&list, false);
+    SortDrawList(&list);
+    printf("drawlist frame %4d sprites  texture switches %4d in slot order, %d sorted\n",
+           list.count, before, CountTextureSwitches(&list, true));
+    UnloadDrawList(&list);
+}
+
+static void RunSort(int count, int distinctTextures) {
+    DrawKey *keys = malloc(sizeof(DrawKey) * count);
+    DrawKey *work = malloc(sizeof(DrawKey) * count);
+    DrawKey *scratchKeys = malloc(sizeof(DrawKey) * count);
+    int *order = malloc(sizeof(int) * count);
+    int *scratchOrder = malloc(sizeof(int) * count);
+    KeyPair *pairs = malloc(sizeof(KeyPair) * count);
+    for (int i = 0; i < count; i++) {
+        // Ties on purpose: few layers, a handful of textures, coarse depth
+        keys[i] = MakeDrawKey((int)RandomFloat(0.0f, 4.999f), 0, 1 + (int)RandomFloat(0.0f, distinctTextures - 0.001f),
+                              (unsigned int)RandomFloat(0.0f, 64.0f));
+    }
+
+    int reps = 2000000 / count + 1;
+    double radixTime = 0.0, qsortTime = 0.0;
+    for (int r = 0; r < reps; r++) {
+        memcpy(work, keys, sizeof(DrawKey) * count);
+        for (int i = 0; i < count; i++) order[i] = i;
+        double start = ProfilerTime();
+        RadixSortDrawKeys(work, order, scratchKeys, scratchOrder, count);
+        radixTime += ProfilerTime() - start;
+
+        for (int i = 0; i < count; i++) pairs[i] = (KeyPair){ keys[i], i };
+        start = ProfilerTime();
+        qsort(pairs, count, sizeof(KeyPair), CompareKeyPairs);
+        qsortTime += ProfilerTime() - start;
+    }
+
+    int mismatches = 0;
+    for (int i = 0; i < count; i++) {
+        if (pairs[i].key != work[i] || pairs[i].order != order[i]) mismatches++;
+    }
+    printf("drawlist sort  %6d keys  radix %8.2f us  qsort %8.2f us  x%.1f  %s\n", count,
+           radixTime * 1e6 / reps, qsortTime * 1e6 / reps, qsortTime / radixTime,
+           mismatches == 0 ? "same stable order" : "ORDER MISMATCH");
+
+    free(keys);
+    free(work);
+    free(scratchKeys);
+    free(order);
+    free(scratchOrder);
+    free(pairs);
+}
+
+static void BenchDrawList(void) {
+    RunFrameSprites(MAX_BENCH_ENEMIES, 60, 0);
+    RunFrameSprites(MAX_BENCH_ENEMIES, MAX_BENCH_BULLETS, 120);
+    RunSort(MAX_BENCH_ENEMIES + MAX_BENCH_BULLETS, 8);
+    RunSort(100000, 64);
+}
+
+// ------------ Rock spread ------------
+// Samples the hard arena's rocks as SpawnObstacles does: same area, spacing
+// and safe zone around the spawn point, one seed per run. Counts the rocks in
+// each quadrant of the arena; 36 rocks should give about nine a quadrant, and
+// an empty quadrant means the rocks bunched up in one part of the arena.
+#define BENCH_ARENA_WIDTH  2400.0f  // the game's arena
+#define BENCH_ARENA_HEIGHT 1800.0f
+#define BENCH_ROCK_WIDTH   95.0f    // Rock.png, shrunk by 3 on load
+#define BENCH_ROCK_HEIGHT  50.0f
+#define BENCH_ROCK_SPACING 10.0f
+#define BENCH_ROCKS        36
+
+static void RunRockSpread(int runs) {
+    float w = BENCH_ROCK_WIDTH, h = BENCH_ROCK_HEIGHT;
+    Rectangle area = { 100 + w/2, 100 + h/2, BENCH_ARENA_WIDTH - 100 - w, BENCH_ARENA_HEIGHT - 100 - h };
+    Vector2 spawn = { BENCH_ARENA_WIDTH / 2, BENCH_ARENA_HEIGHT / 2 };
+    Rectangle safeZone = { spawn.x - w - 50 - w/2, spawn.y - h - 50 - h/2, 2*w + 100, 2*h + 100 };
+    Vector2 rocks[BENCH_ROCKS];
+
+    int fewest = BENCH_ROCKS, most = 0, emptyRuns = 0, shortRuns = 0;
+    double total = 0.0;
+    for (int r = 0; r < runs; r++) {
+        double start = ProfilerTime();
+        int placed = PoissonDiskSample(area, sqrtf(w*w + h*h) + BENCH_ROCK_SPACING, &safeZone, 1,
+                                       rocks, BENCH_ROCKS, (unsigned int)RandomFloat(1.0f, 2147483647.0f));
+        total += ProfilerTime() - start;
+        if (placed < BENCH_ROCKS) shortRuns++;
+
+        int quadrants[4] = {0};
+        for (int i = 0; i < placed; i++) {
+            quadrants[(rocks[i].x >= spawn.x ? 1 : 0) + (rocks[i].y >= spawn.y ? 2 : 0)]++;
+        }
+        bool empty = false;
+        for (int q = 0; q < 4; q++) {
+            if (quadrants[q] < fewest) fewest = quadrants[q];
+            if (quadrants[q] > most) most = quadrants[q];
+            if (quadrants[q] == 0) empty = true;
+        }
+        if (empty) emptyRuns++;
+    }
+    printf("rocks spread   %d rocks x %d runs  per quadrant %d..%d (even %d)  empty quadrant in %d runs  short %d  sample %6.3f ms  %s\n",
+           BENCH_ROCKS, runs, fewest, most, BENCH_ROCKS / 4, emptyRuns, shortRuns, total * 1000.0 / runs,
+           (emptyRuns == 0 && shortRuns == 0) ? "spread" : "CLUSTERED");
+}
+
+static void BenchRocks(void) {
+    RunRockSpread(500);
+}
+
+int main(int argc, char **argv) {
+    const char *only = (argc > 1) ? argv[1] : NULL;
+
+    if (only == NULL || strcmp(only, "aoe") == 0) BenchAreaOfEffect();
+    if (only == NULL || strcmp(only, "dict") == 0) BenchDictionary();
+    if (only == NULL || strcmp(only, "hint") == 0) BenchHint();
+    if (only == NULL || strcmp(only, "pins") == 0) BenchPins();
+    if (only == NULL || strcmp(only, "rain") == 0) BenchRain();
+    if (only == NULL || strcmp(only, "pacing") == 0) BenchPacing();
+    if (only == NULL || strcmp(only, "vec") == 0) BenchVec();
+    if (only == NULL || strcmp(only, "drawlist") == 0) BenchDrawList();
+    if (only == NULL || strcmp(only, "rocks") == 0) BenchRocks();
+
+    return 0;
+}
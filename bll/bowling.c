@@ -0,0 +1,89 @@
+#include "bowling.h"
+#include <math.h>
+
+void RackBowlingPins(BowlingThrow *bowl, RigidWorld *world, Vector2 headPin, int rows, Vector2 ballPos) {
+    ClearRigidWorld(world);
+    if (rows > MAX_PIN_ROWS) rows = MAX_PIN_ROWS;
+
+    bowl->pinCount = 0;
+    for (int row = 0; row < rows; row++) {
+        for (int i = 0; i <= row; i++) {
+            Vector2 spot = { headPin.x + (i - row / 2.0f) * PIN_SPACING, headPin.y + row * PIN_SPACING };
+            BowlingPin *pin = &bowl->pins[bowl->pinCount++];
+            pin->body = AddRigidCircle(world, spot, PIN_RADIUS, PIN_MASS, PIN_DRAG);
+            pin->spot = spot;
+            pin->fallen = false;
+        }
+    }
+    bowl->ball = AddRigidCircle(world, ballPos, BOWLING_BALL_RADIUS, 0.0f, 0.0f);
+    bowl->launched = false;
+    bowl->released = false;
+}
+
+float BowlingThrowSpeed(float power) {
+    return THROW_BASE_SPEED + power * THROW_POWER_SPEED;
+}
+
+void LaunchBowlingThrow(BowlingThrow *bowl, RigidWorld *world, Vector2 center, float angle, float angularSpeed) {
+    // The whole throw is known now: lay out the path and when it meets each pin
+    BuildThrowPath(&bowl->path, center, THROW_WIDTH, THROW_LENGTH, angle, angularSpeed,
+                   LANE_LEFT + BOWLING_BALL_RADIUS, LANE_RIGHT - BOWLING_BALL_RADIUS);
+    for (int i = 0; i < bowl->pinCount; i++) {
+        if (!ThrowPathFirstHit(&bowl->path, 0.0f, bowl->pins[i].spot, PIN_RADIUS + BOWLING_BALL_RADIUS, &bowl->hitTimes[i])) {
+            bowl->hitTimes[i] = -1.0f;
+        }
+    }
+    world->time = 0.0f;
+    world->accumulator = 0.0f;
+    world->bodies[bowl->ball].position = bowl->path.points[0];
+    SetRigidVelocity(world, bowl->ball, ThrowPathVelocity(&bowl->path, 0.0f));
+    bowl->launched = true;
+    bowl->released = false;
+}
+
+// Moves the ball along the throw path one substep at a time. Resting pins the
+// path reaches during the substep are struck at their exact contact time, so
+// a fast ball cannot skip a pin whatever the frame rate.
+void DriveBowlingThrow(RigidWorld *world, float time, float h, void *data) {
+    BowlingThrow *bowl = data;
+    if (bowl->released || !bowl->launched) return;
+    RigidCircle *ball = &world->bodies[bowl->ball];
+
+    // At the end of the path the ball rolls on with whatever speed it had
+    if (time >= bowl->path.duration) {
+        bowl->released = true;
+        ball->invMass = 1.0f / BOWLING_BALL_MASS;
+        ball->drag = BOWLING_BALL_DRAG;
+        return;
+    }
+    Vector2 next = ThrowPathPosition(&bowl->path, time + h);
+    SetRigidVelocity(world, bowl->ball, (Vector2){ (next.x - ball->position.x) / h, (next.y - ball->position.y) / h });
+
+    for (int i = 0; i < bowl->pinCount; i++) {
+        const BowlingPin *pin = &bowl->pins[i];
+        RigidCircle *body = &world->bodies[pin->body];
+        // A pin that has already been moved is no longer where its hit time was computed
+        if (pin->fallen || !body->asleep || bowl->hitTimes[i] < time || bowl->hitTimes[i] >= time + h) continue;
+        Vector2 contact = ThrowPathPosition(&bowl->path, bowl->hitTimes[i]);
+        Vector2 v = ThrowPathVelocity(&bowl->path, bowl->hitTimes[i]);
+        float nx = body->position.x - contact.x, ny = body->position.y - contact.y;
+        float len = sqrtf(nx*nx + ny*ny);
+        if (len <= 0.0f) continue;
+        nx /= len;
+        ny /= len;
+        float approach = v.x * nx + v.y * ny;
+        if (approach > 0.0f) {
+            float speed = (1.0f + world->restitution) * approach;
+            SetRigidVelocity(world, pin->body, (Vector2){ nx * speed, ny * speed });
+        }
+    }
+}
+
+bool BowlingPinKnocked(const BowlingThrow *bowl, const RigidWorld *world, int pin) {
+    const BowlingPin *p = &bowl->pins[pin];
+    const RigidCircle *body = &world->bodies[p->body];
+    float dx = body->position.x - p->spot.x, dy = body->position.y - p->spot.y;
+    float vx = body->velocity.x, vy = body->velocity.y;
+    return !body->active || vx*vx + vy*vy > PIN_KNOCK_SPEED * PIN_KNOCK_SPEED ||
+           dx*dx + dy*dy > PIN_KNOCK_DISTANCE * PIN_KNOCK_DISTANCE;
+}
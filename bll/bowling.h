@@ -0,0 +1,70 @@
+#ifndef BOWLING_H
+#define BOWLING_H
+
+#include "raylib.h"
+#include "rigidbody.h"
+#include "throwpath.h"
+#include <stdbool.h>
+
+// The bowling throw as the revive mini-game plays it, shared with the pins
+// bench so both run the same rack, masses and ball drive. The rack and a
+// kinematic ball live in a RigidWorld; once launched, the ball follows the
+// precomputed throw path one substep at a time, striking resting pins at
+// their exact contact times, and rolls on freely past the end of the path.
+#define PIN_RACK_ROWS 4             // the standard ten-pin triangle
+#define MAX_PIN_ROWS  6             // 21-pin stress rack
+#define MAX_PINS      (MAX_PIN_ROWS * (MAX_PIN_ROWS + 1) / 2)
+
+#define BOWLING_BALL_RADIUS 15
+#define PIN_RADIUS    20
+#define PIN_SPACING   44.0f
+#define BOWLING_BALL_MASS 6.0f
+#define PIN_MASS      1.0f
+#define PIN_DRAG      2.5f
+#define BOWLING_BALL_DRAG 2.0f
+#define PIN_KNOCK_SPEED 60.0f       // a pin moving this fast has toppled
+#define PIN_KNOCK_DISTANCE 8.0f     // ...as has one pushed this far off its spot
+#define BOWLING_SETTLE_TIME 3.0f    // longest wait for the pins to stop after the throw
+#define LANE_LEFT     140
+#define LANE_RIGHT    660
+#define THROW_WIDTH   100.0f        // the throw's quarter ellipse: sideways half-axis
+#define THROW_LENGTH  500.0f        // ...and down the lane
+#define THROW_BASE_SPEED 1.2f       // radians per second along the ellipse at zero power
+#define THROW_POWER_SPEED 3.0f      // ...added at full power
+
+typedef struct {
+    int body;       // index into the world
+    Vector2 spot;   // where it was racked
+    bool fallen;
+} BowlingPin;
+
+// Plain data, so it can sit in a saved game
+typedef struct {
+    BowlingPin pins[MAX_PINS];
+    int pinCount;
+    int ball;                   // body index, -1 before the first rack
+    ThrowPath path;
+    float hitTimes[MAX_PINS];   // when the throw first touches each racked pin, -1 for never
+    bool launched;
+    bool released;              // past the end of the throw path, rolling freely
+} BowlingThrow;
+
+// Empties the world and racks rows of pins behind headPin, plus the ball at
+// ballPos. The world's bounds are left to the caller.
+void RackBowlingPins(BowlingThrow *bowl, RigidWorld *world, Vector2 headPin, int rows, Vector2 ballPos);
+
+// Radians per second along the ellipse for a throw charged to power (0..1)
+float BowlingThrowSpeed(float power);
+
+// Lays out the whole throw from center and sets the ball going. The path is
+// clamped to the lane.
+void LaunchBowlingThrow(BowlingThrow *bowl, RigidWorld *world, Vector2 center, float angle, float angularSpeed);
+
+// RigidWorld drive for a launched throw; data is the BowlingThrow
+void DriveBowlingThrow(RigidWorld *world, float time, float h, void *data);
+
+// Whether a standing pin has been knocked: it left the lane, is moving fast
+// or was pushed off its spot. Marking it fallen is left to the caller.
+bool BowlingPinKnocked(const BowlingThrow *bowl, const RigidWorld *world, int pin);
+
+#endif // BOWLING_H
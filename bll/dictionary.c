@@ -0,0 +1,93 @@
+#include "dictionary.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+WordKey PackWord(const char *word) {
+    WordKey key = 0;
+    for (int i = 0; i < DICTIONARY_WORD_LENGTH; i++) {
+        char c = word[i];
+        if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+        if (c < 'A' || c > 'Z') return 0;
+        key = (key << 5) | (WordKey)(c - 'A' + 1); // letters are 1..26 so no word packs to 0
+    }
+    return (word[DICTIONARY_WORD_LENGTH] == '\0') ? key : 0;
+}
+
+void UnpackWord(WordKey key, char *out) {
+    for (int i = DICTIONARY_WORD_LENGTH - 1; i >= 0; i--) {
+        out[i] = (char)('A' + (key & 31) - 1);
+        key >>= 5;
+    }
+    out[DICTIONARY_WORD_LENGTH] = '\0';
+}
+
+static int CompareKeys(const void *a, const void *b) {
+    WordKey ka = *(const WordKey *)a, kb = *(const WordKey *)b;
+    return (ka > kb) - (ka < kb);
+}
+
+bool LoadWordList(WordList *list, const char *fileName) {
+    list->keys = NULL;
+    list->count = 0;
+
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return false;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char *text = malloc(size + 1);
+    // Every word needs at least six bytes with its line break
+    list->keys = malloc(sizeof(WordKey) * (size / (DICTIONARY_WORD_LENGTH + 1) + 1));
+    if (text == NULL || list->keys == NULL || fread(text, 1, size, file) != (size_t)size) {
+        fclose(file);
+        free(text);
+        UnloadWordList(list);
+        return false;
+    }
+    fclose(file);
+    text[size] = '\0';
+
+    bool sorted = true;
+    char *line = text;
+    for (long i = 0; i <= size; i++) {
+        if (text[i] == '\n' || text[i] == '\r' || text[i] == '\0') {
+            text[i] = '\0';
+            WordKey key = PackWord(line);
+            if (key != 0) {
+                if (list->count > 0 && key <= list->keys[list->count - 1]) sorted = false;
+                list->keys[list->count++] = key;
+            }
+            line = text + i + 1;
+        }
+    }
+    free(text);
+
+    // Resource files ship sorted; anything else is sorted and deduplicated here
+    if (!sorted) {
+        qsort(list->keys, list->count, sizeof(WordKey), CompareKeys);
+        int unique = 0;
+        for (int i = 0; i < list->count; i++) {
+            if (unique == 0 || list->keys[i] != list->keys[unique - 1]) list->keys[unique++] = list->keys[i];
+        }
+        list->count = unique;
+    }
+    return list->count > 0;
+}
+
+void UnloadWordList(WordList *list) {
+    free(list->keys);
+    list->keys = NULL;
+    list->count = 0;
+}
+
+bool WordListContains(const WordList *list, WordKey key) {
+    int lo = 0, hi = list->count - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (list->keys[mid] == key) return true;
+        if (list->keys[mid] < key) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return false;
+}
@@ -0,0 +1,29 @@
+#ifndef DICTIONARY_H
+#define DICTIONARY_H
+
+#include <stdbool.h>
+
+// Five-letter word lists for the Wordle mini-game. Each word is packed into
+// a 25-bit key (5 bits per letter, first letter highest), so numeric order is
+// alphabetical order and the whole list is one sorted array of 4-byte keys.
+// Lookups are a binary search.
+#define DICTIONARY_WORD_LENGTH 5
+
+typedef unsigned int WordKey;
+
+typedef struct {
+    WordKey *keys;  // sorted, no duplicates
+    int count;
+} WordList;
+
+// Returns 0 when word is not exactly five letters A-Z (either case)
+WordKey PackWord(const char *word);
+// Writes the five letters in upper case plus a terminator into out
+void UnpackWord(WordKey key, char *out);
+
+// Loads one word per line; lines that are not five letters are skipped
+bool LoadWordList(WordList *list, const char *fileName);
+void UnloadWordList(WordList *list);
+bool WordListContains(const WordList *list, WordKey key);
+
+#endif // DICTIONARY_H
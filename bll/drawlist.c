@@ -0,0 +1,111 @@
+#include "drawlist.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES (int)(sizeof(DrawKey) * 8 / RADIX_BITS)
+
+bool LoadDrawList(DrawList *list, int capacity) {
+    UnloadDrawList(list);
+    if (capacity < 1) capacity = 1;
+
+    list->capacity = capacity;
+    list->commands = malloc(sizeof(DrawCommand) * capacity);
+    list->keys = malloc(sizeof(DrawKey) * capacity);
+    list->order = malloc(sizeof(int) * capacity);
+    list->scratchKeys = malloc(sizeof(DrawKey) * capacity);
+    list->scratchOrder = malloc(sizeof(int) * capacity);
+    if (!list->commands || !list->keys || !list->order || !list->scratchKeys || !list->scratchOrder) {
+        UnloadDrawList(list);
+        return false;
+    }
+    return true;
+}
+
+void UnloadDrawList(DrawList *list) {
+    free(list->commands);
+    free(list->keys);
+    free(list->order);
+    free(list->scratchKeys);
+    free(list->scratchOrder);
+    memset(list, 0, sizeof(*list));
+}
+
+void ClearDrawList(DrawList *list) {
+    list->count = 0;
+    list->submitted = 0;
+}
+
+DrawKey MakeDrawKey(int layer, unsigned int shader, unsigned int texture, unsigned int depth) {
+    return ((DrawKey)(layer & 0xFF) << DRAW_KEY_LAYER_SHIFT) |
+           ((DrawKey)(shader & 0xFF) << DRAW_KEY_SHADER_SHIFT) |
+           ((DrawKey)(texture & 0xFFFF) << DRAW_KEY_TEXTURE_SHIFT) |
+           (DrawKey)depth;
+}
+
+int DrawKeyLayer(DrawKey key) {
+    return (int)(key >> DRAW_KEY_LAYER_SHIFT);
+}
+
+bool PushDrawCommand(DrawList *list, int layer, unsigned int depth, const DrawCommand *command) {
+    if (list->count >= list->capacity) return false;
+    int i = list->count++;
+    list->commands[i] = *command;
+    list->keys[i] = MakeDrawKey(layer, command->shader.id, command->texture.id, depth);
+    list->order[i] = i;
+    return true;
+}
+
+void RadixSortDrawKeys(DrawKey *keys, int *order, DrawKey *scratchKeys, int *scratchOrder, int count) {
+    if (count < 2) return;
+
+    // All histograms in one read of the keys
+    int histogram[RADIX_PASSES][RADIX_BUCKETS];
+    memset(histogram, 0, sizeof(histogram));
+    for (int i = 0; i < count; i++) {
+        DrawKey key = keys[i];
+        for (int pass = 0; pass < RADIX_PASSES; pass++) {
+            histogram[pass][(key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+        }
+    }
+
+    DrawKey *fromKeys = keys, *toKeys = scratchKeys;
+    int *fromOrder = order, *toOrder = scratchOrder;
+    for (int pass = 0; pass < RADIX_PASSES; pass++) {
+        int *counts = histogram[pass];
+        int shift = pass * RADIX_BITS;
+        // One full bucket: this byte is the same everywhere and sorts nothing
+        if (counts[(fromKeys[0] >> shift) & (RADIX_BUCKETS - 1)] == count) continue;
+
+        int offset = 0;
+        for (int b = 0; b < RADIX_BUCKETS; b++) {
+            int n = counts[b];
+            counts[b] = offset;
+            offset += n;
+        }
+        for (int i = 0; i < count; i++) {
+            int slot = counts[(fromKeys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+            toKeys[slot] = fromKeys[i];
+            toOrder[slot] = fromOrder[i];
+        }
+
+        DrawKey *swapKeys = fromKeys;
+        fromKeys = toKeys;
+        toKeys = swapKeys;
+        int *swapOrder = fromOrder;
+        fromOrder = toOrder;
+        toOrder = swapOrder;
+    }
+
+    // An odd number of passes left the result in the scratch arrays
+    if (fromKeys != keys) {
+        memcpy(keys, fromKeys, sizeof(DrawKey) * count);
+        memcpy(order, fromOrder, sizeof(int) * count);
+    }
+}
+
+void SortDrawList(DrawList *list) {
+    RadixSortDrawKeys(list->keys, list->order, list->scratchKeys, list->scratchOrder, list->count);
+    list->submitted = 0;
+}
@@ -0,0 +1,62 @@
+#ifndef DRAWLIST_H
+#define DRAWLIST_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// Sorted sprite draw list. Sprites are pushed during the frame with a 64-bit
+// sort key (layer, shader, texture, depth), the keys are radix-sorted once,
+// and the sprites are drawn in key order: within a layer, everything sharing
+// a texture lands in one rlgl draw call instead of breaking the batch at
+// each switch. The sort is stable, so sprites with equal keys keep the order
+// they were pushed in. Only collects and sorts; drawing the commands is left
+// to the caller.
+typedef unsigned long long DrawKey;
+
+#define DRAW_KEY_LAYER_SHIFT 56     // 8 bits, drawn back to front
+#define DRAW_KEY_SHADER_SHIFT 48    // 8 bits of the shader id
+#define DRAW_KEY_TEXTURE_SHIFT 32   // 16 bits of the texture id
+                                    // 32 bits of depth, smaller first
+
+typedef struct {
+    Texture2D texture;
+    Rectangle source;
+    Rectangle dest;
+    Vector2 origin;
+    float rotation;
+    Color tint;
+    Shader shader;                  // id 0 draws with the default shader
+} DrawCommand;
+
+typedef struct {
+    int capacity;
+    int count;
+    int submitted;                  // sorted commands already drawn this frame
+    DrawCommand *commands;          // in push order
+    DrawKey *keys;                  // sorted by SortDrawList, with order
+    int *order;                     // command index of each sorted key
+    DrawKey *scratchKeys;
+    int *scratchOrder;
+} DrawList;
+
+bool LoadDrawList(DrawList *list, int capacity);
+void UnloadDrawList(DrawList *list);
+void ClearDrawList(DrawList *list);
+
+// Id collisions in the truncated shader and texture fields only cost an
+// extra batch break, never a wrong draw
+DrawKey MakeDrawKey(int layer, unsigned int shader, unsigned int texture, unsigned int depth);
+
+int DrawKeyLayer(DrawKey key);
+
+// Returns false once the list is full; the sprite is then dropped
+bool PushDrawCommand(DrawList *list, int layer, unsigned int depth, const DrawCommand *command);
+
+// Stable LSD radix sort of count keys, carrying order along. Byte passes
+// where every key agrees are skipped. scratchKeys and scratchOrder must
+// hold count entries.
+void RadixSortDrawKeys(DrawKey *keys, int *order, DrawKey *scratchKeys, int *scratchOrder, int count);
+
+void SortDrawList(DrawList *list);
+
+#endif // DRAWLIST_H
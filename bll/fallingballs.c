@@ -0,0 +1,148 @@
+#include "fallingballs.h"
+#include <stdlib.h>
+#include <string.h>
+
+static unsigned int NextRandom(BallRain *rain) {
+    rain->rng ^= rain->rng << 13;
+    rain->rng ^= rain->rng >> 17;
+    rain->rng ^= rain->rng << 5;
+    return rain->rng;
+}
+
+static float RandomRange(BallRain *rain, float min, float max) {
+    return min + (NextRandom(rain) >> 8) * (1.0f / 16777216.0f) * (max - min);
+}
+
+static int Column(const BallRain *rain, float x) {
+    int c = (int)x;
+    return (c < 0) ? 0 : (c >= rain->columns) ? rain->columns - 1 : c;
+}
+
+static void Respawn(BallRain *rain, Ball *ball) {
+    int column = Column(rain, ball->position.x);
+    ball->position.x = RandomRange(rain, rain->radius, rain->width - rain->radius);
+    ball->position.y = RandomRange(rain, -rain->height, 0.0f);
+    ball->color = (Color){ (unsigned char)(50 + NextRandom(rain) % 206), (unsigned char)(50 + NextRandom(rain) % 206),
+                           (unsigned char)(50 + NextRandom(rain) % 206), 255 };
+    ball->active = true;
+    if (Column(rain, ball->position.x) != column) rain->dirty = true;
+}
+
+void LoadBallRain(BallRain *rain, int capacity, float radius, float width, float height) {
+    UnloadBallRain(rain);
+    if (capacity < 1) capacity = 1;
+
+    rain->columns = (int)width + 1;
+    rain->balls = calloc(capacity, sizeof(Ball));
+    rain->order = malloc(sizeof(int) * capacity);
+    rain->columnStart = calloc(rain->columns + 1, sizeof(int));
+    if (!rain->balls || !rain->order || !rain->columnStart) {
+        UnloadBallRain(rain);
+        return;
+    }
+    rain->capacity = capacity;
+    rain->radius = radius;
+    rain->width = width;
+    rain->height = height;
+    rain->fallSpeed = BALL_FALL_SPEED;
+    rain->basketSpeed = BASKET_SPEED;
+    rain->basketWidth = 150.0f;
+}
+
+void UnloadBallRain(BallRain *rain) {
+    free(rain->balls);
+    free(rain->order);
+    free(rain->columnStart);
+    memset(rain, 0, sizeof(*rain));
+}
+
+void ResetBallRain(BallRain *rain, int minActive, unsigned int seed) {
+    rain->rng = seed ? seed : 1u;
+    rain->minActive = minActive;
+    rain->score = 0;
+    rain->misses = 0;
+    rain->accumulator = 0.0f;
+    rain->basketX = rain->width / 2.0f - rain->basketWidth / 2.0f;
+    rain->basketY = rain->height - 80.0f;
+    for (int i = 0; i < rain->capacity; i++) Respawn(rain, &rain->balls[i]);
+    rain->activeCount = rain->capacity;
+    rain->dirty = true;
+}
+
+// Inactive balls are sorted too; the catch test skips them
+void SortBallRain(BallRain *rain) {
+    if (!rain->dirty) return;
+    memset(rain->columnStart, 0, sizeof(int) * (rain->columns + 1));
+    for (int i = 0; i < rain->capacity; i++) rain->columnStart[Column(rain, rain->balls[i].position.x) + 1]++;
+    for (int c = 0; c < rain->columns; c++) rain->columnStart[c + 1] += rain->columnStart[c];
+    for (int i = 0; i < rain->capacity; i++) {
+        int c = Column(rain, rain->balls[i].position.x);
+        rain->order[rain->columnStart[c]++] = i;
+    }
+    // Filling shifted every start one column along; shift back
+    for (int c = rain->columns; c > 0; c--) rain->columnStart[c] = rain->columnStart[c - 1];
+    rain->columnStart[0] = 0;
+    rain->dirty = false;
+}
+
+void MoveBallRain(BallRain *rain, float h, int direction) {
+    rain->basketX += direction * rain->basketSpeed * h;
+    if (rain->basketX < 0.0f) rain->basketX = 0.0f;
+    if (rain->basketX + rain->basketWidth > rain->width) rain->basketX = rain->width - rain->basketWidth;
+
+    float fall = rain->fallSpeed * h;
+    for (int i = 0; i < rain->capacity; i++) {
+        if (rain->balls[i].active) rain->balls[i].position.y += fall;
+    }
+}
+
+int CatchBallRain(BallRain *rain) {
+    int caught = 0;
+    rain->catchTests = 0;
+    int first = rain->columnStart[Column(rain, rain->basketX)];
+    int last = rain->columnStart[Column(rain, rain->basketX + rain->basketWidth) + 1];
+    for (int k = first; k < last; k++) {
+        Ball *ball = &rain->balls[rain->order[k]];
+        if (!ball->active) continue;
+        rain->catchTests++;
+        if (ball->position.y + rain->radius >= rain->basketY &&
+            ball->position.x >= rain->basketX && ball->position.x <= rain->basketX + rain->basketWidth) {
+            ball->active = false;
+            rain->activeCount--;
+            caught++;
+        }
+    }
+    rain->score += caught;
+    return caught;
+}
+
+void RefillBallRain(BallRain *rain) {
+    // Misses fall back in from the top somewhere else
+    for (int i = 0; i < rain->capacity; i++) {
+        Ball *ball = &rain->balls[i];
+        if (ball->active && ball->position.y - rain->radius > rain->height) {
+            rain->misses++;
+            Respawn(rain, ball);
+        }
+    }
+
+    for (int i = 0; i < rain->capacity && rain->activeCount < rain->minActive; i++) {
+        if (!rain->balls[i].active) {
+            Respawn(rain, &rain->balls[i]);
+            rain->activeCount++;
+        }
+    }
+}
+
+void UpdateBallRain(BallRain *rain, float dt, int direction) {
+    rain->accumulator += dt;
+    for (int steps = 0; rain->accumulator >= BALL_RAIN_STEP && steps < BALL_RAIN_MAX_STEPS; steps++) {
+        MoveBallRain(rain, BALL_RAIN_STEP, direction);
+        SortBallRain(rain);
+        CatchBallRain(rain);
+        RefillBallRain(rain);
+        rain->accumulator -= BALL_RAIN_STEP;
+    }
+    // Drop what a long hitch left over rather than running behind
+    if (rain->accumulator >= BALL_RAIN_STEP) rain->accumulator = 0.0f;
+}
@@ -0,0 +1,61 @@
+#ifndef FALLINGBALLS_H
+#define FALLINGBALLS_H
+
+#include "raylib.h"
+
+// The falling-balls mini-game, shared by the easy-mode revive in m.c and by
+// pract.c. It advances in fixed steps whatever the frame time, so catches and
+// misses come out the same at any frame rate. Balls only fall straight down,
+// so they are kept bucketed by x column (a counting sort, redone only after a
+// respawn lands a ball in another column) and the catch test sweeps just the
+// columns under the basket. That keeps the rain mode, with thousands of
+// balls, cheap.
+#define BALL_FALL_SPEED   240.0f  // pixels per second (was 4 per frame at 60 FPS)
+#define BASKET_SPEED      420.0f  // pixels per second (was 7 per frame at 60 FPS)
+#define BALL_RAIN_STEP    (1.0f / 120.0f)
+#define BALL_RAIN_MAX_STEPS 8     // caps the frame cost after a hitch
+
+typedef struct {
+    Vector2 position;
+    Color color;
+    bool active;
+} Ball;
+
+typedef struct {
+    Ball *balls;
+    int capacity;
+    int activeCount;
+    int minActive;          // caught balls come back only when fewer than this are falling
+    float radius;
+    float fallSpeed;
+    float basketSpeed;
+    float basketX, basketY, basketWidth;
+    float width, height;    // play area; new balls start up to one height above it
+    int score;
+    int misses;
+    unsigned int rng;
+    int columns;            // one-pixel x columns
+    int *columnStart;       // columns + 1 offsets into order
+    int *order;             // ball indices sorted by column
+    bool dirty;             // a ball changed column since the last sort
+    float accumulator;      // frame time not yet stepped
+    int catchTests;         // balls looked at by the last catch test
+} BallRain;
+
+void LoadBallRain(BallRain *rain, int capacity, float radius, float width, float height);
+void UnloadBallRain(BallRain *rain);
+
+// Scatters every ball above the play area and centres the basket
+void ResetBallRain(BallRain *rain, int minActive, unsigned int seed);
+
+// Runs as many fixed steps as dt covers. direction is -1, 0 or 1 for the basket.
+void UpdateBallRain(BallRain *rain, float dt, int direction);
+
+// The parts of one step, in the order UpdateBallRain runs them, so the bench
+// can time the catch test on its own
+void MoveBallRain(BallRain *rain, float h, int direction);
+void SortBallRain(BallRain *rain);      // does nothing unless a ball changed column
+int CatchBallRain(BallRain *rain);      // returns the balls caught
+void RefillBallRain(BallRain *rain);    // misses, and caught balls below minActive, fall back in
+
+#endif // FALLINGBALLS_H
@@ -0,0 +1,175 @@
+#include "flowfield.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int CellAt(const FlowField *field, Vector2 p) {
+    int cx = (int)((p.x - field->bounds.x) / field->cellSize);
+    int cy = (int)((p.y - field->bounds.y) / field->cellSize);
+    if (cx < 0) cx = 0;
+    if (cy < 0) cy = 0;
+    if (cx >= field->cols) cx = field->cols - 1;
+    if (cy >= field->rows) cy = field->rows - 1;
+    return cy * field->cols + cx;
+}
+
+void LoadFlowField(FlowField *field, Rectangle bounds, float cellSize) {
+    UnloadFlowField(field);
+    if (cellSize < 1.0f) cellSize = 1.0f;
+
+    field->bounds = bounds;
+    field->cellSize = cellSize;
+    field->cols = (int)(bounds.width / cellSize) + 1;
+    field->rows = (int)(bounds.height / cellSize) + 1;
+    field->publishedTarget = -1;
+    field->pendingTarget = -1;
+
+    int cells = field->cols * field->rows;
+    field->blocked = calloc(cells, 1);
+    field->flow = calloc(cells, sizeof(Vector2));
+    field->nextFlow = calloc(cells, sizeof(Vector2));
+    field->distance = malloc(sizeof(int) * cells);
+    field->queue = malloc(sizeof(int) * cells);
+    if (!field->blocked || !field->flow || !field->nextFlow || !field->distance || !field->queue) {
+        UnloadFlowField(field);
+    }
+}
+
+void UnloadFlowField(FlowField *field) {
+    free(field->blocked);
+    free(field->flow);
+    free(field->nextFlow);
+    free(field->distance);
+    free(field->queue);
+    memset(field, 0, sizeof(*field));
+    field->publishedTarget = -1;
+    field->pendingTarget = -1;
+}
+
+void SetFlowFieldObstacles(FlowField *field, const Rectangle *rects, int count, float clearance) {
+    if (field->blocked == NULL) return;
+    memset(field->blocked, 0, field->cols * field->rows);
+
+    for (int i = 0; i < count; i++) {
+        Rectangle r = rects[i];
+        float left = r.x - clearance, right = r.x + r.width + clearance;
+        float top = r.y - clearance, bottom = r.y + r.height + clearance;
+        int x0 = CellAt(field, (Vector2){ left, top }) % field->cols;
+        int y0 = CellAt(field, (Vector2){ left, top }) / field->cols;
+        int x1 = CellAt(field, (Vector2){ right, bottom }) % field->cols;
+        int y1 = CellAt(field, (Vector2){ right, bottom }) / field->cols;
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                float cx = field->bounds.x + (x + 0.5f) * field->cellSize;
+                float cy = field->bounds.y + (y + 0.5f) * field->cellSize;
+                if (cx >= left && cx <= right && cy >= top && cy <= bottom) field->blocked[y * field->cols + x] = 1;
+            }
+        }
+    }
+
+    // Walls moved, so whatever is published or half-built is stale
+    memset(field->flow, 0, sizeof(Vector2) * field->cols * field->rows);
+    field->publishedTarget = -1;
+    field->phase = 0;
+}
+
+void SetFlowFieldTarget(FlowField *field, Vector2 target) {
+    if (field->flow == NULL) return;
+    field->pendingTarget = CellAt(field, target);
+}
+
+static void BeginRebuild(FlowField *field) {
+    int cells = field->cols * field->rows;
+    for (int i = 0; i < cells; i++) field->distance[i] = -1;
+
+    field->buildTarget = field->pendingTarget;
+    field->distance[field->buildTarget] = 0;
+    field->queue[0] = field->buildTarget;
+    field->queueHead = 0;
+    field->queueTail = 1;
+    field->directionCursor = 0;
+    field->phase = 1;
+}
+
+static Vector2 BestStep(const FlowField *field, int cell) {
+    static const int dx[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+    static const int dy[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+    int d = field->distance[cell];
+    if (d <= 0) return (Vector2){ 0, 0 };
+
+    int x = cell % field->cols;
+    int y = cell / field->cols;
+    int best = -1;
+    float bestSlope = 0.0f;
+    for (int k = 0; k < 8; k++) {
+        int nx = x + dx[k], ny = y + dy[k];
+        if (nx < 0 || ny < 0 || nx >= field->cols || ny >= field->rows) continue;
+        int nd = field->distance[ny * field->cols + nx];
+        if (nd < 0 || nd >= d) continue;
+
+        bool diagonal = (k >= 4);
+        // No cutting corners past a blocked orthogonal cell
+        if (diagonal && (field->blocked[y * field->cols + nx] || field->blocked[ny * field->cols + x])) continue;
+
+        // Distances are 4-connected, so a diagonal step can drop by two
+        float slope = (d - nd) / (diagonal ? 1.41421356f : 1.0f);
+        if (slope > bestSlope) {
+            bestSlope = slope;
+            best = k;
+        }
+    }
+    if (best < 0) return (Vector2){ 0, 0 };
+    float len = (best >= 4) ? 0.70710678f : 1.0f;
+    return (Vector2){ dx[best] * len, dy[best] * len };
+}
+
+void UpdateFlowField(FlowField *field, int budget) {
+    if (field->flow == NULL) return;
+
+    if (field->phase == 0) {
+        if (field->pendingTarget < 0 || field->pendingTarget == field->publishedTarget) return;
+        BeginRebuild(field);
+    }
+
+    while (budget > 0 && field->phase == 1) {
+        if (field->queueHead == field->queueTail) {
+            field->phase = 2;
+            break;
+        }
+        int cell = field->queue[field->queueHead++];
+        int x = cell % field->cols;
+        int y = cell / field->cols;
+        int next[4] = {
+            (x > 0) ? cell - 1 : -1,
+            (x < field->cols - 1) ? cell + 1 : -1,
+            (y > 0) ? cell - field->cols : -1,
+            (y < field->rows - 1) ? cell + field->cols : -1
+        };
+        for (int k = 0; k < 4; k++) {
+            int n = next[k];
+            if (n < 0 || field->blocked[n] || field->distance[n] >= 0) continue;
+            field->distance[n] = field->distance[cell] + 1;
+            field->queue[field->queueTail++] = n;
+        }
+        budget--;
+    }
+
+    int cells = field->cols * field->rows;
+    while (budget > 0 && field->phase == 2) {
+        field->nextFlow[field->directionCursor] = BestStep(field, field->directionCursor);
+        field->directionCursor++;
+        budget--;
+
+        if (field->directionCursor == cells) {
+            Vector2 *published = field->flow;
+            field->flow = field->nextFlow;
+            field->nextFlow = published;
+            field->publishedTarget = field->buildTarget;
+            field->phase = 0;
+        }
+    }
+}
+
+Vector2 SampleFlowField(const FlowField *field, Vector2 position) {
+    if (field->flow == NULL) return (Vector2){ 0, 0 };
+    return field->flow[CellAt(field, position)];
+}
@@ -0,0 +1,43 @@
+#ifndef FLOWFIELD_H
+#define FLOWFIELD_H
+
+#include "raylib.h"
+
+// Shared grid flow field toward a single target. A breadth-first search runs
+// out from the target cell around blocked cells, then every cell stores the
+// direction of its best downhill neighbour. Any number of agents can then
+// steer with one lookup each. Rebuilds are spread over frames with a work
+// budget; the previous field stays published until the new one is complete.
+typedef struct {
+    Rectangle bounds;
+    float cellSize;
+    int cols;
+    int rows;
+    unsigned char *blocked;
+    Vector2 *flow;          // published direction per cell, zero where there is no path
+    int publishedTarget;    // cell the published field leads to, -1 when none
+    int pendingTarget;      // most recently requested target cell
+
+    // In-progress rebuild
+    int phase;              // 0: idle, 1: expanding distances, 2: writing directions
+    int buildTarget;
+    int *distance;          // steps to buildTarget, -1 when unreached
+    Vector2 *nextFlow;
+    int *queue;
+    int queueHead;
+    int queueTail;
+    int directionCursor;
+} FlowField;
+
+void LoadFlowField(FlowField *field, Rectangle bounds, float cellSize);
+void UnloadFlowField(FlowField *field);
+
+// Marks cells whose centre lies within clearance of a rect as blocked
+void SetFlowFieldObstacles(FlowField *field, const Rectangle *rects, int count, float clearance);
+void SetFlowFieldTarget(FlowField *field, Vector2 target);
+
+// Advances the rebuild by at most budget cells of work
+void UpdateFlowField(FlowField *field, int budget);
+Vector2 SampleFlowField(const FlowField *field, Vector2 position);
+
+#endif // FLOWFIELD_H
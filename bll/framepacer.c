@@ -0,0 +1,119 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE 199309L // nanosleep()
+#endif
+
+#include "framepacer.h"
+#include "profiler.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(_WIN32)
+// Declared by hand, windows.h clashes with raylib names. Sleep follows the
+// 1 ms timer period raylib requests through winmm at startup.
+__declspec(dllimport) void __stdcall Sleep(unsigned long milliseconds);
+#else
+#include <time.h>
+#endif
+
+static void SleepSeconds(double seconds) {
+    if (seconds <= 0.0) return;
+#if defined(_WIN32)
+    Sleep((unsigned long)(seconds * 1000.0));
+#else
+    struct timespec ts;
+    ts.tv_sec = (time_t)seconds;
+    ts.tv_nsec = (long)((seconds - (double)ts.tv_sec) * 1e9);
+    nanosleep(&ts, NULL);
+#endif
+}
+
+void SetFramePacerMode(FramePacer *pacer, PaceMode mode, double interval) {
+    memset(pacer, 0, sizeof(*pacer));
+    pacer->mode = mode;
+    pacer->interval = interval;
+    pacer->sleepSlack = PACER_MAX_SLACK;
+}
+
+void WaitFramePacer(FramePacer *pacer) {
+    double now = ProfilerTime();
+    pacer->spinMs = 0.0;
+
+    if ((pacer->mode == PACE_FIXED || pacer->mode == PACE_ADAPTIVE) && pacer->interval > 0.0) {
+        // Deadlines advance by whole intervals so small overruns are paid
+        // back next frame; after a real hitch the schedule restarts from now
+        if (pacer->deadline == 0.0 || now - pacer->deadline > pacer->interval) pacer->deadline = now;
+        pacer->deadline += pacer->interval;
+
+        if (pacer->mode == PACE_FIXED) {
+            SleepSeconds(pacer->deadline - now);
+        } else {
+            double sleepFor = pacer->deadline - now - pacer->sleepSlack;
+            if (sleepFor > 0.0) {
+                double before = ProfilerTime();
+                SleepSeconds(sleepFor);
+                double overshoot = ProfilerTime() - before - sleepFor;
+                // Follow the worst recent oversleep, letting a single spike fade
+                double slack = fmax(pacer->sleepSlack * 0.99, overshoot + PACER_MIN_SLACK);
+                pacer->sleepSlack = fmin(fmax(slack, PACER_MIN_SLACK), PACER_MAX_SLACK);
+            }
+            double spinStart = ProfilerTime();
+            while (ProfilerTime() < pacer->deadline) { }
+            pacer->spinMs = (ProfilerTime() - spinStart) * 1000.0;
+        }
+        now = ProfilerTime();
+    }
+
+    if (pacer->lastFrame > 0.0) {
+        pacer->frameMs[pacer->head] = (float)((now - pacer->lastFrame) * 1000.0);
+        pacer->head = (pacer->head + 1) % PACER_HISTORY;
+        if (pacer->count < PACER_HISTORY) pacer->count++;
+    }
+    pacer->lastFrame = now;
+}
+
+static int CompareFloats(const void *a, const void *b) {
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+FramePacerStats GetFramePacerStats(const FramePacer *pacer) {
+    FramePacerStats stats = {0};
+    int n = pacer->count;
+    if (n == 0) return stats;
+
+    float sorted[PACER_HISTORY];
+    double sum = 0.0, sumSq = 0.0;
+    for (int i = 0; i < n; i++) {
+        float ms = pacer->frameMs[i];
+        sorted[i] = ms;
+        sum += ms;
+        sumSq += (double)ms * ms;
+    }
+    qsort(sorted, n, sizeof(float), CompareFloats);
+
+    double mean = sum / n;
+    stats.samples = n;
+    stats.meanMs = (float)mean;
+    stats.jitterMs = (float)sqrt(fmax(sumSq / n - mean * mean, 0.0));
+    stats.minMs = sorted[0];
+    stats.maxMs = sorted[n - 1];
+    stats.p99Ms = sorted[(n * 99) / 100];
+
+    float lateMs = 1.5f * (float)((pacer->interval > 0.0 && (pacer->mode == PACE_FIXED || pacer->mode == PACE_ADAPTIVE))
+                                  ? pacer->interval * 1000.0 : mean);
+    for (int i = 0; i < n; i++) {
+        if (pacer->frameMs[i] > lateMs) stats.late++;
+    }
+    return stats;
+}
+
+const char *PaceModeName(PaceMode mode) {
+    switch (mode) {
+        case PACE_VSYNC: return "vsync";
+        case PACE_UNCAPPED: return "uncapped";
+        case PACE_FIXED: return "fixed cap";
+        case PACE_ADAPTIVE: return "adaptive";
+        default: return "?";
+    }
+}
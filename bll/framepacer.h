@@ -0,0 +1,51 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+// Frame pacing after the buffer swap, replacing raylib's SetTargetFPS wait.
+// VSYNC and UNCAPPED do not wait here at all (the swap itself blocks, or
+// nothing does); FIXED sleeps to a set interval the way raylib does; ADAPTIVE
+// sleeps most of the way and spins the rest, learning how far the OS tends to
+// oversleep. Every frame's length is kept for the jitter statistics.
+#define PACER_HISTORY    256
+#define PACER_MIN_SLACK  0.0005   // seconds the adaptive sleep always leaves to the spin
+#define PACER_MAX_SLACK  0.004
+
+typedef enum {
+    PACE_VSYNC,
+    PACE_UNCAPPED,
+    PACE_FIXED,
+    PACE_ADAPTIVE,
+    PACE_MODE_COUNT
+} PaceMode;
+
+typedef struct {
+    PaceMode mode;
+    double interval;    // seconds per frame for FIXED and ADAPTIVE
+    double deadline;    // when the current frame should end, 0 to restart the schedule
+    double lastFrame;   // when the previous frame ended
+    double sleepSlack;  // how early the adaptive sleep stops
+    double spinMs;      // time spent spinning in the last wait
+    float frameMs[PACER_HISTORY];
+    int head;
+    int count;
+} FramePacer;
+
+typedef struct {
+    float meanMs;
+    float jitterMs;     // standard deviation of the frame time
+    float minMs, maxMs;
+    float p99Ms;
+    int late;           // frames longer than 1.5 intervals (or 1.5x the mean when unpaced)
+    int samples;
+} FramePacerStats;
+
+// interval is ignored by VSYNC and UNCAPPED; the history starts over
+void SetFramePacerMode(FramePacer *pacer, PaceMode mode, double interval);
+
+// Call once per frame, right after presenting
+void WaitFramePacer(FramePacer *pacer);
+
+FramePacerStats GetFramePacerStats(const FramePacer *pacer);
+const char *PaceModeName(PaceMode mode);
+
+#endif // FRAMEPACER_H
@@ -2,10 +2,33 @@
 #include<time.h>
 #include "raylib.h"
 #include "raymath.h"
+#include "rlgl.h"
 #include <stdlib.h>
 #include <math.h>
 #include <stdbool.h>
 #include <string.h>
+#include "poisson.h"
+#include "rectgrid.h"
+#include "flowfield.h"
+#include "spatialhash.h"
+#include "profiler.h"
+#include "particles.h"
+#include "dictionary.h"
+#include "wordlehint.h"
+#include "rigidbody.h"
+#include "throwpath.h"
+#include "bowling.h"
+#include "fallingballs.h"
+#include "framepacer.h"
+#include "vecbatch.h"
+#include "assets.h"
+#include "drawlist.h"
+#include "snapshot.h"
+#include "netlink.h"
+#include "rollback.h"
+#ifdef NULL_RENDER
+#include "nullrender.h"
+#endif
 
 // Simple blur shader source
 static const char *blurShaderCode =
@@ -26,27 +49,93 @@ static const char *blurShaderCode =
 "    finalColor = sum / 25.0;\n"
 "}\n";
 
+// Analytic concentric rings for the power-up shockwaves, drawn on one quad.
+// Rings sit `spacing` apart, shrinking inward from `radius`.
+static const char *shockwaveShaderCode =
+"#version 330\n"
+"in vec2 fragTexCoord;\n"
+"in vec4 fragColor;\n"
+"out vec4 finalColor;\n"
+"uniform vec2 size;\n"
+"uniform float radius;\n"
+"uniform float spacing;\n"
+"uniform float ringCount;\n"
+"uniform float thickness;\n"
+"uniform vec4 ringColor;\n"
+"void main() {\n"
+"    float d = length((fragTexCoord - 0.5) * size);\n"
+"    float k = (spacing > 0.0) ? clamp(floor((radius - d) / spacing + 0.5), 0.0, ringCount - 1.0) : 0.0;\n"
+"    float ringRadius = radius - k * spacing;\n"
+"    float coverage = (ringRadius > 0.0) ? 1.0 - smoothstep(0.0, thickness, abs(d - ringRadius)) : 0.0;\n"
+"    finalColor = vec4(ringColor.rgb, ringColor.a * coverage);\n"
+"}\n";
+
 #define MAX_ENEMIES   100
 #define MAX_BULLETS   500
-#define MAX_OBSTACLES 4
-#define NUM_PINS      10
+#define MAX_OBSTACLES 512
+#define OBSTACLE_SPACING 10
+#define MAX_OBSTACLE_HITS 16
+#define FLOW_CELL_SIZE 20
+#define FLOW_FIELD_BUDGET 2048 // cells of rebuild work per frame
+#define SEPARATION_RADIUS 40.0f
+#define SEPARATION_STRENGTH 120.0f
+#define ARENA_WIDTH  2400.0f   // 3x3 backdrop tiles; the camera shows a window's worth
+#define ARENA_HEIGHT 1800.0f
+#define ARENA_TILE_WIDTH  800.0f
+#define ARENA_TILE_HEIGHT 600.0f
+#define VIEW_CULL_MARGIN 60.0f // sprites centred this far outside the view can still reach into it
+#define MAX_NEIGHBOURS 32
+#define MAX_PARTICLES 32768
 #define MAX_BALLS     10
 
-// Bowling sizes/speeds
-#define BOWLING_BALL_RADIUS   15
-#define PIN_RADIUS    20
-#define LANE_LEFT     140
-#define LANE_RIGHT    660
+// Bowling controls (sizes and the throw itself are in bowling.h)
+#define AIM_SPEED     1.2f        // radians per second while steering the throw
+#define CHARGE_RATE   0.6f        // power per second while SPACE is held
 
 // Falling balls defines
 #define BALLS_RADIUS 20
-#define BALL_SPEED 4
 #define TARGET_SCORE 5
 #define MAX_MISSES 5
 
 // Wordle defines
 #define WORD_LENGTH 5
 #define MAX_GUESSES 6
+#define WORDLE_HINT_MAX_PAIRS 150000   // guesses x candidates per hint: about 5 ms on one core
+
+// Fixed timestep
+#define SIM_HZ 120
+#define SIM_DT (1.0f / SIM_HZ)
+#define SIM_MAX_STEPS 64          // per rendered frame; past this the backlog is dropped
+#define SIM_MAX_FRAME_TIME 0.25f  // longer hitches (window drags, breakpoints) are clamped
+#define SIM_SNAP_DISTANCE 64.0f   // moving this far in one step is a teleport, not motion
+#define SIM_MAX_KEYS 512
+#define SIM_MAX_CHARS 32
+#define MIN_TIME_SCALE 0.125f
+#define MAX_TIME_SCALE 8.0f
+
+// Player buttons, one byte per Pikachu per sim step (see LocalPlayerInput)
+#define INPUT_LEFT    0x01
+#define INPUT_RIGHT   0x02
+#define INPUT_UP      0x04
+#define INPUT_DOWN    0x08
+#define INPUT_HELD    0x0F        // the held ones; the rest are presses
+#define INPUT_SHOOT   0x10
+#define INPUT_ELIXIR  0x20
+#define INPUT_RESTART 0x40
+
+// Co-op
+#define COOP_PORT 7777            // player 1's; player 2 listens on the next one
+#define COOP_MAGIC 0x504F4F43u    // "COOP"
+#define COOP_MAX_INPUTS (2 * ROLLBACK_WINDOW)   // the most frames of input a packet can owe the peer
+
+// Frame pacing
+#define PACER_GRAPH_FRAMES 200
+#define PACER_GRAPH_HEIGHT 40
+
+// Texture memory
+#define VRAM_BUDGET_MB 64         // released scene assets stay cached below this
+#define POWERUP_WIDTH  100.0f     // on-screen width of the power-up sprites
+#define LOGO_WIDTH     150.0f
 
 typedef enum {
     OPENING_SCENE,
@@ -65,12 +154,14 @@ typedef enum {
 
 typedef struct {
     Vector2 position;
+    Vector2 previous;   // position before the last sim step, for drawing
     Vector2 velocity;
     bool active;
 } Bullet;
 
 typedef struct {
     Vector2 position;
+    Vector2 previous;   // position before the last sim step, for drawing
     Vector2 velocity;
     float speed;
     bool active;
@@ -83,34 +174,158 @@ typedef struct {
     bool active;
 } Obstacle;
 
+// Spawn director state (see Spawn director)
+#define MAX_WAVE_SIZE   12
+#define WAVE_QUEUE_SIZE 4
+
 typedef struct {
-    Vector2 position;
-    Vector2 velocity;
-    float rotation;
-    bool fallen;
-    bool animating;
-} Pin;
+    int side;   // 0: left, 1: right, 2: top, 3: bottom
+    float edge; // 0..1 along the side, resolved against the window at insert time
+    int type;
+} SpawnOrder;
 
-// Falling balls struct
 typedef struct {
-    Vector2 position;
-    Color color;
-    bool active;
-} Ball;
+    float dueTime; // gameTimer value at which the wave is released
+    int count;
+    SpawnOrder orders[MAX_WAVE_SIZE];
+} SpawnWave;
+
+typedef struct {
+    SpawnWave queue[WAVE_QUEUE_SIZE];
+    int head;
+    int queued;
+    float planTime;     // dueTime of the last planned wave
+    float baseInterval;
+    float enemySpeed;
+    float tokens;
+    float tokenRate;    // enemies per second the bucket refills at
+} SpawnDirector;
+
+// Everything a sim step reads and writes, as one block of plain data so the
+// whole game is saved or restored with a single copy (see Save state).
+// Assets, input, settings and indexes rebuilt from it stay outside; so do
+// the systems that own heap memory, which are serialized alongside it.
+typedef struct {
+    unsigned int rng;           // SimRandom state
+
+    // Entities
+    Bullet   bullets[MAX_BULLETS];
+    Enemy    enemies[MAX_ENEMIES];
+    Obstacle obstacles[MAX_OBSTACLES];
+    SpawnDirector director;
+
+    // Player
+    Vector2  playerPos;
+    float    playerSpeed;
+    int      score;
+    bool     gameOver;
+    bool     secondChanceUsed;
+    bool     deadSoundPlayed;
+    float    gameTimer;
+
+    // Co-op partner, player 2 (see Co-op)
+    bool     coop;
+    Vector2  partnerPos;
+
+    // Scene flow
+    GameState gameState;
+    Difficulty selectedDifficulty;
+    float    transitionTimer;
+    float    gameOverScale;
+    bool     animationComplete;
+    int      reviveChoice;      // 0 = YES, 1 = NO
+    float    reviveTimer;       // seconds left to answer
+
+    // Elixir buff
+    bool     elixirAvailable;
+    Vector2  elixirPos;
+    bool     elixirReady;
+    float    elixirSpawnTimer;
+    float    elixirDurationTimer;
+    float    elixirSpawnInterval;
+    bool     elixirEffectActive;
+    float    elixirEffectTimer;
+    int      elixirUser;        // the player the burst spreads from
+
+    // Thunderstone buff
+    bool     thunderstoneAvailable;
+    Vector2  thunderstonePos;
+    float    thunderstoneSpawnTimer;
+    float    thunderstoneDurationTimer;
+    float    thunderstoneSpawnInterval;
+    bool     thunderstoneEffectActive;
+    float    thunderstoneEffectTimer;
+
+    // Speed buff
+    bool     speedAvailable;
+    Vector2  speedPos;
+    float    speedSpawnTimer;
+    float    speedDurationTimer;
+    float    speedSpawnInterval;
+    bool     speedEffectActive;
+    float    speedEffectTimer;
+
+    // Power buff
+    bool     powerAvailable;
+    Vector2  powerPos;
+    float    powerSpawnTimer;
+    float    powerDurationTimer;
+    float    powerSpawnInterval;
+    bool     powerEffectActive;
+    float    powerEffectTimer;
+
+    // Bowling
+    BowlingThrow bowl;          // the rack and the throw, driving pinWorld
+    int      pinRackRows;
+    Vector2  ballPos;
+    float    throwAngle;
+    Vector2  ellipseCenter;
+    float    ballSpeed;
+    float    power;
+    bool     charging;
+    float    settleTimer;
+
+    // Falling balls
+    float    basketHeight;
+    float    basketSideHeight;
+
+    // Wordle
+    float    wordleNoticeTimer;
+    WordleHint wordleHint;
+    bool     wordleHintShown;
+    char     targetWord[WORD_LENGTH + 1];
+    char     guesses[MAX_GUESSES][WORD_LENGTH + 1];
+    Color    guessColors[MAX_GUESSES][WORD_LENGTH];
+    int      currentGuess;
+    int      currentLetter;
+    bool     wordleWon;
+} SimState;
 
 // ------------ Globals ------------
-Bullet   bullets[MAX_BULLETS] = {0};
-Enemy    enemies[MAX_ENEMIES] = {0};
-Obstacle obstacles[MAX_OBSTACLES] = {0};
-Pin      pins[NUM_PINS] = {0};
+SimState sim = {
+    .rng = 1,
+    .playerPos = {400, 300},
+    .playerSpeed = 200.0f,
+    .gameState = OPENING_SCENE,
+    .selectedDifficulty = DIFFICULTY_MEDIUM,
+    .gameOverScale = 0.1f,
+    .reviveTimer = 10.0f,
+    .pinRackRows = PIN_RACK_ROWS,
+    .bowl.ball = -1,
+};
 
-Vector2  playerPos = {400, 300};
+int      obstacleCount = 36;    // about four per backdrop tile
+RectGrid obstacleIndex = {0}; // rebuilt by SpawnObstacles, queried by everything that touches rocks
+FlowField enemyFlow = {0};    // shared path toward the player around the rocks
+SpatialHash enemyHash = {0};  // rebuilt every frame for neighbour queries
 float    basePlayerSpeed = 200.0f;
-float    playerSpeed = 200.0f;
-int      score = 0;
-bool     gameOver = false;
-bool     secondChanceUsed = false;
-float    gameTimer = 0.0f;
+
+// Scene flow
+float    scaleSpeed = 1.5f;
+Rectangle easyBtn = {0};
+Rectangle mediumBtn = {0};
+Rectangle hardBtn = {0};
+Rectangle startBtn = {0};
 
 Font     emojiFont = {0};
 Texture2D pokeballTex = {0};
@@ -135,96 +350,32 @@ bool     musicPlaying = false;
 
 // Death sound
 Sound    deadSound = {0};
-bool     deadSoundPlayed = false;
 
-// Elixir buff system
+// Buffs: how long a pick-up waits to be collected, then how long its effect lasts
 Texture2D elixirTex = {0};
-bool     elixirAvailable = false;
-Vector2  elixirPos = {0};
-bool     elixirReady = false;
-float    elixirSpawnTimer = 0.0f;
-float    elixirDurationTimer = 0.0f;
-float    elixirSpawnInterval = 0.0f;
 const float ELIXIR_DURATION = 8.0f;
-
-// Elixir effect variables
-bool     elixirEffectActive = false;
-float    elixirEffectTimer = 0.0f;
 const float ELIXIR_EFFECT_DURATION = 8.0f;
-
-// Thunderstone buff system
 Texture2D thunderstoneTex = {0};
-bool     thunderstoneAvailable = false;
-Vector2  thunderstonePos = {0};
-float    thunderstoneSpawnTimer = 0.0f;
-float    thunderstoneDurationTimer = 0.0f;
-float    thunderstoneSpawnInterval = 0.0f;
 const float THUNDERSTONE_DURATION = 5.0f;
-
-// Thunderstone effect variables
-bool     thunderstoneEffectActive = false;
-float    thunderstoneEffectTimer = 0.0f;
 const float THUNDERSTONE_EFFECT_DURATION = 8.0f;
-
-// Speed buff system
 Texture2D speedTex = {0};
-bool     speedAvailable = false;
-Vector2  speedPos = {0};
-float    speedSpawnTimer = 0.0f;
-float    speedDurationTimer = 0.0f;
-float    speedSpawnInterval = 0.0f;
 const float SPEED_DURATION = 8.0f;
-
-// Speed effect variables
-bool     speedEffectActive = false;
-float    speedEffectTimer = 0.0f;
 const float SPEED_EFFECT_DURATION = 8.0f;
-
-// Power buff system
 Texture2D powerTex = {0};
-bool     powerAvailable = false;
-Vector2  powerPos = {0};
-float    powerSpawnTimer = 0.0f;
-float    powerDurationTimer = 0.0f;
-float    powerSpawnInterval = 0.0f;
 const float POWER_DURATION = 8.0f;
-
-// Power effect variables
-bool     powerEffectActive = false;
-float    powerEffectTimer = 0.0f;
 const float POWER_EFFECT_DURATION = 8.0f;
 
-// Bowling state
-Vector2  ballPos = {0};
-float    t = 0.0f;
-float    throwAngle = 0.0f;
+// Bowling settings
 const float maxAngle = PI / 6;
-Vector2  ellipseCenter = {0};
-float    a = 100.0f;
-float    b = 500.0f;
-float    baseSpeed = 0.02f;
-float    ballSpeed = 0.0f;
-bool     ballLaunched = false;
-float    power = 0.0f;
 float    maxPower = 1.0f;
-bool     charging = false;
-bool     strikeMode = false;
-bool     luckyStrike = false;
+RigidWorld pinWorld = {0};    // the ball and the pins
 
 // Bowling assets
 Sound    hitSound = {0};
 Texture2D bowlingBg = {0};
 
 // Falling balls globals
-Ball balls[MAX_BALLS] = {0};
-float basketX;
-float basketY;
-float basketWidth;
-float basketHeight;
-float basketSideHeight;
-int basketSpeed = 7;
-int ballScore = 0;
-int misses = 0;
+BallRain ballRain = {0};     // balls, basket position and score
 Texture2D ballsBg = {0};
 Texture2D basketTex = {0};  // New texture for the basket PNG
 
@@ -233,160 +384,823 @@ const char* wordList[] = {
     "APPLE", "BREAD", "CHAIR", "DANCE", "EAGLE",
     "FLAME", "GRAPE", "HOUSE", "IMAGE", "JOKER"
 };
-const int NUM_WORDS = 10;
-char targetWord[WORD_LENGTH + 1];
-char guesses[MAX_GUESSES][WORD_LENGTH + 1];
-Color guessColors[MAX_GUESSES][WORD_LENGTH];
-int currentGuess = 0;
-int currentLetter = 0;
-bool wordleWon = false;
+const int NUM_WORDS = 10;   // fallback when the word list resources are missing
+WordList wordleAnswers = {0};
+WordList wordleAllowed = {0};
+double wordleHintTime = 0.0;   // seconds the last hint took to compute
 
 // Revive prompt globals
 Shader blurShader = {0};
 RenderTexture2D reviveTarget = {0};
-int reviveChoice = 0; // 0 = YES, 1 = NO
-int reviveTimer = 600; // 10 seconds at 60 FPS
+const float REVIVE_TIME = 10.0f;
+
+// Shockwave shader
+Shader shockwaveShader = {0};
+int shockwaveSizeLoc = -1;
+int shockwaveRadiusLoc = -1;
+int shockwaveSpacingLoc = -1;
+int shockwaveCountLoc = -1;
+int shockwaveThicknessLoc = -1;
+int shockwaveColorLoc = -1;
+
+// Particles for pin falls, enemy deaths and pickups
+ParticleSystem particles = {0};
+Texture2D particleTex = {0};
+
+// Playfield sprites, sorted by layer then texture each frame (see DrawPlayfield)
+typedef enum {
+    LAYER_PLAYER,
+    LAYER_BULLETS,
+    LAYER_ENEMIES,      // particles are drawn after this layer
+    LAYER_POWERUPS,
+    LAYER_OBSTACLES,
+    LAYER_COUNT
+} DrawLayer;
+#define MAX_SPRITES (ROLLBACK_PLAYERS + MAX_BULLETS + MAX_ENEMIES + 4 + MAX_OBSTACLES)
+DrawList drawList = {0};
+
+// Profiler overlay (F3)
+bool     profilerVisible = false;
+ProfileZone separationZone = { "Separation" };
+ProfileHistogram neighbourHistogram = { "Enemy neighbours" };
+
+#ifdef RLGL_BATCH_STATS
+// Render batch flushes, reported by rlgl when it is built with RLGL_BATCH_STATS
+// (the null build, or a raylib built from the rlgl.h in this tree)
+#define FLUSH_TARGET RL_FLUSH_CAUSE_COUNT       // render texture switch, flushed here ahead of raylib
+#define FLUSH_CAUSE_COUNT (RL_FLUSH_CAUSE_COUNT + 1)
+typedef struct {
+    int flushes;
+    int drawCalls;
+    int vertices;
+    int byCause[FLUSH_CAUSE_COUNT];
+} BatchStats;
+BatchStats batchCounting = {0};     // the frame being drawn
+BatchStats batchStats = {0};        // the last finished frame
+int flushCauseOverride = -1;
+const char *flushCauseNames[FLUSH_CAUSE_COUNT] = { "frame", "shader", "blend", "draws", "verts", "batch", "target" };
+#endif
+
+// Frame pacing (F4 cycles the mode, F5 the fixed cap; F6 logs asset memory)
+FramePacer framePacer = {0};
+const int frameCaps[] = { 30, 60, 120, 144, 240 };
+int      frameCapIndex = 1;
+
+// Fixed timestep: the game steps at SIM_HZ whatever the display does
+float    timeScale = 1.0f;      // [ and ] halve/double, \ resets
+float    simAccumulator = 0.0f;
+Vector2  prevPlayerPos = {400, 300};
+Vector2  prevPartnerPos = {0};
+Vector2  prevBallPos = {0};
+RollbackInput stepInput[ROLLBACK_PLAYERS] = {0};   // each Pikachu's buttons for this step
+bool     simReplaying = false;  // running steps again after a co-op rollback: no sounds or particles
+bool     simKeysPressed[SIM_MAX_KEYS] = {0};
+bool     simKeysReleased[SIM_MAX_KEYS] = {0};
+int      simChars[SIM_MAX_CHARS] = {0};
+int      simCharCount = 0;
+int      simCharRead = 0;
+bool     simClick = false;
+Vector2  simClickPos = {0};
+
+// Co-op over UDP (see Co-op)
+typedef enum { COOP_OFF, COOP_CONNECTING, COOP_PLAYING } CoopPhase;
+CoopPhase coopPhase = COOP_OFF;
+int      coopPlayer = 0;        // the Pikachu this side steers
+bool     coopBot = false;       // --bot steers it instead of the keyboard, for headless runs
+unsigned int coopSeed = 0;      // of the run player 1 hosts
+Difficulty coopDifficulty = DIFFICULTY_MEDIUM;
+NetLink  coopLink = {0};
+RollbackSession coopSession = {0};
+int      coopFrameDepth = 0;    // deepest rollback of the last rendered frame
+double   coopFrameResim = 0.0;  // seconds re-simulating in it
+
+// Scene assets: what each scene draws, loaded while a scene that can still
+// be reached holds its set (see UpdateAssetResidency). homeBg is both the
+// menu and the game-over backdrop, so it lives in two sets. Sizes are the
+// largest each is drawn at; full-screen ones get theirs in SetScreenAssetSize
+// (F6 logs what is resident).
+#define ASSET_SET(name, list) { name, list, (int)(sizeof(list) / sizeof(list[0])) }
+AssetLoader assetLoader = {0};
+Asset logoAsset         = { .path = "resources/logo.png", .maxWidth = (int)LOGO_WIDTH, .texture = &logo };
+Asset homeAsset         = { .path = "resources/home.png", .mipmaps = true, .compact = true, .texture = &homeBg };
+Asset aoiAsset          = { .path = "resources/aoi.png", .mipmaps = true, .compact = true, .texture = &aoiTex };
+Asset pikachuAsset      = { .path = "resources/pikachu.png", .texture = &pikachuTex };
+// Raichu is drawn in Pikachu's box
+Asset raichuAsset       = { .path = "resources/raichu.png", .maxWidth = 80, .maxHeight = 80, .texture = &raichuTex };
+Asset pokeballAsset     = { .path = "resources/pokeball.png", .texture = &pokeballTex };
+Asset ultraBallAsset    = { .path = "resources/ultra_ball.png", .texture = &ultraBallTex };
+Asset masterBallAsset   = { .path = "resources/master_ball.png", .texture = &masterBallTex };
+Asset balhAsset         = { .path = "resources/balh.png", .texture = &balhTex };
+Asset elixirAsset       = { .path = "resources/elixir.png", .maxWidth = (int)POWERUP_WIDTH, .texture = &elixirTex };
+Asset thunderstoneAsset = { .path = "resources/thunderstone.png", .maxWidth = (int)POWERUP_WIDTH, .texture = &thunderstoneTex };
+Asset speedAsset        = { .path = "resources/speed.png", .maxWidth = (int)POWERUP_WIDTH, .texture = &speedTex };
+Asset powerAsset        = { .path = "resources/power.png", .maxWidth = (int)POWERUP_WIDTH, .texture = &powerTex };
+Asset normalBoltAsset   = { .path = "resources/normal_lightning_bolt.png", .texture = &normalBulletTex };
+Asset specialBoltAsset  = { .path = "resources/special_lightning_bolt.png", .texture = &specialBulletTex };
+// Arena backdrops are tiled at a fixed size, whatever the window
+Asset easyBgAsset       = { .path = "resources/easy.png", .maxWidth = (int)ARENA_TILE_WIDTH, .maxHeight = (int)ARENA_TILE_HEIGHT,
+                            .mipmaps = true, .compact = true, .texture = &easyBg };
+Asset mediumBgAsset     = { .path = "resources/medium.png", .maxWidth = (int)ARENA_TILE_WIDTH, .maxHeight = (int)ARENA_TILE_HEIGHT,
+                            .mipmaps = true, .compact = true, .texture = &mediumBg };
+Asset hardBgAsset       = { .path = "resources/hard.png", .maxWidth = (int)ARENA_TILE_WIDTH, .maxHeight = (int)ARENA_TILE_HEIGHT,
+                            .mipmaps = true, .compact = true, .texture = &hardBg };
+Asset rockAsset         = { .path = "resources/Rock.png", .shrink = 3, .texture = &obstacleTex };
+Asset ballsBgAsset      = { .path = "resources/background3.png", .mipmaps = true, .compact = true, .texture = &ballsBg };
+Asset basketAsset       = { .path = "resources/bg_fruit_bask.png", .maxWidth = 150, .texture = &basketTex };  // ballRain.basketWidth
+Asset bowlingBgAsset    = { .path = "resources/background.png", .mipmaps = true, .compact = true, .texture = &bowlingBg };
+Asset strikeAsset       = { .path = "resources/strike.wav", .kind = ASSET_SOUND, .sound = &hitSound };
+
+Asset *menuList[] = { &logoAsset, &homeAsset };
+Asset *transitionList[] = { &aoiAsset };
+Asset *runList[] = { &pikachuAsset, &raichuAsset, &pokeballAsset, &ultraBallAsset, &masterBallAsset,
+                     &elixirAsset, &thunderstoneAsset, &speedAsset, &powerAsset,
+                     &normalBoltAsset, &specialBoltAsset, &balhAsset, &homeAsset };
+Asset *easyList[] = { &easyBgAsset };
+Asset *mediumList[] = { &mediumBgAsset };
+Asset *hardList[] = { &hardBgAsset, &rockAsset };
+Asset *ballsList[] = { &ballsBgAsset, &basketAsset };
+Asset *bowlingList[] = { &bowlingBgAsset, &strikeAsset };
+
+AssetSet menuAssets = ASSET_SET("menu", menuList);
+AssetSet transitionAssets = ASSET_SET("transition", transitionList);
+AssetSet runAssets = ASSET_SET("gameplay", runList);
+AssetSet difficultyAssets[] = { ASSET_SET("easy", easyList), ASSET_SET("medium", mediumList), ASSET_SET("hard", hardList) };
+AssetSet miniGameAssets[] = { ASSET_SET("falling balls", ballsList), { "wordle", NULL, 0 }, ASSET_SET("bowling", bowlingList) };
+AssetSet *sceneAssets[] = {
+    &menuAssets, &transitionAssets, &runAssets,
+    &difficultyAssets[0], &difficultyAssets[1], &difficultyAssets[2],
+    &miniGameAssets[0], &miniGameAssets[1], &miniGameAssets[2]
+};
+#define SCENE_ASSET_SETS (int)(sizeof(sceneAssets) / sizeof(sceneAssets[0]))
+
+// Stretched or fitted to the window, which can grow to the monitor
+Asset *screenAssets[] = { &homeAsset, &aoiAsset, &ballsBgAsset, &bowlingBgAsset };
 
 // ------------ Helpers ------------
 static bool ColorsEqual(Color c1, Color c2) {
     return c1.r == c2.r && c1.g == c2.g && c1.b == c2.b && c1.a == c2.a;
 }
 
+// GetRandomValue for the simulation: xorshift32 like the falling balls, with
+// its state in the sim block so a restored game rolls the same numbers
+static int SimRandom(int min, int max) {
+    if (min > max) {
+        int swap = min;
+        min = max;
+        max = swap;
+    }
+    sim.rng ^= sim.rng << 13;
+    sim.rng ^= sim.rng >> 17;
+    sim.rng ^= sim.rng << 5;
+    return min + (int)(sim.rng % ((unsigned int)(max - min) + 1u));
+}
+
+// ------------ Arena ------------
+// The part of the arena a window-sized camera shows when following focus:
+// whole pixels, kept inside the arena, or centred on it when the window is
+// the larger of the two
+static Rectangle ArenaView(Vector2 focus) {
+    float w = (float)GetScreenWidth();
+    float h = (float)GetScreenHeight();
+    float x = (w < ARENA_WIDTH) ? Clamp(focus.x - w/2, 0.0f, ARENA_WIDTH - w) : (ARENA_WIDTH - w) / 2;
+    float y = (h < ARENA_HEIGHT) ? Clamp(focus.y - h/2, 0.0f, ARENA_HEIGHT - h) : (ARENA_HEIGHT - h) / 2;
+    return (Rectangle){ floorf(x), floorf(y), w, h };
+}
+
+// Pick-ups appear where the player can see them, however big the arena is
+static Vector2 RandomViewPoint(float margin) {
+    Rectangle view = ArenaView(sim.playerPos);
+    Vector2 point;
+    point.x = (float)SimRandom((int)(view.x + margin), (int)(view.x + view.width - margin));
+    point.y = (float)SimRandom((int)(view.y + margin), (int)(view.y + view.height - margin));
+    return point;
+}
+
+// ------------ Players ------------
+// One Pikachu solo; co-op adds the partner as player 2
+static int PlayerCount(void) {
+    return sim.coop ? 2 : 1;
+}
+
+static Vector2 *PlayerPos(int player) {
+    return (player == 0) ? &sim.playerPos : &sim.partnerPos;
+}
+
+static bool TouchesPlayer(Vector2 center, float radius) {
+    for (int p = 0; p < PlayerCount(); p++) {
+        if (CheckCollisionCircles(*PlayerPos(p), 20.0f, center, radius)) return true;
+    }
+    return false;
+}
+
+// The Pikachu an enemy at position goes after
+static int NearestPlayer(Vector2 position) {
+    if (!sim.coop) return 0;
+    return (Vector2DistanceSqr(position, sim.partnerPos) < Vector2DistanceSqr(position, sim.playerPos)) ? 1 : 0;
+}
+
+// First player holding button this step, -1 for none
+static int PlayerPressing(RollbackInput button) {
+    for (int p = 0; p < PlayerCount(); p++) {
+        if (stepInput[p] & button) return p;
+    }
+    return -1;
+}
+
+// ------------ Particle effects ------------
+static const ParticleEmitter enemyBurst = {
+    .count = 14, .angle = 0.0f, .spread = PI, .speedMin = 60.0f, .speedMax = 180.0f,
+    .lifeMin = 0.3f, .lifeMax = 0.6f, .sizeStart = 5.0f, .sizeEnd = 1.0f, .drag = 2.0f
+};
+static const ParticleEmitter pickupBurst = {
+    .count = 24, .angle = -PI/2, .spread = PI, .speedMin = 40.0f, .speedMax = 120.0f,
+    .lifeMin = 0.4f, .lifeMax = 0.8f, .sizeStart = 6.0f, .sizeEnd = 1.0f, .gravity = -40.0f, .drag = 1.0f
+};
+static const ParticleEmitter elixirBurst = {
+    .count = 60, .angle = 0.0f, .spread = PI, .speedMin = 150.0f, .speedMax = 300.0f,
+    .lifeMin = 0.5f, .lifeMax = 1.0f, .sizeStart = 7.0f, .sizeEnd = 2.0f,
+    .colorStart = {253, 249, 0, 255}, .colorEnd = {255, 161, 0, 0}, .drag = 1.5f
+};
+static const ParticleEmitter pinSpark = {
+    .count = 10, .angle = 0.0f, .spread = PI, .speedMin = 60.0f, .speedMax = 160.0f,
+    .lifeMin = 0.2f, .lifeMax = 0.4f, .sizeStart = 3.0f, .sizeEnd = 1.0f,
+    .colorStart = {255, 255, 255, 255}, .colorEnd = {255, 255, 255, 0}, .drag = 3.0f
+};
+
+// Particles are cosmetic and outside the sim block, so they roll raylib's numbers
+static unsigned int ParticleSeed(void) {
+    return (unsigned int)GetRandomValue(1, 0x7fffffff);
+}
+
+static void EmitBurst(const ParticleEmitter *emitter, Vector2 position, Color color) {
+    if (simReplaying) return;
+    ParticleEmitter tinted = *emitter;
+    tinted.colorStart = color;
+    tinted.colorEnd = Fade(color, 0.0f);
+    EmitParticles(&particles, &tinted, position, ParticleSeed());
+}
+
+// The sound is left out while re-simulating, but still counts as played
+static void PlayDeadSound(void) {
+    if (!sim.deadSoundPlayed && !simReplaying && deadSound.frameCount > 0) PlaySound(deadSound);
+    sim.deadSoundPlayed = true;
+}
+
+static void EmitEnemyDeath(const Enemy *enemy) {
+    Color color = (enemy->type == 0) ? RED : (enemy->type == 1) ? GOLD : PURPLE;
+    EmitBurst(&enemyBurst, enemy->position, color);
+}
+
+// A toppled pin keeps sliding and can still take others down with it
+static void KnockPin(int i) {
+    sim.bowl.pins[i].fallen = true;
+    EmitParticles(&particles, &pinSpark, pinWorld.bodies[sim.bowl.pins[i].body].position, ParticleSeed());
+    if (hitSound.frameCount > 0) PlaySound(hitSound);
+}
+
+static void UpdatePinKnocks(void) {
+    for (int i = 0; i < sim.bowl.pinCount; i++) {
+        if (sim.bowl.pins[i].fallen) continue;
+        if (BowlingPinKnocked(&sim.bowl, &pinWorld, i)) KnockPin(i);
+    }
+}
+
 static void ResetElixirState(void) {
-    elixirAvailable = false;
-    elixirReady = false;
-    elixirSpawnTimer = 0.0f;
-    elixirDurationTimer = 0.0f;
-    elixirEffectActive = false;
-    elixirEffectTimer = 0.0f;
+    sim.elixirAvailable = false;
+    sim.elixirReady = false;
+    sim.elixirSpawnTimer = 0.0f;
+    sim.elixirDurationTimer = 0.0f;
+    sim.elixirEffectActive = false;
+    sim.elixirEffectTimer = 0.0f;
+    sim.elixirUser = 0;
 }
 
 static void ResetThunderstoneState(void) {
-    thunderstoneAvailable = false;
-    thunderstoneSpawnTimer = 0.0f;
-    thunderstoneDurationTimer = 0.0f;
-    thunderstoneEffectActive = false;
-    thunderstoneEffectTimer = 0.0f;
+    sim.thunderstoneAvailable = false;
+    sim.thunderstoneSpawnTimer = 0.0f;
+    sim.thunderstoneDurationTimer = 0.0f;
+    sim.thunderstoneEffectActive = false;
+    sim.thunderstoneEffectTimer = 0.0f;
 }
 
 static void ResetSpeedState(void) {
-    speedAvailable = false;
-    speedSpawnTimer = 0.0f;
-    speedDurationTimer = 0.0f;
-    speedEffectActive = false;
-    speedEffectTimer = 0.0f;
-    playerSpeed = basePlayerSpeed;
+    sim.speedAvailable = false;
+    sim.speedSpawnTimer = 0.0f;
+    sim.speedDurationTimer = 0.0f;
+    sim.speedEffectActive = false;
+    sim.speedEffectTimer = 0.0f;
+    sim.playerSpeed = basePlayerSpeed;
 }
 
 static void ResetPowerState(void) {
-    powerAvailable = false;
-    powerSpawnTimer = 0.0f;
-    powerDurationTimer = 0.0f;
-    powerEffectActive = false;
-    powerEffectTimer = 0.0f;
+    sim.powerAvailable = false;
+    sim.powerSpawnTimer = 0.0f;
+    sim.powerDurationTimer = 0.0f;
+    sim.powerEffectActive = false;
+    sim.powerEffectTimer = 0.0f;
+}
+
+// ------------ Spawn director ------------
+// Waves are planned a few ahead of time from a difficulty curve and released
+// in one batched insert. A token bucket caps how many enemies can enter per
+// second, so spawn cost stays bounded no matter how high the score climbs.
+
+static float WaveInterval(float time) {
+    float pressure = time * 0.004f + sim.score * 0.005f;
+    if (pressure > 0.6f) pressure = 0.6f;
+    return sim.director.baseInterval * (1.0f - pressure);
+}
+
+static int WaveSize(float time) {
+    int size = 1 + (int)(time / 20.0f) + sim.score / 30;
+    return (size > MAX_WAVE_SIZE) ? MAX_WAVE_SIZE : size;
+}
+
+static int RollEnemyType(float time) {
+    if (time > 20.0f) return SimRandom(0, 2);
+    if (time > 10.0f) return SimRandom(0, 1);
+    return 0;
+}
+
+static void PlanWave(SpawnWave *wave, float dueTime) {
+    // Early waves come from a single side, later ones flank from two and then all four
+    int sideCount = (dueTime > 40.0f) ? 4 : (dueTime > 15.0f) ? 2 : 1;
+    int firstSide = SimRandom(0, 3);
+
+    wave->dueTime = dueTime;
+    wave->count = WaveSize(dueTime);
+    for (int i = 0; i < wave->count; i++) {
+        wave->orders[i].side = (firstSide + i % sideCount) % 4;
+        wave->orders[i].edge = SimRandom(0, 1000) / 1000.0f;
+        wave->orders[i].type = RollEnemyType(dueTime);
+    }
+}
+
+static void ResetSpawnDirector(Difficulty difficulty) {
+    sim.director.head = 0;
+    sim.director.queued = 0;
+    sim.director.planTime = sim.gameTimer;
+    sim.director.baseInterval = (difficulty == DIFFICULTY_EASY) ? 1.5f :
+                            (difficulty == DIFFICULTY_MEDIUM) ? 1.0f : 0.7f;
+    sim.director.enemySpeed = (difficulty == DIFFICULTY_EASY) ? 50.0f :
+                          (difficulty == DIFFICULTY_MEDIUM) ? 85.0f : 100.0f;
+    sim.director.tokenRate = (difficulty == DIFFICULTY_EASY) ? 1.5f :
+                         (difficulty == DIFFICULTY_MEDIUM) ? 2.5f : 3.5f;
+    sim.director.tokens = 1.0f;
+}
+
+// Writes the whole wave into free enemy slots in a single pass. Waves still
+// enter along the edges of the view, so the pressure does not thin out with
+// arena size; from there the enemies chase the player across the whole arena.
+static int ApplyWave(const SpawnWave *wave) {
+    Rectangle view = ArenaView(sim.playerPos);
+    int inserted = 0;
+
+    for (int i = 0; i < MAX_ENEMIES && inserted < wave->count; i++) {
+        if (sim.enemies[i].active) continue;
+
+        const SpawnOrder *order = &wave->orders[inserted];
+        Vector2 pos;
+        switch (order->side) {
+            case 0: pos = (Vector2){view.x, view.y + order->edge * view.height}; break;
+            case 1: pos = (Vector2){view.x + view.width, view.y + order->edge * view.height}; break;
+            case 2: pos = (Vector2){view.x + order->edge * view.width, view.y}; break;
+            default: pos = (Vector2){view.x + order->edge * view.width, view.y + view.height}; break;
+        }
+
+        sim.enemies[i].position = pos;
+        sim.enemies[i].previous = pos;
+        sim.enemies[i].speed = sim.director.enemySpeed;
+        sim.enemies[i].velocity = Vector2Scale(Vector2Normalize(Vector2Subtract(sim.playerPos, pos)), sim.director.enemySpeed);
+        sim.enemies[i].active = true;
+        sim.enemies[i].type = order->type;
+        sim.enemies[i].health = (order->type == 0) ? 1 : (order->type == 1) ? 2 : 3;
+        inserted++;
+    }
+    return inserted;
+}
+
+static void UpdateSpawnDirector(float dt) {
+    sim.director.tokens += sim.director.tokenRate * dt;
+    if (sim.director.tokens > MAX_WAVE_SIZE) sim.director.tokens = MAX_WAVE_SIZE;
+
+    while (sim.director.queued < WAVE_QUEUE_SIZE) {
+        sim.director.planTime += WaveInterval(sim.director.planTime);
+        PlanWave(&sim.director.queue[(sim.director.head + sim.director.queued) % WAVE_QUEUE_SIZE], sim.director.planTime);
+        sim.director.queued++;
+    }
+
+    // At most one wave per frame, and only once the bucket can pay for all of it
+    SpawnWave *next = &sim.director.queue[sim.director.head];
+    if (next->dueTime <= sim.gameTimer && sim.director.tokens >= next->count) {
+        sim.director.tokens -= ApplyWave(next);
+        sim.director.head = (sim.director.head + 1) % WAVE_QUEUE_SIZE;
+        sim.director.queued--;
+    }
+}
+
+// The arena centre, which SpawnObstacles keeps clear of rocks
+static void PlacePlayersAtSpawn(void) {
+    sim.playerPos = (Vector2){ARENA_WIDTH / 2, ARENA_HEIGHT / 2};
+    sim.partnerPos = (Vector2){ARENA_WIDTH / 2 + 60, ARENA_HEIGHT / 2};
 }
 
 static void ResetGame(Difficulty difficulty) {
-    playerPos = (Vector2){400, 300};
-    playerSpeed = basePlayerSpeed;
-    score = 0;
-    gameOver = false;
-    deadSoundPlayed = false;
-    gameTimer = 0.0f;
-    for (int i = 0; i < MAX_ENEMIES;  i++) enemies[i].active = false;
-    for (int i = 0; i < MAX_BULLETS;  i++) bullets[i].active = false;
-    for (int i = 0; i < MAX_OBSTACLES; i++) obstacles[i].active = false;
+    PlacePlayersAtSpawn();
+    sim.playerSpeed = basePlayerSpeed;
+    sim.score = 0;
+    sim.gameOver = false;
+    sim.deadSoundPlayed = false;
+    sim.gameTimer = 0.0f;
+    for (int i = 0; i < MAX_ENEMIES;  i++) sim.enemies[i].active = false;
+    for (int i = 0; i < MAX_BULLETS;  i++) sim.bullets[i].active = false;
+    for (int i = 0; i < MAX_OBSTACLES; i++) sim.obstacles[i].active = false;
+    ClearParticles(&particles);
+    UnloadRectGrid(&obstacleIndex);
+    UnloadFlowField(&enemyFlow);
+    ResetSpawnDirector(difficulty);
+    ResetElixirState();
+    ResetThunderstoneState();
+    ResetSpeedState();
+    ResetPowerState();
+}
+
+// A won mini-game: back to the same run at the spawn, with the arena cleared
+static void RevivePlayers(void) {
+    sim.secondChanceUsed = true;
+    PlacePlayersAtSpawn();
+    sim.gameOver = false;
+    for (int i = 0; i < MAX_ENEMIES;  i++) sim.enemies[i].active = false;
+    for (int i = 0; i < MAX_BULLETS;  i++) sim.bullets[i].active = false;
+    ResetSpawnDirector(sim.selectedDifficulty);
     ResetElixirState();
     ResetThunderstoneState();
     ResetSpeedState();
     ResetPowerState();
+    sim.gameState = GAMEPLAY;
+}
+
+// Places obstacleCount rocks with Poisson-disk spacing, clear of the player.
+// Returns false when the arena is too small to hold them all.
+static bool SpawnObstacles(void) {
+    float w = (float)obstacleTex.width;
+    float h = (float)obstacleTex.height;
+    int wanted = (obstacleCount > MAX_OBSTACLES) ? MAX_OBSTACLES : obstacleCount;
+
+    // Sample rock centres; centres a diagonal apart can never overlap
+    Rectangle area = {
+        100 + w/2,
+        100 + h/2,
+        ARENA_WIDTH  - 100 - w,
+        ARENA_HEIGHT - 100 - h
+    };
+    Rectangle playerSafeZone = {
+        sim.playerPos.x - w - 50 - w/2,
+        sim.playerPos.y - h - 50 - h/2,
+        2*w + 100,
+        2*h + 100
+    };
+    static Vector2 centers[MAX_OBSTACLES];
+    static Rectangle rects[MAX_OBSTACLES];
+    int placed = PoissonDiskSample(area, sqrtf(w*w + h*h) + OBSTACLE_SPACING, &playerSafeZone, 1,
+                                   centers, wanted, (unsigned int)SimRandom(1, 0x7fffffff));
+
+    for (int i = 0; i < MAX_OBSTACLES; i++) {
+        sim.obstacles[i].active = (i < placed);
+        if (sim.obstacles[i].active) {
+            sim.obstacles[i].rect = (Rectangle){centers[i].x - w/2, centers[i].y - h/2, w, h};
+            rects[i] = sim.obstacles[i].rect;
+        }
+    }
+    BuildRectGrid(&obstacleIndex, rects, placed, fmaxf(w, h));
+    LoadFlowField(&enemyFlow, (Rectangle){0, 0, ARENA_WIDTH, ARENA_HEIGHT}, FLOW_CELL_SIZE);
+    SetFlowFieldObstacles(&enemyFlow, rects, placed, 20);
+
+    if (placed < wanted) {
+        TraceLog(LOG_WARNING, "Only %d of %d obstacles fit the arena", placed, wanted);
+        return false;
+    }
+    return true;
+}
+
+static bool ObstacleHitsRec(Rectangle rect) {
+    int hit;
+    return QueryRectGridRec(&obstacleIndex, rect, &hit, 1) > 0;
+}
+
+static bool ObstacleHitsCircle(Vector2 center, float radius) {
+    int hit;
+    return QueryRectGridCircle(&obstacleIndex, center, radius, &hit, 1) > 0;
+}
+
+// Pushes a circle out of any rock it overlaps, so movers slide along the edges
+static void SlideAlongObstacles(Vector2 *pos, float radius) {
+    int hits[MAX_OBSTACLE_HITS];
+    int count = QueryRectGridCircle(&obstacleIndex, *pos, radius, hits, MAX_OBSTACLE_HITS);
+    for (int k = 0; k < count; k++) {
+        Rectangle r = obstacleIndex.rects[hits[k]];
+        Vector2 nearest = { Clamp(pos->x, r.x, r.x + r.width), Clamp(pos->y, r.y, r.y + r.height) };
+        Vector2 away = Vector2Subtract(*pos, nearest);
+        float dist = Vector2Length(away);
+        if (dist > 0.0f) {
+            if (dist < radius) *pos = Vector2Add(nearest, Vector2Scale(away, radius / dist));
+        } else {
+            // Centre ended up inside the rock, leave through the closest edge
+            float left = pos->x - r.x;
+            float right = r.x + r.width - pos->x;
+            float top = pos->y - r.y;
+            float bottom = r.y + r.height - pos->y;
+            float nearestEdge = fminf(fminf(left, right), fminf(top, bottom));
+            if (nearestEdge == left) pos->x = r.x - radius;
+            else if (nearestEdge == right) pos->x = r.x + r.width + radius;
+            else if (nearestEdge == top) pos->y = r.y - radius;
+            else pos->y = r.y + r.height + radius;
+        }
+    }
 }
 
-static void SpawnEnemy(Difficulty difficulty) {
-    int screenWidth  = GetScreenWidth();
-    int screenHeight = GetScreenHeight();
+// Snapshot of the active enemies the hash was built from this frame
+static Vector2 hashedPositions[MAX_ENEMIES];
+static int hashedIds[MAX_ENEMIES];
+static int hashedCount = 0;
 
+// Once per frame before anything queries enemies by area
+static void RebuildEnemyHash(void) {
+    hashedCount = 0;
     for (int i = 0; i < MAX_ENEMIES; i++) {
-        if (!enemies[i].active) {
-            int side = GetRandomValue(0, 3);
-            Vector2 pos;
-            switch (side) {
-                case 0: pos = (Vector2){0, GetRandomValue(0, screenHeight)}; break;
-                case 1: pos = (Vector2){screenWidth, GetRandomValue(0, screenHeight)}; break;
-                case 2: pos = (Vector2){GetRandomValue(0, screenWidth), 0}; break;
-                default: pos = (Vector2){GetRandomValue(0, screenWidth), screenHeight}; break;
-            }
+        if (sim.enemies[i].active) {
+            hashedPositions[hashedCount] = sim.enemies[i].position;
+            hashedIds[hashedCount] = i;
+            hashedCount++;
+        }
+    }
+    BuildSpatialHash(&enemyHash, hashedPositions, hashedIds, hashedCount);
+}
+
+// Active bullets packed once per step so each enemy tests them in one batch
+static Vector2 bulletCenters[MAX_BULLETS];
+static float bulletRadii[MAX_BULLETS];
+static int bulletIds[MAX_BULLETS];
+static unsigned char bulletHits[MAX_BULLETS];
+
+static int GatherBullets(void) {
+    int count = 0;
+    for (int j = 0; j < MAX_BULLETS; j++) {
+        if (sim.bullets[j].active) {
+            bulletCenters[count] = sim.bullets[j].position;
+            bulletRadii[count] = 5.0f;
+            bulletIds[count] = j;
+            count++;
+        }
+    }
+    return count;
+}
 
-            float baseSpeed = 50.0f;
-            float speed = baseSpeed;
-            if (difficulty == DIFFICULTY_MEDIUM) speed = baseSpeed * 1.7f;
-            if (difficulty == DIFFICULTY_HARD)   speed = baseSpeed * 2.0f;
+// Shared area-of-effect query: kills every enemy whose body touches the circle,
+// visiting only the hash cells the circle overlaps. Returns the number killed.
+static int KillEnemiesInRadius(Vector2 center, float radius) {
+    static int hits[MAX_ENEMIES];
+    int found = QuerySpatialHash(&enemyHash, center, radius + 20, hits, MAX_ENEMIES);
+    int killed = 0;
+    for (int k = 0; k < found; k++) {
+        if (sim.enemies[hits[k]].active) {
+            sim.enemies[hits[k]].active = false;
+            EmitEnemyDeath(&sim.enemies[hits[k]]);
+            killed++;
+        }
+    }
+    return killed;
+}
 
-            int type = 0;
-            if (gameTimer > 20.0f) {
-                type = GetRandomValue(0, 2);
-            } else if (gameTimer > 10.0f) {
-                type = GetRandomValue(0, 1);
+// Boid-style separation: each enemy is pushed away from the neighbours within
+// SEPARATION_RADIUS, found through the spatial hash rather than by testing all pairs
+static void SeparateEnemies(float dt) {
+    static Vector2 pushes[MAX_ENEMIES];
+    const Vector2 *positions = hashedPositions;
+    const int *ids = hashedIds;
+    int count = hashedCount;
+
+    BeginProfileZone(&separationZone);
+    ResetProfileHistogram(&neighbourHistogram);
+    for (int n = 0; n < count; n++) {
+        pushes[n] = (Vector2){0, 0};
+        if (!sim.enemies[ids[n]].active) continue;
+
+        int neighbours[MAX_NEIGHBOURS];
+        int found = QuerySpatialHash(&enemyHash, positions[n], SEPARATION_RADIUS, neighbours, MAX_NEIGHBOURS);
+        Vector2 push = {0, 0};
+        int others = found;     // a full result list may have cut off the enemy itself
+        for (int k = 0; k < found; k++) {
+            int j = neighbours[k];
+            if (j == ids[n]) others--;
+            if (j == ids[n] || !sim.enemies[j].active) continue;
+            Vector2 away = Vector2Subtract(positions[n], sim.enemies[j].position);
+            float dist = Vector2Length(away);
+            if (dist > 0.0f) {
+                push = Vector2Add(push, Vector2Scale(away, (SEPARATION_RADIUS - dist) / (SEPARATION_RADIUS * dist)));
             } else {
-                type = 0;
+                // Exactly stacked, split them along an angle derived from the slot
+                float angle = ids[n] * 2.39996f;
+                push = Vector2Add(push, (Vector2){cosf(angle), sinf(angle)});
             }
+        }
+        pushes[n] = push;
+        AddProfileSample(&neighbourHistogram, others);
+    }
 
-            enemies[i].position = pos;
-            enemies[i].speed = speed;
-            enemies[i].velocity = Vector2Scale(Vector2Normalize(Vector2Subtract(playerPos, pos)), speed);
-            enemies[i].active = true;
-            enemies[i].type = type;
-            enemies[i].health = (type == 0) ? 1 : (type == 1) ? 2 : 3;
-            break;
+    // Applied after all queries so the result does not depend on slot order
+    for (int n = 0; n < count; n++) {
+        Vector2 *pos = &sim.enemies[ids[n]].position;
+        *pos = Vector2Add(*pos, Vector2Scale(pushes[n], SEPARATION_STRENGTH * dt));
+    }
+    EndProfileZone(&separationZone);
+}
+
+// Draws count concentric rings as a single quad through the shockwave shader,
+// falling back to line circles if the shader did not compile
+static void DrawShockwave(Vector2 center, float radius, float spacing, int count, Color color) {
+    if (shockwaveShader.id == 0 || shockwaveShader.id == rlGetShaderIdDefault()) {
+        for (int i = 0; i < count; i++) {
+            DrawCircleLines((int)center.x, (int)center.y, radius - i * spacing, color);
         }
+        return;
     }
+
+    float thickness = 1.5f;
+    float half = radius + thickness * 2.0f;
+    Vector2 size = { half * 2.0f, half * 2.0f };
+    float ringCount = (float)count;
+    Vector4 ringColor = ColorNormalize(color);
+    SetShaderValue(shockwaveShader, shockwaveSizeLoc, &size, SHADER_UNIFORM_VEC2);
+    SetShaderValue(shockwaveShader, shockwaveRadiusLoc, &radius, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shockwaveShader, shockwaveSpacingLoc, &spacing, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shockwaveShader, shockwaveCountLoc, &ringCount, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shockwaveShader, shockwaveThicknessLoc, &thickness, SHADER_UNIFORM_FLOAT);
+    SetShaderValue(shockwaveShader, shockwaveColorLoc, &ringColor, SHADER_UNIFORM_VEC4);
+
+    // The 1x1 default texture gives the quad 0..1 texture coordinates
+    Texture2D quadTex = { rlGetTextureIdDefault(), 1, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    BeginShaderMode(shockwaveShader);
+        DrawTexturePro(quadTex, (Rectangle){0, 0, 1, 1},
+                       (Rectangle){center.x - half, center.y - half, size.x, size.y},
+                       (Vector2){0, 0}, 0.0f, WHITE);
+    EndShaderMode();
 }
 
-static void SpawnObstacles(void) {
-    for (int i = 0; i < MAX_OBSTACLES; i++) {
-        if (!obstacles[i].active) {
-            float w = (float)obstacleTex.width;
-            float h = (float)obstacleTex.height;
-            
-            // Ensure obstacles don't spawn on player's starting position
-            bool tooCloseToPlayer;
-            Rectangle obsRect;
-            do {
-                float x = (float)GetRandomValue(100, GetScreenWidth()  - (int)w);
-                float y = (float)GetRandomValue(100, GetScreenHeight() - (int)h);
-                obsRect = (Rectangle){x, y, w, h};
-                
-                Rectangle playerSafeZone = {
-                    playerPos.x - w - 50, 
-                    playerPos.y - h - 50, 
-                    w + 100, 
-                    h + 100
-                };
-                tooCloseToPlayer = CheckCollisionRecs(obsRect, playerSafeZone);
-            } while (tooCloseToPlayer);
-
-            bool overlap;
-            do {
-                overlap = false;
-                for (int j = 0; j < i; j++) {
-                    if (obstacles[j].active && CheckCollisionRecs(obstacles[j].rect, obsRect)) {
-                        overlap = true;
-                        float x = (float)GetRandomValue(100, GetScreenWidth()  - (int)w);
-                        float y = (float)GetRandomValue(100, GetScreenHeight() - (int)h);
-                        obsRect = (Rectangle){x, y, w, h};
-                        break;
-                    }
-                }
-            } while (overlap);
+static void DrawPacingGraph(int x, int y) {
+    const FramePacer *pacer = &framePacer;
+    FramePacerStats stats = GetFramePacerStats(pacer);
+    float budgetMs = (pacer->interval > 0.0) ? (float)(pacer->interval * 1000.0) : stats.meanMs;
+    float scale = (budgetMs > 0.0f) ? PACER_GRAPH_HEIGHT / (2.0f * budgetMs) : 0.0f;
+    int frames = (pacer->count < PACER_GRAPH_FRAMES) ? pacer->count : PACER_GRAPH_FRAMES;
+
+    DrawRectangle(x, y, PACER_GRAPH_FRAMES, PACER_GRAPH_HEIGHT, Fade(DARKGRAY, 0.5f));
+    for (int i = 0; i < frames; i++) {
+        // Oldest on the left, newest on the right
+        float ms = pacer->frameMs[(pacer->head - frames + i + PACER_HISTORY) % PACER_HISTORY];
+        int height = (int)fminf(ms * scale, PACER_GRAPH_HEIGHT);
+        DrawRectangle(x + PACER_GRAPH_FRAMES - frames + i, y + PACER_GRAPH_HEIGHT - height, 1, height,
+                      (ms > 1.5f * budgetMs) ? RED : LIME);
+    }
+    DrawLine(x, y + PACER_GRAPH_HEIGHT / 2, x + PACER_GRAPH_FRAMES, y + PACER_GRAPH_HEIGHT / 2, Fade(WHITE, 0.5f));
+}
+
+#ifdef RLGL_BATCH_STATS
+static void CountBatchFlush(int cause, int drawCalls, int vertexCount) {
+    if (flushCauseOverride >= 0) cause = flushCauseOverride;
+    batchCounting.flushes++;
+    batchCounting.drawCalls += drawCalls;
+    batchCounting.vertices += vertexCount;
+    batchCounting.byCause[cause]++;
+}
+#endif
+
+// BeginTextureMode/EndTextureMode flush inside raylib as an explicit flush like
+// the end of a frame does; flushing first here gets them their own cause
+static void FlushBatchForTarget(void) {
+#ifdef RLGL_BATCH_STATS
+    flushCauseOverride = FLUSH_TARGET;
+    rlDrawRenderBatchActive();
+    flushCauseOverride = -1;
+#endif
+}
+
+// Called once after EndDrawing, which made the frame's last flush
+static void FinishBatchFrame(void) {
+#ifdef RLGL_BATCH_STATS
+    batchStats = batchCounting;
+    batchCounting = (BatchStats){0};
+#endif
+}
+
+#ifdef RLGL_BATCH_STATS
+// Last frame's flushes, draw calls and vertices, then the flushes by cause
+static void DrawBatchLines(int x, int y) {
+    DrawText(TextFormat("batch %d flushes  %d draws  %d verts", batchStats.flushes, batchStats.drawCalls, batchStats.vertices),
+             x, y, 10, WHITE);
+    char causes[128] = "";
+    int length = 0;
+    for (int i = 0; i < FLUSH_CAUSE_COUNT && length < (int)sizeof(causes); i++) {
+        if (batchStats.byCause[i] == 0) continue;
+        length += snprintf(causes + length, sizeof(causes) - length, "%s %d  ", flushCauseNames[i], batchStats.byCause[i]);
+    }
+    bool limited = batchStats.byCause[RL_FLUSH_DRAW_LIMIT] > 0 || batchStats.byCause[RL_FLUSH_VERTEX_LIMIT] > 0;
+    DrawText(causes, x, y + 14, 10, limited ? ORANGE : LIGHTGRAY);
+}
+#endif
+
+// Resident scene memory against the budget, and sets still loading
+static void DrawAssetLine(int x, int y) {
+    int loading = 0;
+    for (int i = 0; i < SCENE_ASSET_SETS; i++) {
+        if (sceneAssets[i]->held && !AssetSetResident(sceneAssets[i])) loading++;
+    }
+    const float mb = 1024.0f * 1024.0f;
+    DrawText(TextFormat("assets %.1f/%.0f MB  cached %.1f  loading %d", assetLoader.residentBytes / mb,
+                        assetLoader.budget / mb, AssetCachedBytes(&assetLoader) / mb, loading),
+             x, y, 10, assetLoader.overBudget ? RED : (loading > 0) ? ORANGE : WHITE);
+}
+
+static void DrawProfilerOverlay(void) {
+    int x = GetScreenWidth() - 230;
+    int y = 10;
+    const ProfileHistogram *h = &neighbourHistogram;
+    FramePacerStats pacing = GetFramePacerStats(&framePacer);
+
+    int lines = 4;
+#ifdef RLGL_BATCH_STATS
+    lines += 2;
+#endif
+
+    DrawRectangle(x - 10, y - 5, 230, 50 + lines * 14 + PACER_GRAPH_HEIGHT + 6 + PROFILER_BINS * 10, Fade(BLACK, 0.6f));
+    DrawText(TextFormat("FPS: %d  frame: %.2f ms", GetFPS(), GetFrameTime() * 1000.0f), x, y, 10, WHITE);
+    y += 14;
+    DrawText(TextFormat("Pace: %s %.0f Hz  spin %.2f ms", PaceModeName(framePacer.mode),
+                        framePacer.interval > 0.0 ? 1.0 / framePacer.interval : 0.0, framePacer.spinMs), x, y, 10, WHITE);
+    y += 14;
+    DrawText(TextFormat("avg %.2f  jitter %.3f  p99 %.2f", pacing.meanMs, pacing.jitterMs, pacing.p99Ms), x, y, 10, WHITE);
+    y += 14;
+    DrawText(TextFormat("max %.2f ms  late %d/%d", pacing.maxMs, pacing.late, pacing.samples), x, y, 10, (pacing.late > 0) ? ORANGE : WHITE);
+    y += 14;
+    DrawPacingGraph(x, y);
+    y += PACER_GRAPH_HEIGHT + 6;
+    DrawAssetLine(x, y);
+    y += 14;
+#ifdef RLGL_BATCH_STATS
+    DrawBatchLines(x, y);
+    y += 2 * 14;
+#endif
+    DrawText(TextFormat("%s: %.3f ms", separationZone.name, separationZone.smoothedMs), x, y, 10, WHITE);
+    y += 14;
+    DrawText(TextFormat("%s: avg %.2f max %d", h->name, h->samples ? (float)h->sum / h->samples : 0.0f, h->max), x, y, 10, WHITE);
+    y += 14;
+    for (int b = 0; b < PROFILER_BINS; b++) {
+        int width = h->samples ? 150 * h->bins[b] / h->samples : 0;
+        DrawText(TextFormat((b == PROFILER_BINS - 1) ? "%d+" : "%d", b), x, y, 10, LIGHTGRAY);
+        DrawRectangle(x + 25, y + 1, width, 8, SKYBLUE);
+        DrawText(TextFormat("%d", h->bins[b]), x + 30 + width, y, 10, LIGHTGRAY);
+        y += 10;
+    }
+}
+
+// A guess must be in the allowed list or be a possible answer. Without
+// words.txt there is nothing to check against, so any five letters go.
+static bool IsAllowedGuess(const char *guess) {
+    if (wordleAllowed.count == 0) return true;  // words.txt missing
+    WordKey key = PackWord(guess);
+    return WordListContains(&wordleAllowed, key) || WordListContains(&wordleAnswers, key);
+}
 
-            obstacles[i].rect = obsRect;
-            obstacles[i].active = true;
+// Narrows the answer list with the feedback so far and scores the allowed
+// words. It runs inside a sim step, rollback re-simulation included, so the
+// work is capped rather than left to grow with the candidates.
+static void ComputeWordleHint(void) {
+    WordKey keys[MAX_GUESSES];
+    int patterns[MAX_GUESSES];
+    for (int row = 0; row < sim.currentGuess; row++) {
+        keys[row] = PackWord(sim.guesses[row]);
+        patterns[row] = 0;
+        for (int i = 0; i < WORD_LENGTH; i++) {
+            if (ColorsEqual(sim.guessColors[row][i], GREEN)) patterns[row] |= 2 << (2 * i);
+            else if (ColorsEqual(sim.guessColors[row][i], YELLOW)) patterns[row] |= 1 << (2 * i);
         }
     }
+
+    sim.wordleHint = (WordleHint){0};
+    sim.wordleHintShown = true;
+    if (wordleAnswers.count == 0) return;
+    WordKey *candidates = malloc(sizeof(WordKey) * wordleAnswers.count);
+    if (candidates == NULL) return;
+
+    double start = ProfilerTime();
+    int count = FilterWordleCandidates(&wordleAnswers, keys, patterns, sim.currentGuess, candidates);
+    sim.wordleHint = SuggestWordleGuess(&wordleAllowed, candidates, count, WORDLE_HINT_MAX_PAIRS, 0);
+    wordleHintTime = ProfilerTime() - start;
+    free(candidates);
 }
 
-static void ShootBullet(void) {
-    if (thunderstoneEffectActive) {
+static void ShootBullet(Vector2 from) {
+    if (sim.thunderstoneEffectActive) {
         float speed = 400.0f;
         float diagSpeed = speed / sqrtf(2.0f);
         Vector2 directions[] = {
@@ -402,1453 +1216,2284 @@ static void ShootBullet(void) {
         
         for (int d = 0; d < 8; d++) {
             for (int i = 0; i < MAX_BULLETS; i++) {
-                if (!bullets[i].active) {
-                    bullets[i].position = playerPos;
-                    bullets[i].velocity = directions[d];
-                    bullets[i].active = true;
+                if (!sim.bullets[i].active) {
+                    sim.bullets[i].position = from;
+                    sim.bullets[i].previous = from;
+                    sim.bullets[i].velocity = directions[d];
+                    sim.bullets[i].active = true;
                     break;
                 }
             }
         }
     } else {
         for (int i = 0; i < MAX_BULLETS; i++) {
-            if (!bullets[i].active) {
-                bullets[i].position = playerPos;
-                bullets[i].velocity = (Vector2){0, -400};
-                bullets[i].active = true;
+            if (!sim.bullets[i].active) {
+                sim.bullets[i].position = from;
+                sim.bullets[i].previous = from;
+                sim.bullets[i].velocity = (Vector2){0, -400};
+                sim.bullets[i].active = true;
                 break;
             }
         }
     }
 }
 
+// Racks pinRackRows rows of pins plus the ball into an empty world. The
+// pit behind the rack and a margin below the screen (where the throw path
+// starts) bound the world.
 static void LayoutPins(void) {
-    const float cx = GetScreenWidth() / 2.0f;
-    const float topY = 120.0f;
-    const float spacing = 35.0f;
-
-    int idx = 0;
-    for (int row = 0; row < 4; row++) {
-        for (int i = 0; i <= row; i++) {
-            if (idx < NUM_PINS) {
-                pins[idx].position.x = cx + (i - row / 2.0f) * spacing;
-                pins[idx].position.y = topY + row * spacing;
-                pins[idx].fallen = false;
-                pins[idx].animating = false;
-                pins[idx].velocity = (Vector2){0, 0};
-                pins[idx].rotation = 0;
-                idx++;
-            }
-        }
-    }
+    RackBowlingPins(&sim.bowl, &pinWorld, (Vector2){ GetScreenWidth() / 2.0f, 120.0f }, sim.pinRackRows, sim.ballPos);
+    pinWorld.bounds = (Rectangle){ LANE_LEFT, 60.0f, LANE_RIGHT - LANE_LEFT, GetScreenHeight() + 40.0f };
+    sim.settleTimer = 0.0f;
 }
 
 static void ResetMiniGame(Difficulty difficulty) {
+    ClearParticles(&particles);
     if (difficulty == DIFFICULTY_EASY) {
-        // Reset falling balls
-        basketX = GetScreenWidth() / 2.0f - 75;
-        basketY = GetScreenHeight() - 80;
-        basketWidth = 150;
-        basketHeight = 30;
-        basketSideHeight = 50;
-        ballScore = 0;
-        misses = 0;
-        for (int i = 0; i < MAX_BALLS; i++) {
-            balls[i].position.x = (float)GetRandomValue(BALLS_RADIUS, GetScreenWidth() - BALLS_RADIUS);
-            balls[i].position.y = (float)GetRandomValue(-600, 0);
-            balls[i].color = (Color){ (unsigned char)GetRandomValue(50,255), (unsigned char)GetRandomValue(50,255), (unsigned char)GetRandomValue(50,255), 255 };
-            balls[i].active = true;
-        }
+        // Reset falling balls; at least two stay in the air
+        sim.basketHeight = 30;
+        sim.basketSideHeight = 50;
+        ResetBallRain(&ballRain, 2, (unsigned int)SimRandom(1, 0x7fffffff));
     } else if (difficulty == DIFFICULTY_MEDIUM) {
         // Reset wordle
-        int wordIndex = GetRandomValue(0, NUM_WORDS - 1);
-        strcpy(targetWord, wordList[wordIndex]);
-        memset(guesses, 0, sizeof(guesses));
-        memset(guessColors, 0, sizeof(guessColors));
-        currentGuess = 0;
-        currentLetter = 0;
-        wordleWon = false;
+        if (wordleAnswers.count > 0) {
+            UnpackWord(wordleAnswers.keys[SimRandom(0, wordleAnswers.count - 1)], sim.targetWord);
+        } else {
+            int wordIndex = SimRandom(0, NUM_WORDS - 1);
+            strcpy(sim.targetWord, wordList[wordIndex]);
+        }
+        sim.wordleNoticeTimer = 0.0f;
+        sim.wordleHintShown = false;
+        memset(sim.guesses, 0, sizeof(sim.guesses));
+        memset(sim.guessColors, 0, sizeof(sim.guessColors));
+        sim.currentGuess = 0;
+        sim.currentLetter = 0;
+        sim.wordleWon = false;
     } else {
         // Reset bowling
-        ballPos = (Vector2){ GetScreenWidth()/2.0f, GetScreenHeight() - 80.0f };
-        t = 0.0f;
-        throwAngle = 0.0f;
-        ballLaunched = false;
-        power = 0.0f;
-        charging = false;
-        strikeMode = false;
-        luckyStrike = false;
+        sim.ballPos = (Vector2){ GetScreenWidth()/2.0f, GetScreenHeight() - 80.0f };
+        sim.throwAngle = 0.0f;
+        sim.bowl.launched = false;
+        sim.power = 0.0f;
+        sim.charging = false;
         LayoutPins();
     }
 }
 
-// ------------ Main ------------
-int main(void) {
-    const int screenWidth = 800;
-    const int screenHeight = 600;
+// ------------ Fixed timestep ------------
+// Collects this frame's presses, releases, typed characters and clicks. They
+// stay latched until a sim step has seen them, so a frame that runs no step
+// loses nothing and a frame that runs several acts on them once.
+static void LatchInput(void) {
+    int key;
+    while ((key = GetKeyPressed()) > 0) {
+        if (key < SIM_MAX_KEYS) simKeysPressed[key] = true;
+    }
+    for (int k = 0; k < SIM_MAX_KEYS; k++) {
+        if (IsKeyReleased(k)) simKeysReleased[k] = true;
+    }
+    while ((key = GetCharPressed()) > 0) {
+        if (simCharCount < SIM_MAX_CHARS) simChars[simCharCount++] = key;
+    }
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+        simClick = true;
+        simClickPos = GetMousePosition();
+    }
+}
 
-    SetConfigFlags(FLAG_WINDOW_RESIZABLE);
-    InitWindow(screenWidth, screenHeight, "Capture or Escape");
-    InitAudioDevice();
-    SetTargetFPS(60);
+static void ClearLatchedInput(void) {
+    memset(simKeysPressed, 0, sizeof(simKeysPressed));
+    memset(simKeysReleased, 0, sizeof(simKeysReleased));
+    simCharCount = 0;
+    simCharRead = 0;
+    simClick = false;
+}
 
-    // --- Load assets ---
-    if (!FileExists("resources/logo.png")) TraceLog(LOG_WARNING, "logo.png missing!");
-    logo = LoadTexture("resources/logo.png");
+static bool SimKeyPressed(int key) {
+    return key >= 0 && key < SIM_MAX_KEYS && simKeysPressed[key];
+}
 
-    if (!FileExists("resources/home.png")) TraceLog(LOG_WARNING, "home.png missing!");
-    homeBg = LoadTexture("resources/home.png");
+static bool SimKeyReleased(int key) {
+    return key >= 0 && key < SIM_MAX_KEYS && simKeysReleased[key];
+}
 
-    if (!FileExists("resources/emoji_font.ttf")) TraceLog(LOG_WARNING, "emoji_font.ttf missing! Using default.");
-    emojiFont = LoadFont("resources/emoji_font.ttf");
-    if (emojiFont.texture.id == 0) emojiFont = GetFontDefault();
+// Same contract as GetCharPressed: next queued character, 0 when empty
+static int SimCharPressed(void) {
+    return (simCharRead < simCharCount) ? simChars[simCharRead++] : 0;
+}
 
-    if (!FileExists("resources/pikachu.png")) TraceLog(LOG_WARNING, "pikachu.png missing!");
-    pikachuTex = LoadTexture("resources/pikachu.png");
+static bool SimClicked(Rectangle rect) {
+    return simClick && CheckCollisionPointRec(simClickPos, rect);
+}
 
-    if (!FileExists("resources/raichu.png")) TraceLog(LOG_WARNING, "raichu.png missing!");
-    raichuTex = LoadTexture("resources/raichu.png");
+// The keyboard as one step's buttons
+static RollbackInput LocalPlayerInput(void) {
+    RollbackInput input = 0;
+    if (IsKeyDown(KEY_LEFT))  input |= INPUT_LEFT;
+    if (IsKeyDown(KEY_RIGHT)) input |= INPUT_RIGHT;
+    if (IsKeyDown(KEY_UP))    input |= INPUT_UP;
+    if (IsKeyDown(KEY_DOWN))  input |= INPUT_DOWN;
+    if (SimKeyPressed(KEY_SPACE)) input |= INPUT_SHOOT;
+    if (SimKeyPressed(KEY_S)) input |= INPUT_ELIXIR;
+    if (SimKeyPressed(KEY_R)) input |= INPUT_RESTART;
+    return input;
+}
 
-    if (!FileExists("resources/pokeball.png")) TraceLog(LOG_WARNING, "pokeball.png missing!");
-    pokeballTex = LoadTexture("resources/pokeball.png");
+// Remembers where things are before a step so drawing can blend toward the next one
+static void SnapshotPositions(void) {
+    prevPlayerPos = sim.playerPos;
+    prevPartnerPos = sim.partnerPos;
+    prevBallPos = sim.ballPos;
+    for (int i = 0; i < MAX_BULLETS; i++) sim.bullets[i].previous = sim.bullets[i].position;
+    for (int i = 0; i < MAX_ENEMIES; i++) sim.enemies[i].previous = sim.enemies[i].position;
+}
 
-    if (!FileExists("resources/ultra_ball.png")) TraceLog(LOG_WARNING, "ultra_ball.png missing!");
-    ultraBallTex = LoadTexture("resources/ultra_ball.png");
+static Vector2 InterpolatePosition(Vector2 previous, Vector2 current, float alpha) {
+    if (Vector2DistanceSqr(previous, current) > SIM_SNAP_DISTANCE * SIM_SNAP_DISTANCE) return current;
+    return Vector2Lerp(previous, current, alpha);
+}
 
-    if (!FileExists("resources/master_ball.png")) TraceLog(LOG_WARNING, "master_ball.png missing!");
-    masterBallTex = LoadTexture("resources/master_ball.png");
+static void LayoutMenuButtons(void) {
+    easyBtn = (Rectangle){ GetScreenWidth()/2 - 100, 250, 200, 50 };
+    mediumBtn = (Rectangle){ GetScreenWidth()/2 - 100, 320, 200, 50 };
+    hardBtn = (Rectangle){ GetScreenWidth()/2 - 100, 390, 200, 50 };
+    startBtn = (Rectangle){ GetScreenWidth()/2 - 100, 460, 200, 50 };
+}
 
-    if (!FileExists("resources/balh.png")) TraceLog(LOG_WARNING, "balh.png missing!");
-    balhTex = LoadTexture("resources/balh.png");
+// ------------ Frame pacing ------------
+static double MonitorRefreshInterval(void) {
+    int hz = GetMonitorRefreshRate(GetCurrentMonitor());
+    return 1.0 / ((hz > 0) ? hz : 60);
+}
 
-    if (!FileExists("resources/aoi.png")) TraceLog(LOG_WARNING, "aoi.png missing!");
-    aoiTex = LoadTexture("resources/aoi.png");
+// Vsync is the swap interval; the other modes pace after the swap in framePacer
+static void ApplyPaceMode(PaceMode mode) {
+    if (mode == PACE_VSYNC) SetWindowState(FLAG_VSYNC_HINT);
+    else ClearWindowState(FLAG_VSYNC_HINT);
 
-    // Load difficulty backgrounds
-    if (!FileExists("resources/easy.png")) TraceLog(LOG_WARNING, "easy.png missing!");
-    easyBg = LoadTexture("resources/easy.png");
-    
-    if (!FileExists("resources/medium.png")) TraceLog(LOG_WARNING, "medium.png missing!");
-    mediumBg = LoadTexture("resources/medium.png");
-    
-    if (!FileExists("resources/hard.png")) TraceLog(LOG_WARNING, "hard.png missing!");
-    hardBg = LoadTexture("resources/hard.png");
+    double interval = 0.0;
+    if (mode == PACE_FIXED) interval = 1.0 / frameCaps[frameCapIndex];
+    if (mode == PACE_ADAPTIVE) interval = MonitorRefreshInterval();
+    SetFramePacerMode(&framePacer, mode, interval);
+}
 
-    if (!FileExists("resources/Rock.png")) TraceLog(LOG_WARNING, "Rock.png missing!");
-    Image rockImg = LoadImage("resources/Rock.png");
-    if (rockImg.data != NULL) {
-        ImageResize(&rockImg, rockImg.width / 3, rockImg.height / 3);
-        obstacleTex = LoadTextureFromImage(rockImg);
-        UnloadImage(rockImg);
+// ------------ Asset residency ------------
+// Holds the sets of every scene still reachable from the current state, which
+// prefetches them on the loader's worker, and releases the rest. The current
+// scene's own sets are then finished, so nothing draws its fallback while a
+// file is still loading. The revive mini-game stays reachable until the run's
+// second chance is spent; a replay makes it reachable again.
+static void UpdateAssetResidency(void) {
+    GameState s = sim.gameState;
+    bool inRun = s != OPENING_SCENE;
+    bool miniGameReachable = s == REVIVE_PROMPT || s == MINI_GAME ||
+                             ((s == DIFFICULTY_TRANSITION || s == GAMEPLAY) && !sim.secondChanceUsed);
+
+    bool wanted[SCENE_ASSET_SETS] = {
+        s == OPENING_SCENE || s == CLOSING_SCENE, s == OPENING_SCENE || s == DIFFICULTY_TRANSITION, inRun,
+        inRun && sim.selectedDifficulty == DIFFICULTY_EASY, inRun && sim.selectedDifficulty == DIFFICULTY_MEDIUM,
+        inRun && sim.selectedDifficulty == DIFFICULTY_HARD,
+        miniGameReachable && sim.selectedDifficulty == DIFFICULTY_EASY, miniGameReachable && sim.selectedDifficulty == DIFFICULTY_MEDIUM,
+        miniGameReachable && sim.selectedDifficulty == DIFFICULTY_HARD
+    };
+    // Take the new references before dropping old ones, so shared assets stay put
+    for (int i = 0; i < SCENE_ASSET_SETS; i++) if (wanted[i]) HoldAssetSet(&assetLoader, sceneAssets[i], true, true);
+    for (int i = 0; i < SCENE_ASSET_SETS; i++) if (!wanted[i]) HoldAssetSet(&assetLoader, sceneAssets[i], false, true);
+    UpdateAssetLoader(&assetLoader);
+
+    switch (s) {
+        case OPENING_SCENE: FinishAssetSet(&assetLoader, &menuAssets); break;
+        case DIFFICULTY_TRANSITION: FinishAssetSet(&assetLoader, &transitionAssets); break;
+        case GAMEPLAY:
+        case REVIVE_PROMPT:
+            FinishAssetSet(&assetLoader, &runAssets);
+            FinishAssetSet(&assetLoader, &difficultyAssets[sim.selectedDifficulty]);
+            break;
+        case MINI_GAME: FinishAssetSet(&assetLoader, &miniGameAssets[sim.selectedDifficulty]); break;
+        case CLOSING_SCENE: FinishAssetSet(&assetLoader, &runAssets); break;
     }
+}
 
-    if (!FileExists("resources/elixir.png")) TraceLog(LOG_WARNING, "elixir.png missing! A fallback circle will be drawn.");
-    elixirTex = LoadTexture("resources/elixir.png");
+// F6: every resident asset, then what each held scene set costs. An asset
+// shared by several sets counts toward each of them.
+static void LogSceneAssets(void) {
+    LogAssetMemory(&assetLoader);
+    for (int i = 0; i < SCENE_ASSET_SETS; i++) {
+        if (!sceneAssets[i]->held) continue;
+        TraceLog(LOG_INFO, "ASSETS: set %-13s %8.1f KB%s", sceneAssets[i]->name, AssetSetBytes(sceneAssets[i]) / 1024.0f,
+                 AssetSetResident(sceneAssets[i]) ? "" : "  loading");
+    }
+}
 
-    if (!FileExists("resources/thunderstone.png")) TraceLog(LOG_WARNING, "thunderstone.png missing! A fallback circle will be drawn.");
-    thunderstoneTex = LoadTexture("resources/thunderstone.png");
+// Full-screen textures need no more pixels than the largest monitor has
+static void SetScreenAssetSize(void) {
+    int width = 0, height = 0;
+    for (int m = 0; m < GetMonitorCount(); m++) {
+        width = (GetMonitorWidth(m) > width) ? GetMonitorWidth(m) : width;
+        height = (GetMonitorHeight(m) > height) ? GetMonitorHeight(m) : height;
+    }
+    for (int i = 0; i < (int)(sizeof(screenAssets) / sizeof(screenAssets[0])); i++) {
+        screenAssets[i]->maxWidth = width;
+        screenAssets[i]->maxHeight = height;
+    }
+}
 
-    if (!FileExists("resources/speed.png")) TraceLog(LOG_WARNING, "speed.png missing! A fallback circle will be drawn.");
-    speedTex = LoadTexture("resources/speed.png");
+// ------------ Save state ------------
+// A snapshot is the sim block plus the systems that keep their state on the
+// heap. Particles are cosmetic and left out; the rock index and the enemy
+// hash are rebuilt from the block. F7 quick-saves to disk, F8 resumes.
+#define GAME_STATE_VERSION 5          // bump whenever SimState or SerializeGame changes
+#define QUICKSAVE_FILE "quicksave.bin"
+
+SnapshotStream stateSnapshot = {0};
+
+// Pointers are written as NULL so equal states give equal snapshots. They,
+// the capacity and the drive hook belong to this process; the rest round-trips.
+static void SerializeRigidWorld(SnapshotStream *stream, RigidWorld *world) {
+    RigidWorld saved;
+    memcpy(&saved, world, sizeof(saved));
+    saved.bodies = NULL;
+    saved.order = NULL;
+    saved.drive = NULL;
+    saved.driveData = NULL;
+    SnapshotBytes(stream, &saved, sizeof(saved));
+    if (stream->reading) {
+        if (stream->failed) return;
+        if (saved.count < 0 || saved.count > world->capacity) {
+            stream->failed = true;
+            return;
+        }
+        saved.bodies = world->bodies;
+        saved.order = world->order;
+        saved.capacity = world->capacity;
+        saved.drive = world->drive;
+        saved.driveData = world->driveData;
+        *world = saved;
+    }
+    SnapshotBytes(stream, world->bodies, sizeof(RigidCircle) * world->count);
+    SnapshotBytes(stream, world->order, sizeof(int) * world->count);
+}
 
-    if (!FileExists("resources/power.png")) TraceLog(LOG_WARNING, "power.png missing! A fallback circle will be drawn.");
-    powerTex = LoadTexture("resources/power.png");
+// The column sort is redone from the balls, which gives the same order
+static void SerializeBallRain(SnapshotStream *stream, BallRain *rain) {
+    BallRain saved;
+    memcpy(&saved, rain, sizeof(saved));
+    saved.balls = NULL;
+    saved.columnStart = NULL;
+    saved.order = NULL;
+    SnapshotBytes(stream, &saved, sizeof(saved));
+    if (stream->reading) {
+        if (stream->failed) return;
+        if (saved.capacity != rain->capacity || saved.columns != rain->columns) {
+            stream->failed = true;
+            return;
+        }
+        saved.balls = rain->balls;
+        saved.columnStart = rain->columnStart;
+        saved.order = rain->order;
+        saved.dirty = true;
+        *rain = saved;
+    }
+    SnapshotBytes(stream, rain->balls, sizeof(Ball) * rain->capacity);
+}
 
-    if (!FileExists("resources/normal_lightning_bolt.png")) TraceLog(LOG_WARNING, "normal_lightning_bolt.png missing!");
-    normalBulletTex = LoadTexture("resources/normal_lightning_bolt.png");
+// The published field always; of the rebuild arrays, only the part a rebuild
+// part way through has written, as the rest is left over from older ones and
+// would differ between otherwise equal states. A field of another size is
+// reallocated first.
+static void SerializeFlowField(SnapshotStream *stream, FlowField *field) {
+    FlowField saved;
+    memcpy(&saved, field, sizeof(saved));
+    saved.blocked = NULL;
+    saved.flow = NULL;
+    saved.distance = NULL;
+    saved.nextFlow = NULL;
+    saved.queue = NULL;
+    SnapshotBytes(stream, &saved, sizeof(saved));
+    if (stream->reading) {
+        if (stream->failed) return;
+        if (saved.cols != field->cols || saved.rows != field->rows) {
+            if (saved.cols > 0) LoadFlowField(field, saved.bounds, saved.cellSize);
+            else UnloadFlowField(field);
+            if (saved.cols != field->cols || saved.rows != field->rows) {
+                stream->failed = true;
+                return;
+            }
+        }
+        int cells = saved.cols * saved.rows;
+        if (saved.queueTail < 0 || saved.queueTail > cells || saved.directionCursor < 0 || saved.directionCursor > cells) {
+            stream->failed = true;
+            return;
+        }
+        saved.blocked = field->blocked;
+        saved.flow = field->flow;
+        saved.distance = field->distance;
+        saved.nextFlow = field->nextFlow;
+        saved.queue = field->queue;
+        *field = saved;
+    }
+    int cells = field->cols * field->rows;
+    SnapshotBytes(stream, field->blocked, cells);
+    SnapshotBytes(stream, field->flow, sizeof(Vector2) * cells);
+    if (field->phase != 0) {
+        SnapshotBytes(stream, field->distance, sizeof(int) * cells);
+        SnapshotBytes(stream, field->queue, sizeof(int) * field->queueTail);
+    }
+    if (field->phase == 2) SnapshotBytes(stream, field->nextFlow, sizeof(Vector2) * field->directionCursor);
+}
 
-    if (!FileExists("resources/special_lightning_bolt.png")) TraceLog(LOG_WARNING, "special_lightning_bolt.png missing!");
-    specialBulletTex = LoadTexture("resources/special_lightning_bolt.png");
+// Writes or reads, depending on the stream
+static void SerializeGame(SnapshotStream *stream) {
+    SnapshotBytes(stream, &sim, sizeof(sim));
+    SerializeRigidWorld(stream, &pinWorld);
+    SerializeBallRain(stream, &ballRain);
+    SerializeFlowField(stream, &enemyFlow);
+}
 
-    hitSound = LoadSound("resources/strike.wav");
-    bowlingBg = LoadTexture("resources/background.png");
+// Rocks only change when a run starts, so most restores keep the index
+static void RebuildObstacleIndex(void) {
+    static Rectangle rects[MAX_OBSTACLES];
+    int count = 0;
+    for (int i = 0; i < MAX_OBSTACLES; i++) {
+        if (sim.obstacles[i].active) rects[count++] = sim.obstacles[i].rect;
+    }
+    if (count == obstacleIndex.count && (count == 0 || memcmp(rects, obstacleIndex.rects, sizeof(Rectangle) * count) == 0)) return;
+    BuildRectGrid(&obstacleIndex, rects, count, (count > 0) ? fmaxf(rects[0].width, rects[0].height) : 1.0f);
+}
 
-    if (!FileExists("resources/background3.png")) TraceLog(LOG_WARNING, "background3.png missing!");
-    ballsBg = LoadTexture("resources/background3.png");
+static bool SaveGameState(SnapshotStream *stream) {
+    BeginSnapshotWrite(stream, GAME_STATE_VERSION);
+    SerializeGame(stream);
+    return EndSnapshotWrite(stream);
+}
 
-    if (!FileExists("resources/bg_fruit_bask.png")) TraceLog(LOG_WARNING, "bg_fruit_bask.png missing!");
-    basketTex = LoadTexture("resources/bg_fruit_bask.png");
-    
-    // Load death sound
-    if (!FileExists("resources/dead.mp3")) TraceLog(LOG_WARNING, "dead.mp3 missing!");
-    deadSound = LoadSound("resources/dead.mp3");
-    
-    // Load background music
-    if (!FileExists("resources/bgm.mp3")) TraceLog(LOG_WARNING, "bgm.mp3 missing!");
-    bgm = LoadMusicStream("resources/bgm.mp3");
-    if (bgm.ctxData != NULL) {
-        PlayMusicStream(bgm);
-        musicPlaying = true;
-        SetMusicVolume(bgm, 0.9f);
+// A snapshot from another version is refused before anything is touched
+static bool RestoreGameState(SnapshotStream *stream) {
+    if (!BeginSnapshotRead(stream, GAME_STATE_VERSION)) return false;
+    SerializeGame(stream);
+    if (!EndSnapshotRead(stream)) {
+        TraceLog(LOG_WARNING, "SNAPSHOT: Payload does not match this build's layout");
+        return false;
     }
+    RebuildObstacleIndex();
+    RebuildEnemyHash();
+    return true;
+}
 
-    // Initialize blur shader and render texture for revive prompt
-    blurShader = LoadShaderFromMemory(0, blurShaderCode);
-    int resolutionLoc = GetShaderLocation(blurShader, "resolution");
-    Vector2 resolution = { (float)screenWidth, (float)screenHeight };
-    SetShaderValue(blurShader, resolutionLoc, &resolution, SHADER_UNIFORM_VEC2);
-    reviveTarget = LoadRenderTexture(screenWidth, screenHeight);
+static void QuickSave(void) {
+    if (SaveGameState(&stateSnapshot) && SaveSnapshotFile(&stateSnapshot, QUICKSAVE_FILE)) {
+        TraceLog(LOG_INFO, "SNAPSHOT: Saved %d bytes to %s", (int)stateSnapshot.size, QUICKSAVE_FILE);
+    } else {
+        TraceLog(LOG_WARNING, "SNAPSHOT: Could not save %s", QUICKSAVE_FILE);
+    }
+}
 
-    GameState gameState = OPENING_SCENE;
-    Difficulty selectedDifficulty = DIFFICULTY_MEDIUM;
-    float transitionTimer = 0.0f;
+static void QuickLoad(void) {
+    if (!LoadSnapshotFile(&stateSnapshot, QUICKSAVE_FILE) || !RestoreGameState(&stateSnapshot)) {
+        TraceLog(LOG_WARNING, "SNAPSHOT: Could not resume from %s", QUICKSAVE_FILE);
+        return;
+    }
+    // Nothing blends across the jump, and the restored scene gets its assets
+    SnapshotPositions();
+    simAccumulator = 0.0f;
+    UpdateAssetResidency();
+    TraceLog(LOG_INFO, "SNAPSHOT: Resumed from %s", QUICKSAVE_FILE);
+}
 
-    float gameOverScale = 0.1f;
-    float scaleSpeed = 1.5f;
-    bool animationComplete = false;
-    float enemySpawnTimer = 0.0f;
+// ------------ Game update ------------
+// A fresh run at the given difficulty, as started from the menu. The rocks
+// come later, in EnterRun, once their texture has been prefetched.
+static void StartRun(Difficulty difficulty) {
+    ResetGame(difficulty);
+    sim.elixirSpawnInterval = (difficulty == DIFFICULTY_EASY) ? 8.0f : 
+                         (difficulty == DIFFICULTY_MEDIUM) ? 5.0f : 7.0f;
+    sim.thunderstoneSpawnInterval = (difficulty == DIFFICULTY_EASY) ? 8.0f : 
+                               (difficulty == DIFFICULTY_MEDIUM) ? 10.0f : 12.0f;
+    sim.speedSpawnInterval = (difficulty == DIFFICULTY_EASY) ? 10.0f : 
+                         (difficulty == DIFFICULTY_MEDIUM) ? 12.0f : 15.0f;
+    sim.powerSpawnInterval = (difficulty == DIFFICULTY_EASY) ? 12.0f : 
+                         (difficulty == DIFFICULTY_MEDIUM) ? 15.0f : 18.0f;
+    sim.secondChanceUsed = false;
+}
 
-    ResetMiniGame(selectedDifficulty);
-    ResetElixirState();
-    ResetThunderstoneState();
-    ResetSpeedState();
-    ResetPowerState();
+// End of the difficulty transition: the prefetch has had its 2.5 s
+static void EnterRun(void) {
+    FinishAssetSet(&assetLoader, &runAssets);
+    FinishAssetSet(&assetLoader, &difficultyAssets[sim.selectedDifficulty]);
+    if (sim.selectedDifficulty == DIFFICULTY_HARD) SpawnObstacles();
+    sim.gameState = GAMEPLAY;
+}
 
-    while (!WindowShouldClose()) {
-        float dt = GetFrameTime();
-        
-        if (musicPlaying) {
-            UpdateMusicStream(bgm);
-        }
+// One fixed simulation step of whichever scene is active.
+static void UpdateGame(float dt) {
+    // Co-op steps get both players' buttons from the rollback session
+    if (!sim.coop) stepInput[0] = LocalPlayerInput();
+
+    switch (sim.gameState) {
+        case OPENING_SCENE: {
+            if (SimClicked(easyBtn))
+                sim.selectedDifficulty = DIFFICULTY_EASY;
+            if (SimClicked(mediumBtn))
+                sim.selectedDifficulty = DIFFICULTY_MEDIUM;
+            if (SimClicked(hardBtn))
+                sim.selectedDifficulty = DIFFICULTY_HARD;
+            if (SimClicked(startBtn)) {
+                StartRun(sim.selectedDifficulty);
+                sim.transitionTimer = 0.0f;
+                sim.gameState = DIFFICULTY_TRANSITION;
+            }
+        } break;
 
-        Rectangle easyBtn = { GetScreenWidth()/2 - 100, 250, 200, 50 };
-        Rectangle mediumBtn = { GetScreenWidth()/2 - 100, 320, 200, 50 };
-        Rectangle hardBtn = { GetScreenWidth()/2 - 100, 390, 200, 50 };
-        Rectangle startBtn = { GetScreenWidth()/2 - 100, 460, 200, 50 };
+        case DIFFICULTY_TRANSITION: {
+            sim.transitionTimer += dt;
+            if (sim.transitionTimer >= 2.5f) {
+                EnterRun();
+            }
+        } break;
 
-        // ---------------- UPDATE ----------------
-        switch (gameState) {
-            case OPENING_SCENE: {
-                if (CheckCollisionPointRec(GetMousePosition(), easyBtn) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-                    selectedDifficulty = DIFFICULTY_EASY;
-                if (CheckCollisionPointRec(GetMousePosition(), mediumBtn) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-                    selectedDifficulty = DIFFICULTY_MEDIUM;
-                if (CheckCollisionPointRec(GetMousePosition(), hardBtn) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT))
-                    selectedDifficulty = DIFFICULTY_HARD;
-                if (CheckCollisionPointRec(GetMousePosition(), startBtn) && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-                    ResetGame(selectedDifficulty);
-                    if (selectedDifficulty == DIFFICULTY_HARD) SpawnObstacles();
-                    elixirSpawnInterval = (selectedDifficulty == DIFFICULTY_EASY) ? 8.0f : 
-                                         (selectedDifficulty == DIFFICULTY_MEDIUM) ? 5.0f : 7.0f;
-                    thunderstoneSpawnInterval = (selectedDifficulty == DIFFICULTY_EASY) ? 8.0f : 
-                                               (selectedDifficulty == DIFFICULTY_MEDIUM) ? 10.0f : 12.0f;
-                    speedSpawnInterval = (selectedDifficulty == DIFFICULTY_EASY) ? 10.0f : 
-                                         (selectedDifficulty == DIFFICULTY_MEDIUM) ? 12.0f : 15.0f;
-                    powerSpawnInterval = (selectedDifficulty == DIFFICULTY_EASY) ? 12.0f : 
-                                         (selectedDifficulty == DIFFICULTY_MEDIUM) ? 15.0f : 18.0f;
-                    secondChanceUsed = false;
-                    transitionTimer = 0.0f;
-                    gameState = DIFFICULTY_TRANSITION;
-                }
-            } break;
+        case GAMEPLAY: {
+            if (!sim.gameOver) {
+                sim.gameTimer += dt;
+            }
 
-            case DIFFICULTY_TRANSITION: {
-                transitionTimer += dt;
-                if (transitionTimer >= 2.5f) {
-                    gameState = GAMEPLAY;
-                }
-            } break;
-
-            case GAMEPLAY: {
-                if (!gameOver) {
-                    gameTimer += dt;
-                }
+            if (!simReplaying) UpdateParticles(&particles, dt);
 
-                if (elixirEffectActive) {
-                    elixirEffectTimer -= dt;
-                    if (elixirEffectTimer <= 0.0f) {
-                        elixirEffectActive = false;
-                    }
+            if (sim.elixirEffectActive) {
+                sim.elixirEffectTimer -= dt;
+                if (sim.elixirEffectTimer <= 0.0f) {
+                    sim.elixirEffectActive = false;
                 }
-                
-                if (thunderstoneEffectActive) {
-                    thunderstoneEffectTimer -= dt;
-                    if (thunderstoneEffectTimer <= 0.0f) {
-                        thunderstoneEffectActive = false;
-                    }
+            }
+            
+            if (sim.thunderstoneEffectActive) {
+                sim.thunderstoneEffectTimer -= dt;
+                if (sim.thunderstoneEffectTimer <= 0.0f) {
+                    sim.thunderstoneEffectActive = false;
                 }
+            }
 
-                if (speedEffectActive) {
-                    speedEffectTimer -= dt;
-                    if (speedEffectTimer <= 0.0f) {
-                        speedEffectActive = false;
-                        playerSpeed = basePlayerSpeed;
-                    }
+            if (sim.speedEffectActive) {
+                sim.speedEffectTimer -= dt;
+                if (sim.speedEffectTimer <= 0.0f) {
+                    sim.speedEffectActive = false;
+                    sim.playerSpeed = basePlayerSpeed;
                 }
+            }
 
-                if (powerEffectActive) {
-                    powerEffectTimer -= dt;
-                    if (powerEffectTimer <= 0.0f) {
-                        powerEffectActive = false;
-                    }
+            if (sim.powerEffectActive) {
+                sim.powerEffectTimer -= dt;
+                if (sim.powerEffectTimer <= 0.0f) {
+                    sim.powerEffectActive = false;
                 }
-                
-                if (!gameOver) {
+            }
+            
+            if (!sim.gameOver) {
+                for (int p = 0; p < PlayerCount(); p++) {
+                    Vector2 *pos = PlayerPos(p);
                     float delta_x = 0.0f;
-                    if (IsKeyDown(KEY_LEFT))  delta_x -= playerSpeed * dt;
-                    if (IsKeyDown(KEY_RIGHT)) delta_x += playerSpeed * dt;
+                    if (stepInput[p] & INPUT_LEFT)  delta_x -= sim.playerSpeed * dt;
+                    if (stepInput[p] & INPUT_RIGHT) delta_x += sim.playerSpeed * dt;
                     float delta_y = 0.0f;
-                    if (IsKeyDown(KEY_UP))    delta_y -= playerSpeed * dt;
-                    if (IsKeyDown(KEY_DOWN))  delta_y += playerSpeed * dt;
-                    playerPos.x += delta_x;
-                    playerPos.y += delta_y;
-
-                    if (IsKeyPressed(KEY_SPACE)) ShootBullet();
-
-                    for (int i = 0; i < MAX_BULLETS; i++) {
-                        if (bullets[i].active) {
-                            bullets[i].position.x += bullets[i].velocity.x * dt;
-                            bullets[i].position.y += bullets[i].velocity.y * dt;
-                            
-                            if (bullets[i].position.x < 0 || bullets[i].position.x > GetScreenWidth() ||
-                                bullets[i].position.y < 0 || bullets[i].position.y > GetScreenHeight()) {
-                                bullets[i].active = false;
-                            }
+                    if (stepInput[p] & INPUT_UP)    delta_y -= sim.playerSpeed * dt;
+                    if (stepInput[p] & INPUT_DOWN)  delta_y += sim.playerSpeed * dt;
+                    // The arena edge is a wall
+                    pos->x = Clamp(pos->x + delta_x, 20.0f, ARENA_WIDTH - 20.0f);
+                    pos->y = Clamp(pos->y + delta_y, 20.0f, ARENA_HEIGHT - 20.0f);
+
+                    if (stepInput[p] & INPUT_SHOOT) ShootBullet(*pos);
+                }
+
+                for (int i = 0; i < MAX_BULLETS; i++) {
+                    if (sim.bullets[i].active) {
+                        sim.bullets[i].position.x += sim.bullets[i].velocity.x * dt;
+                        sim.bullets[i].position.y += sim.bullets[i].velocity.y * dt;
+                        
+                        if (sim.bullets[i].position.x < 0 || sim.bullets[i].position.x > ARENA_WIDTH ||
+                            sim.bullets[i].position.y < 0 || sim.bullets[i].position.y > ARENA_HEIGHT ||
+                            ObstacleHitsCircle(sim.bullets[i].position, 5)) {
+                            sim.bullets[i].active = false;
                         }
                     }
+                }
+
+                UpdateSpawnDirector(dt);
 
-                    float spawnInterval = (selectedDifficulty == DIFFICULTY_EASY) ? 1.5f :
-                                          (selectedDifficulty == DIFFICULTY_MEDIUM) ? 1.0f : 0.7f;
-                    enemySpawnTimer += dt;
-                    if (enemySpawnTimer > spawnInterval - (score * 0.01f)) {
-                        SpawnEnemy(selectedDifficulty);
-                        enemySpawnTimer = 0;
+                if (!sim.elixirAvailable && !sim.elixirReady && sim.elixirSpawnInterval > 0.0f) {
+                    sim.elixirSpawnTimer += dt;
+                    if (sim.elixirSpawnTimer >= sim.elixirSpawnInterval) {
+                        sim.elixirSpawnTimer = 0.0f;
+                        sim.elixirPos = RandomViewPoint(50.0f);
+                        sim.elixirAvailable = true;
+                        sim.elixirDurationTimer = 0.0f;
                     }
+                }
 
-                    if (!elixirAvailable && !elixirReady && elixirSpawnInterval > 0.0f) {
-                        elixirSpawnTimer += dt;
-                        if (elixirSpawnTimer >= elixirSpawnInterval) {
-                            elixirSpawnTimer = 0.0f;
-                            float margin = 50.0f;
-                            elixirPos.x = GetRandomValue((int)margin, GetScreenWidth() - (int)margin);
-                            elixirPos.y = GetRandomValue((int)margin, GetScreenHeight() - (int)margin);
-                            elixirAvailable = true;
-                            elixirDurationTimer = 0.0f;
+                if (sim.elixirAvailable) {
+                    sim.elixirDurationTimer += dt;
+                    if (sim.elixirDurationTimer >= ELIXIR_DURATION) {
+                        sim.elixirAvailable = false;
+                        sim.elixirDurationTimer = 0.0f;
+                    } else {
+                        float pickupRadius = 50.0f;
+                        if (TouchesPlayer(sim.elixirPos, pickupRadius)) {
+                            sim.elixirAvailable = false;
+                            EmitBurst(&pickupBurst, sim.elixirPos, PURPLE);
+                            sim.elixirReady = true;
+                            sim.elixirDurationTimer = 0.0f;
                         }
                     }
+                }
 
-                    if (elixirAvailable) {
-                        elixirDurationTimer += dt;
-                        if (elixirDurationTimer >= ELIXIR_DURATION) {
-                            elixirAvailable = false;
-                            elixirDurationTimer = 0.0f;
-                        } else {
-                            float pickupRadius = 50.0f;
-                            if (CheckCollisionCircles(playerPos, 20.0f, elixirPos, pickupRadius)) {
-                                elixirAvailable = false;
-                                elixirReady = true;
-                                elixirDurationTimer = 0.0f;
-                            }
+                int elixirUser = PlayerPressing(INPUT_ELIXIR);
+                if (sim.elixirReady && elixirUser >= 0) {
+                    int enemiesDestroyed = 0;
+                    for (int i = 0; i < MAX_ENEMIES; i++) {
+                        if (sim.enemies[i].active) {
+                            sim.enemies[i].active = false;
+                            EmitEnemyDeath(&sim.enemies[i]);
+                            enemiesDestroyed++;
                         }
                     }
+                    sim.score += enemiesDestroyed;
+                    if (!simReplaying) EmitParticles(&particles, &elixirBurst, *PlayerPos(elixirUser), ParticleSeed());
+                    sim.elixirReady = false;
+                    sim.elixirEffectActive = true;
+                    sim.elixirEffectTimer = ELIXIR_EFFECT_DURATION;
+                    sim.elixirUser = elixirUser;
+                }
 
-                    if (elixirReady && IsKeyPressed(KEY_S)) {
-                        int enemiesDestroyed = 0;
-                        for (int i = 0; i < MAX_ENEMIES; i++) {
-                            if (enemies[i].active) {
-                                enemies[i].active = false;
-                                enemiesDestroyed++;
-                            }
-                        }
-                        score += enemiesDestroyed;
-                        elixirReady = false;
-                        elixirEffectActive = true;
-                        elixirEffectTimer = ELIXIR_EFFECT_DURATION;
+                if (!sim.thunderstoneAvailable) {
+                    sim.thunderstoneSpawnTimer += dt;
+                    if (sim.thunderstoneSpawnTimer >= sim.thunderstoneSpawnInterval) {
+                        sim.thunderstoneSpawnTimer = 0.0f;
+                        sim.thunderstonePos = RandomViewPoint(50.0f);
+                        sim.thunderstoneAvailable = true;
+                        sim.thunderstoneDurationTimer = 0.0f;
                     }
+                }
 
-                    if (!thunderstoneAvailable) {
-                        thunderstoneSpawnTimer += dt;
-                        if (thunderstoneSpawnTimer >= thunderstoneSpawnInterval) {
-                            thunderstoneSpawnTimer = 0.0f;
-                            float margin = 50.0f;
-                            thunderstonePos.x = GetRandomValue((int)margin, GetScreenWidth() - (int)margin);
-                            thunderstonePos.y = GetRandomValue((int)margin, GetScreenHeight() - (int)margin);
-                            thunderstoneAvailable = true;
-                            thunderstoneDurationTimer = 0.0f;
+                if (sim.thunderstoneAvailable) {
+                    sim.thunderstoneDurationTimer += dt;
+                    if (sim.thunderstoneDurationTimer >= THUNDERSTONE_DURATION) {
+                        sim.thunderstoneAvailable = false;
+                        sim.thunderstoneDurationTimer = 0.0f;
+                    } else {
+                        float pickupRadius = 50.0f;
+                        if (TouchesPlayer(sim.thunderstonePos, pickupRadius)) {
+                            sim.thunderstoneAvailable = false;
+                            EmitBurst(&pickupBurst, sim.thunderstonePos, ORANGE);
+                            sim.thunderstoneEffectActive = true;
+                            sim.thunderstoneEffectTimer = THUNDERSTONE_EFFECT_DURATION;
                         }
                     }
+                }
 
-                    if (thunderstoneAvailable) {
-                        thunderstoneDurationTimer += dt;
-                        if (thunderstoneDurationTimer >= THUNDERSTONE_DURATION) {
-                            thunderstoneAvailable = false;
-                            thunderstoneDurationTimer = 0.0f;
-                        } else {
-                            float pickupRadius = 50.0f;
-                            if (CheckCollisionCircles(playerPos, 20.0f, thunderstonePos, pickupRadius)) {
-                                thunderstoneAvailable = false;
-                                thunderstoneEffectActive = true;
-                                thunderstoneEffectTimer = THUNDERSTONE_EFFECT_DURATION;
-                            }
-                        }
+                if (!sim.speedAvailable) {
+                    sim.speedSpawnTimer += dt;
+                    if (sim.speedSpawnTimer >= sim.speedSpawnInterval) {
+                        sim.speedSpawnTimer = 0.0f;
+                        sim.speedPos = RandomViewPoint(50.0f);
+                        sim.speedAvailable = true;
+                        sim.speedDurationTimer = 0.0f;
                     }
+                }
 
-                    if (!speedAvailable) {
-                        speedSpawnTimer += dt;
-                        if (speedSpawnTimer >= speedSpawnInterval) {
-                            speedSpawnTimer = 0.0f;
-                            float margin = 50.0f;
-                            speedPos.x = GetRandomValue((int)margin, GetScreenWidth() - (int)margin);
-                            speedPos.y = GetRandomValue((int)margin, GetScreenHeight() - (int)margin);
-                            speedAvailable = true;
-                            speedDurationTimer = 0.0f;
+                if (sim.speedAvailable) {
+                    sim.speedDurationTimer += dt;
+                    if (sim.speedDurationTimer >= SPEED_DURATION) {
+                        sim.speedAvailable = false;
+                        sim.speedDurationTimer = 0.0f;
+                    } else {
+                        float pickupRadius = 50.0f;
+                        if (TouchesPlayer(sim.speedPos, pickupRadius)) {
+                            sim.speedAvailable = false;
+                            EmitBurst(&pickupBurst, sim.speedPos, BLUE);
+                            sim.speedEffectActive = true;
+                            sim.speedEffectTimer = SPEED_EFFECT_DURATION;
+                            sim.playerSpeed = basePlayerSpeed * 2.5f;
                         }
                     }
+                }
 
-                    if (speedAvailable) {
-                        speedDurationTimer += dt;
-                        if (speedDurationTimer >= SPEED_DURATION) {
-                            speedAvailable = false;
-                            speedDurationTimer = 0.0f;
-                        } else {
-                            float pickupRadius = 50.0f;
-                            if (CheckCollisionCircles(playerPos, 20.0f, speedPos, pickupRadius)) {
-                                speedAvailable = false;
-                                speedEffectActive = true;
-                                speedEffectTimer = SPEED_EFFECT_DURATION;
-                                playerSpeed = basePlayerSpeed * 2.5f;
-                            }
-                        }
+                if (!sim.powerAvailable) {
+                    sim.powerSpawnTimer += dt;
+                    if (sim.powerSpawnTimer >= sim.powerSpawnInterval) {
+                        sim.powerSpawnTimer = 0.0f;
+                        sim.powerPos = RandomViewPoint(50.0f);
+                        sim.powerAvailable = true;
+                        sim.powerDurationTimer = 0.0f;
                     }
+                }
 
-                    if (!powerAvailable) {
-                        powerSpawnTimer += dt;
-                        if (powerSpawnTimer >= powerSpawnInterval) {
-                            powerSpawnTimer = 0.0f;
-                            float margin = 50.0f;
-                            powerPos.x = GetRandomValue((int)margin, GetScreenWidth() - (int)margin);
-                            powerPos.y = GetRandomValue((int)margin, GetScreenHeight() - (int)margin);
-                            powerAvailable = true;
-                            powerDurationTimer = 0.0f;
+                if (sim.powerAvailable) {
+                    sim.powerDurationTimer += dt;
+                    if (sim.powerDurationTimer >= POWER_DURATION) {
+                        sim.powerAvailable = false;
+                        sim.powerDurationTimer = 0.0f;
+                    } else {
+                        float pickupRadius = 50.0f;
+                        if (TouchesPlayer(sim.powerPos, pickupRadius)) {
+                            sim.powerAvailable = false;
+                            EmitBurst(&pickupBurst, sim.powerPos, RED);
+                            sim.powerEffectActive = true;
+                            sim.powerEffectTimer = POWER_EFFECT_DURATION;
                         }
                     }
+                }
 
-                    if (powerAvailable) {
-                        powerDurationTimer += dt;
-                        if (powerDurationTimer >= POWER_DURATION) {
-                            powerAvailable = false;
-                            powerDurationTimer = 0.0f;
-                        } else {
-                            float pickupRadius = 50.0f;
-                            if (CheckCollisionCircles(playerPos, 20.0f, powerPos, pickupRadius)) {
-                                powerAvailable = false;
-                                powerEffectActive = true;
-                                powerEffectTimer = POWER_EFFECT_DURATION;
+                // Only rebuilds once the player has moved into another cell
+                if (obstacleIndex.count > 0) {
+                    SetFlowFieldTarget(&enemyFlow, sim.playerPos);
+                    UpdateFlowField(&enemyFlow, FLOW_FIELD_BUDGET);
+                }
+
+                RebuildEnemyHash();
+
+                if (sim.elixirEffectActive) {
+                    float progress = 1.0f - (sim.elixirEffectTimer / ELIXIR_EFFECT_DURATION);
+                    float radius = 10.0f + progress * 100.0f;
+                    sim.score += KillEnemiesInRadius(*PlayerPos(sim.elixirUser), radius);
+                }
+
+                SeparateEnemies(dt);
+
+                int bulletCount = GatherBullets();
+                for (int i = 0; i < MAX_ENEMIES; i++) {
+                    if (sim.enemies[i].active) {
+                        // The flow field leads to player 1; the partner is chased head-on
+                        int chased = NearestPlayer(sim.enemies[i].position);
+                        Vector2 direction = Vector2Subtract(*PlayerPos(chased), sim.enemies[i].position);
+                        Vector2 flow = (obstacleIndex.count > 0 && chased == 0) ? SampleFlowField(&enemyFlow, sim.enemies[i].position) : (Vector2){0, 0};
+                        if (flow.x != 0.0f || flow.y != 0.0f)
+                            sim.enemies[i].velocity = Vector2Scale(flow, sim.enemies[i].speed);
+                        else if (Vector2Length(direction) > 0.0f)
+                            sim.enemies[i].velocity = Vector2Scale(Vector2Normalize(direction), sim.enemies[i].speed);
+                        sim.enemies[i].position = Vector2Add(sim.enemies[i].position, Vector2Scale(sim.enemies[i].velocity, dt));
+                        SlideAlongObstacles(&sim.enemies[i].position, 20);
+
+                        if (TouchesPlayer(sim.enemies[i].position, 20)) {
+                            if (!sim.secondChanceUsed) {
+                                sim.gameState = REVIVE_PROMPT;
+                                sim.reviveChoice = 0; // Default to YES
+                                sim.reviveTimer = REVIVE_TIME;
+                            } else {
+                                sim.gameOver = true;
+                                sim.gameState = CLOSING_SCENE;
+                                PlayDeadSound();
                             }
+                            break;
                         }
-                    }
 
-                    for (int i = 0; i < MAX_ENEMIES; i++) {
-                        if (enemies[i].active) {
-                            Vector2 direction = Vector2Subtract(playerPos, enemies[i].position);
-                            if (Vector2Length(direction) > 0.0f)
-                                enemies[i].velocity = Vector2Scale(Vector2Normalize(direction), enemies[i].speed);
-                            enemies[i].position = Vector2Add(enemies[i].position, Vector2Scale(enemies[i].velocity, dt));
-
-                            if (CheckCollisionCircles(enemies[i].position, 20, playerPos, 20)) {
-                                if (!secondChanceUsed) {
-                                    gameState = REVIVE_PROMPT;
-                                    reviveChoice = 0; // Default to YES
-                                    reviveTimer = 600; // Reset timer (10 seconds at 60 FPS)
+                        // First live bullet in pool order, as the one-by-one scan found it;
+                        // bullets an earlier enemy absorbed this step are still packed
+                        if (bulletCount == 0 || CheckCollisionCirclesBatch(sim.enemies[i].position, 20, bulletCenters, bulletRadii, bulletCount, bulletHits) == 0) continue;
+                        for (int k = 0; k < bulletCount; k++) {
+                            int j = bulletIds[k];
+                            if (bulletHits[k] && sim.bullets[j].active) {
+                                sim.bullets[j].active = false;
+                                if (sim.powerEffectActive) {
+                                    sim.enemies[i].health = 0;
                                 } else {
-                                    gameOver = true;
-                                    gameState = CLOSING_SCENE;
-                                    if (!deadSoundPlayed && deadSound.frameCount > 0) {
-                                        PlaySound(deadSound);
-                                        deadSoundPlayed = true;
-                                    }
+                                    sim.enemies[i].health--;
                                 }
-                                break;
-                            }
-
-                            for (int j = 0; j < MAX_BULLETS; j++) {
-                                if (bullets[j].active && CheckCollisionCircles(enemies[i].position, 20, bullets[j].position, 5)) {
-                                    bullets[j].active = false;
-                                    if (powerEffectActive) {
-                                        enemies[i].health = 0;
-                                    } else {
-                                        enemies[i].health--;
-                                    }
-                                    if (enemies[i].health <= 0) {
-                                        enemies[i].active = false;
-                                        score++;
-                                    }
-                                    break;
+                                if (sim.enemies[i].health <= 0) {
+                                    sim.enemies[i].active = false;
+                                    EmitEnemyDeath(&sim.enemies[i]);
+                                    sim.score++;
                                 }
+                                break;
                             }
                         }
                     }
+                }
 
-                    if (elixirEffectActive) {
-                        float progress = 1.0f - (elixirEffectTimer / ELIXIR_EFFECT_DURATION);
-                        float radius = 10.0f + progress * 100.0f;
-                        int enemiesDestroyed = 0;
-                        for (int i = 0; i < MAX_ENEMIES; i++) {
-                            if (enemies[i].active && CheckCollisionCircles(playerPos, radius, enemies[i].position, 20)) {
-                                enemies[i].active = false;
-                                enemiesDestroyed++;
-                            }
-                        }
-                        score += enemiesDestroyed;
-                    }
-
-                    if (selectedDifficulty == DIFFICULTY_HARD) {
+                if (sim.selectedDifficulty == DIFFICULTY_HARD) {
+                    bool hit = false;
+                    for (int p = 0; p < PlayerCount() && !hit; p++) {
                         Rectangle playerRect = {
-                            playerPos.x - pikachuTex.width/2.0f,
-                            playerPos.y - pikachuTex.height/2.0f,
+                            PlayerPos(p)->x - pikachuTex.width/2.0f,
+                            PlayerPos(p)->y - pikachuTex.height/2.0f,
                             (float)pikachuTex.width,
                             (float)pikachuTex.height
                         };
-                        for (int i = 0; i < MAX_OBSTACLES; i++) {
-                            if (obstacles[i].active && CheckCollisionRecs(playerRect, obstacles[i].rect)) {
-                                if (!secondChanceUsed) {
-                                    gameState = REVIVE_PROMPT;
-                                    reviveChoice = 0; // Default to YES
-                                    reviveTimer = 600; // Reset timer (10 seconds at 60 FPS)
-                                } else {
-                                    gameOver = true;
-                                    gameState = CLOSING_SCENE;
-                                    if (!deadSoundPlayed && deadSound.frameCount > 0) {
-                                        PlaySound(deadSound);
-                                        deadSoundPlayed = true;
-                                    }
-                                }
-                            }
+                        hit = ObstacleHitsRec(playerRect);
+                    }
+                    if (hit) {
+                        if (!sim.secondChanceUsed) {
+                            sim.gameState = REVIVE_PROMPT;
+                            sim.reviveChoice = 0; // Default to YES
+                            sim.reviveTimer = REVIVE_TIME;
+                        } else {
+                            sim.gameOver = true;
+                            sim.gameState = CLOSING_SCENE;
+                            PlayDeadSound();
                         }
                     }
                 }
-            } break;
+            }
+        } break;
 
-            case REVIVE_PROMPT: {
-                // Update choice
-                if (IsKeyPressed(KEY_RIGHT) || IsKeyPressed(KEY_LEFT)) {
-                    reviveChoice = !reviveChoice;
-                }
-                // Confirm choice
-                if (IsKeyPressed(KEY_ENTER)) {
-                    if (reviveChoice == 0) { // YES
-                        ResetMiniGame(selectedDifficulty);
-                        ResetElixirState();
-                        ResetThunderstoneState();
-                        ResetSpeedState();
-                        ResetPowerState();
-                        gameState = MINI_GAME;
-                    } else { // NO
-                        gameOver = true;
-                        secondChanceUsed = true;
-                        gameState = CLOSING_SCENE;
-                        if (!deadSoundPlayed && deadSound.frameCount > 0) {
-                            PlaySound(deadSound);
-                            deadSoundPlayed = true;
-                        }
-                    }
+        case REVIVE_PROMPT: {
+            // Update choice
+            if (SimKeyPressed(KEY_RIGHT) || SimKeyPressed(KEY_LEFT)) {
+                sim.reviveChoice = !sim.reviveChoice;
+            }
+            // Confirm choice
+            if (SimKeyPressed(KEY_ENTER)) {
+                if (sim.reviveChoice == 0) { // YES
+                    ResetMiniGame(sim.selectedDifficulty);
+                    ResetElixirState();
+                    ResetThunderstoneState();
+                    ResetSpeedState();
+                    ResetPowerState();
+                    sim.gameState = MINI_GAME;
+                } else { // NO
+                    sim.gameOver = true;
+                    sim.secondChanceUsed = true;
+                    sim.gameState = CLOSING_SCENE;
+                    PlayDeadSound();
                 }
-                // Countdown timer
-                reviveTimer--;
-                if (reviveTimer <= 0) {
-                    gameOver = true;
-                    secondChanceUsed = true;
-                    gameState = CLOSING_SCENE;
-                    if (!deadSoundPlayed && deadSound.frameCount > 0) {
-                        PlaySound(deadSound);
-                        deadSoundPlayed = true;
-                    }
+            }
+            // Countdown timer
+            sim.reviveTimer -= dt;
+            if (sim.reviveTimer <= 0.0f) {
+                sim.gameOver = true;
+                sim.secondChanceUsed = true;
+                sim.gameState = CLOSING_SCENE;
+                PlayDeadSound();
+            }
+        } break;
+
+        case MINI_GAME: {
+            UpdateParticles(&particles, dt);
+
+            if (sim.selectedDifficulty == DIFFICULTY_EASY) {
+                // Falling balls update
+                int basketDirection = (IsKeyDown(KEY_RIGHT) ? 1 : 0) - (IsKeyDown(KEY_LEFT) ? 1 : 0);
+                UpdateBallRain(&ballRain, dt, basketDirection);
+
+                if (ballRain.score >= TARGET_SCORE) {
+                    RevivePlayers();
+                } else if (ballRain.misses >= MAX_MISSES) {
+                    sim.gameOver = true;
+                    sim.secondChanceUsed = true;
+                    sim.gameState = CLOSING_SCENE;
+                    PlayDeadSound();
                 }
-            } break;
-
-            case MINI_GAME: {
-                if (selectedDifficulty == DIFFICULTY_EASY) {
-                    // Falling balls update
-                    if (IsKeyDown(KEY_LEFT) && basketX > 0) basketX -= basketSpeed;
-                    if (IsKeyDown(KEY_RIGHT) && basketX + basketWidth < GetScreenWidth()) basketX += basketSpeed;
-
-                    int activeBalls = 0;
-                    for (int i = 0; i < MAX_BALLS; i++) {
-                        if (balls[i].active) {
-                            balls[i].position.y += BALL_SPEED;
-
-                            if (balls[i].position.y + BALLS_RADIUS >= basketY &&
-                                balls[i].position.x >= basketX &&
-                                balls[i].position.x <= basketX + basketWidth) {
-                                ballScore++;
-                                balls[i].active = false;
-                            }
-
-                            if (balls[i].position.y - BALLS_RADIUS > GetScreenHeight()) {
-                                misses++;
-                                balls[i].position.y = (float)GetRandomValue(-600, 0);
-                                balls[i].position.x = (float)GetRandomValue(BALLS_RADIUS, GetScreenWidth() - BALLS_RADIUS);
-                                balls[i].color = (Color){ (unsigned char)GetRandomValue(50,255), (unsigned char)GetRandomValue(50,255), (unsigned char)GetRandomValue(50,255), 255 };
-                                balls[i].active = true;
-                            }
-                            activeBalls++;
+            } else if (sim.selectedDifficulty == DIFFICULTY_MEDIUM) {
+                // Wordle update
+                if (!sim.wordleWon && sim.currentGuess < MAX_GUESSES) {
+                    int key = SimCharPressed();
+                    while (key > 0) {
+                        if (key >= 'A' && key <= 'Z' && sim.currentLetter < WORD_LENGTH) {
+                            sim.guesses[sim.currentGuess][sim.currentLetter] = (char)key;
+                            sim.currentLetter++;
                         }
+                        key = SimCharPressed();
                     }
 
-                    if (activeBalls < 2) {
-                        for (int i = 0; i < MAX_BALLS; i++) {
-                            if (!balls[i].active) {
-                                balls[i].active = true;
-                                balls[i].position = (Vector2){ (float)GetRandomValue(BALLS_RADIUS, GetScreenWidth() - BALLS_RADIUS),
-                                                               (float)GetRandomValue(-600, 0) };
-                                balls[i].color = (Color){ (unsigned char)GetRandomValue(50,255), (unsigned char)GetRandomValue(50,255), (unsigned char)GetRandomValue(50,255), 255 };
-                                activeBalls++;
-                                if (activeBalls >= 2) break;
-                            }
-                        }
+                    if (SimKeyPressed(KEY_BACKSPACE) && sim.currentLetter > 0) {
+                        sim.currentLetter--;
+                        sim.guesses[sim.currentGuess][sim.currentLetter] = '\0';
                     }
 
-                    if (ballScore >= TARGET_SCORE) {
-                        secondChanceUsed = true;
-                        playerPos = (Vector2){400, 300};
-                        gameOver = false;
-                        for (int i = 0; i < MAX_ENEMIES;  i++) enemies[i].active = false;
-                        for (int i = 0; i < MAX_BULLETS;  i++) bullets[i].active = false;
-                        ResetElixirState();
-                        ResetThunderstoneState();
-                        ResetSpeedState();
-                        ResetPowerState();
-                        gameState = GAMEPLAY;
-                    } else if (misses >= MAX_MISSES) {
-                        gameOver = true;
-                        secondChanceUsed = true;
-                        gameState = CLOSING_SCENE;
-                        if (!deadSoundPlayed && deadSound.frameCount > 0) {
-                            PlaySound(deadSound);
-                            deadSoundPlayed = true;
-                        }
+                    bool submitted = SimKeyPressed(KEY_ENTER) && sim.currentLetter == WORD_LENGTH;
+                    if (submitted && !IsAllowedGuess(sim.guesses[sim.currentGuess])) {
+                        sim.wordleNoticeTimer = 1.5f;
+                        submitted = false;
                     }
-                } else if (selectedDifficulty == DIFFICULTY_MEDIUM) {
-                    // Wordle update
-                    if (!wordleWon && currentGuess < MAX_GUESSES) {
-                        int key = GetCharPressed();
-                        while (key > 0) {
-                            if (key >= 'A' && key <= 'Z' && currentLetter < WORD_LENGTH) {
-                                guesses[currentGuess][currentLetter] = (char)key;
-                                currentLetter++;
-                            }
-                            key = GetCharPressed();
-                        }
+                    if (sim.wordleNoticeTimer > 0.0f) sim.wordleNoticeTimer -= dt;
+                    if (SimKeyPressed(KEY_TAB)) ComputeWordleHint();
 
-                        if (IsKeyPressed(KEY_BACKSPACE) && currentLetter > 0) {
-                            currentLetter--;
-                            guesses[currentGuess][currentLetter] = '\0';
-                        }
-
-                        if (IsKeyPressed(KEY_ENTER) && currentLetter == WORD_LENGTH) {
-                            // Compute feedback
-                            int letterCount[26] = {0};
-                            for (int i = 0; i < WORD_LENGTH; i++) {
-                                letterCount[targetWord[i] - 'A']++;
-                            }
+                    if (submitted) {
+                        sim.wordleHintShown = false;
 
-                            // Mark greens
-                            for (int i = 0; i < WORD_LENGTH; i++) {
-                                if (guesses[currentGuess][i] == targetWord[i]) {
-                                    guessColors[currentGuess][i] = GREEN;
-                                    letterCount[guesses[currentGuess][i] - 'A']--;
-                                } else {
-                                    guessColors[currentGuess][i] = LIGHTGRAY;
-                                }
-                            }
+                        // Compute feedback
+                        int letterCount[26] = {0};
+                        for (int i = 0; i < WORD_LENGTH; i++) {
+                            letterCount[sim.targetWord[i] - 'A']++;
+                        }
 
-                            // Mark yellows
-                            for (int i = 0; i < WORD_LENGTH; i++) {
-                                if (ColorsEqual(guessColors[currentGuess][i], LIGHTGRAY)) {
-                                    char letter = guesses[currentGuess][i];
-                                    if (letterCount[letter - 'A'] > 0) {
-                                        guessColors[currentGuess][i] = YELLOW;
-                                        letterCount[letter - 'A']--;
-                                    }
-                                }
+                        // Mark greens
+                        for (int i = 0; i < WORD_LENGTH; i++) {
+                            if (sim.guesses[sim.currentGuess][i] == sim.targetWord[i]) {
+                                sim.guessColors[sim.currentGuess][i] = GREEN;
+                                letterCount[sim.guesses[sim.currentGuess][i] - 'A']--;
+                            } else {
+                                sim.guessColors[sim.currentGuess][i] = LIGHTGRAY;
                             }
+                        }
 
-                            // Check if won
-                            wordleWon = true;
-                            for (int i = 0; i < WORD_LENGTH; i++) {
-                                if (!ColorsEqual(guessColors[currentGuess][i], GREEN)) {
-                                    wordleWon = false;
-                                    break;
+                        // Mark yellows
+                        for (int i = 0; i < WORD_LENGTH; i++) {
+                            if (ColorsEqual(sim.guessColors[sim.currentGuess][i], LIGHTGRAY)) {
+                                char letter = sim.guesses[sim.currentGuess][i];
+                                if (letterCount[letter - 'A'] > 0) {
+                                    sim.guessColors[sim.currentGuess][i] = YELLOW;
+                                    letterCount[letter - 'A']--;
                                 }
                             }
-
-                            currentGuess++;
-                            currentLetter = 0;
                         }
-                    }
 
-                    if (wordleWon || (currentGuess == MAX_GUESSES)) {
-                        if (wordleWon) {
-                            secondChanceUsed = true;
-                            playerPos = (Vector2){400, 300};
-                            gameOver = false;
-                            for (int i = 0; i < MAX_ENEMIES;  i++) enemies[i].active = false;
-                            for (int i = 0; i < MAX_BULLETS;  i++) bullets[i].active = false;
-                            ResetElixirState();
-                            ResetThunderstoneState();
-                            ResetSpeedState();
-                            ResetPowerState();
-                            gameState = GAMEPLAY;
-                        } else {
-                            gameOver = true;
-                            secondChanceUsed = true;
-                            gameState = CLOSING_SCENE;
-                            if (!deadSoundPlayed && deadSound.frameCount > 0) {
-                                PlaySound(deadSound);
-                                deadSoundPlayed = true;
+                        // Check if won
+                        sim.wordleWon = true;
+                        for (int i = 0; i < WORD_LENGTH; i++) {
+                            if (!ColorsEqual(sim.guessColors[sim.currentGuess][i], GREEN)) {
+                                sim.wordleWon = false;
+                                break;
                             }
                         }
-                    }
-                } else {
-                    // Bowling update
-                    if (IsKeyPressed(KEY_S) && !ballLaunched) {
-                        strikeMode = !strikeMode;
-                        if (strikeMode) {
-                            luckyStrike = (GetRandomValue(0, 1) == 1);
-                        }
-                    }
 
-                    if (!ballLaunched) {
-                        if (IsKeyDown(KEY_LEFT)) throwAngle -= 0.02f;
-                        if (IsKeyDown(KEY_RIGHT)) throwAngle += 0.02f;
-                        throwAngle = Clamp(throwAngle, -maxAngle, maxAngle);
-                        ballPos.x = GetScreenWidth()/2.0f + sinf(throwAngle) * a;
-                        ballPos.y = GetScreenHeight() - 80.0f;
+                        sim.currentGuess++;
+                        sim.currentLetter = 0;
                     }
+                }
 
-                    if (IsKeyDown(KEY_SPACE) && !ballLaunched) {
-                        charging = true;
-                        power += 0.01f;
-                        power = Clamp(power, 0.0f, maxPower);
-                    }
-                    if (IsKeyReleased(KEY_SPACE) && charging) {
-                        charging = false;
-                        ellipseCenter = (Vector2){ GetScreenWidth()/2.0f, GetScreenHeight() + 50 };
-                        ballLaunched = true;
-                        t = 0.0f;
-                        ballSpeed = baseSpeed + power * 0.05f;
+                if (sim.wordleWon || (sim.currentGuess == MAX_GUESSES)) {
+                    if (sim.wordleWon) {
+                        RevivePlayers();
+                    } else {
+                        sim.gameOver = true;
+                        sim.secondChanceUsed = true;
+                        sim.gameState = CLOSING_SCENE;
+                        PlayDeadSound();
                     }
+                }
+            } else {
+                // Bowling update
+                if (SimKeyPressed(KEY_P) && !sim.bowl.launched && !sim.charging) {
+                    sim.pinRackRows = (sim.pinRackRows >= MAX_PIN_ROWS) ? PIN_RACK_ROWS : sim.pinRackRows + 1;
+                    LayoutPins();
+                }
 
-                    if (ballLaunched) {
-                        t += ballSpeed;
-                        float x = a * cosf(t);
-                        float y = b * sinf(t);
-                        ballPos.x = ellipseCenter.x + x * cosf(throwAngle) - y * sinf(throwAngle);
-                        ballPos.y = ellipseCenter.y - x * sinf(throwAngle) - y * cosf(throwAngle);
-
-                        if (ballPos.x < LANE_LEFT + BOWLING_BALL_RADIUS) ballPos.x = LANE_LEFT + BOWLING_BALL_RADIUS;
-                        if (ballPos.x > LANE_RIGHT - BOWLING_BALL_RADIUS) ballPos.x = LANE_RIGHT - BOWLING_BALL_RADIUS;
-
-                        for (int i = 0; i < NUM_PINS; i++) {
-                            if (!pins[i].fallen && CheckCollisionCircles(ballPos, BOWLING_BALL_RADIUS, pins[i].position, PIN_RADIUS)) {
-                                bool isStrikeCondition = (strikeMode && luckyStrike) || (fabsf(throwAngle) < 0.1f && power > 0.8f);
-                                if (isStrikeCondition) {
-                                    for (int j = 0; j < NUM_PINS; j++) {
-                                        pins[j].fallen = true;
-                                        pins[j].animating = true;
-                                        pins[j].velocity = (Vector2){(float)GetRandomValue(-5, 5), (float)GetRandomValue(5, 10)};
-                                        pins[j].rotation = (float)GetRandomValue(0, 360);
-                                    }
-                                    if (hitSound.frameCount > 0) PlaySound(hitSound);
-                                    break;
-                                } else {
-                                    pins[i].fallen = true;
-                                    pins[i].animating = true;
-                                    pins[i].velocity = (Vector2){(float)GetRandomValue(-5, 5), (float)GetRandomValue(5, 10)};
-                                    pins[i].rotation = (float)GetRandomValue(0, 360);
-                                    if (hitSound.frameCount > 0) PlaySound(hitSound);
-                                }
-                            }
-                        }
+                if (!sim.bowl.launched) {
+                    if (IsKeyDown(KEY_LEFT)) sim.throwAngle -= AIM_SPEED * dt;
+                    if (IsKeyDown(KEY_RIGHT)) sim.throwAngle += AIM_SPEED * dt;
+                    sim.throwAngle = Clamp(sim.throwAngle, -maxAngle, maxAngle);
+                    sim.ballPos.x = GetScreenWidth()/2.0f + sinf(sim.throwAngle) * THROW_WIDTH;
+                    sim.ballPos.y = GetScreenHeight() - 80.0f;
+                    pinWorld.bodies[sim.bowl.ball].position = sim.ballPos;
+                }
 
-                        if (t >= PI / 2) {
-                            bool strike = true;
-                            for (int i = 0; i < NUM_PINS; i++) {
-                                if (!pins[i].fallen) { strike = false; break; }
-                            }
-                            if (strike) {
-                                secondChanceUsed = true;
-                                playerPos = (Vector2){400, 300};
-                                gameOver = false;
-                                for (int i = 0; i < MAX_ENEMIES;  i++) enemies[i].active = false;
-                                for (int i = 0; i < MAX_BULLETS;  i++) bullets[i].active = false;
-                                ResetElixirState();
-                                ResetThunderstoneState();
-                                ResetSpeedState();
-                                ResetPowerState();
-                                gameState = GAMEPLAY;
-                            } else {
-                                gameOver = true;
-                                secondChanceUsed = true;
-                                gameState = CLOSING_SCENE;
-                                if (!deadSoundPlayed && deadSound.frameCount > 0) {
-                                    PlaySound(deadSound);
-                                    deadSoundPlayed = true;
-                                }
-                            }
-                            ResetMiniGame(selectedDifficulty);
-                        }
-                    }
+                if (IsKeyDown(KEY_SPACE) && !sim.bowl.launched) {
+                    sim.charging = true;
+                    sim.power += CHARGE_RATE * dt;
+                    sim.power = Clamp(sim.power, 0.0f, maxPower);
+                }
+                if (SimKeyReleased(KEY_SPACE) && sim.charging) {
+                    sim.charging = false;
+                    sim.ellipseCenter = (Vector2){ GetScreenWidth()/2.0f, GetScreenHeight() + 50 };
+                    sim.ballSpeed = BowlingThrowSpeed(sim.power);
+                    LaunchBowlingThrow(&sim.bowl, &pinWorld, sim.ellipseCenter, sim.throwAngle, sim.ballSpeed);
+                }
 
-                    for (int i = 0; i < NUM_PINS; i++) {
-                        if (pins[i].animating) {
-                            pins[i].position.x += pins[i].velocity.x;
-                            pins[i].position.y += pins[i].velocity.y;
-                            pins[i].velocity.y += 0.3f;
-                            pins[i].rotation += 10.0f;
-                            if (pins[i].position.y > GetScreenHeight() + 50.0f) {
-                                pins[i].animating = false;
-                            }
+                if (sim.bowl.launched) {
+                    StepRigidWorld(&pinWorld, dt);
+                    sim.ballPos = pinWorld.bodies[sim.bowl.ball].position;
+                    UpdatePinKnocks();
+
+                    if (sim.bowl.released) sim.settleTimer += dt;
+                    // The simulation decides: a strike is every pin down once it all comes to rest
+                    if (sim.bowl.released && (pinWorld.awake == 0 || sim.settleTimer >= BOWLING_SETTLE_TIME)) {
+                        bool strike = true;
+                        for (int i = 0; i < sim.bowl.pinCount; i++) {
+                            if (!sim.bowl.pins[i].fallen) { strike = false; break; }
+                        }
+                        if (strike) {
+                            RevivePlayers();
+                        } else {
+                            sim.gameOver = true;
+                            sim.secondChanceUsed = true;
+                            sim.gameState = CLOSING_SCENE;
+                            PlayDeadSound();
                         }
+                        ResetMiniGame(sim.selectedDifficulty);
                     }
                 }
-            } break;
-
-            case CLOSING_SCENE: {
-                if (!animationComplete) {
-                    gameOverScale += scaleSpeed * dt;
-                    if (gameOverScale >= 1.0f) {
-                        gameOverScale = 1.0f;
-                        animationComplete = true;
-                    }
+            }
+        } break;
+
+        case CLOSING_SCENE: {
+            if (!sim.animationComplete) {
+                sim.gameOverScale += scaleSpeed * dt;
+                if (sim.gameOverScale >= 1.0f) {
+                    sim.gameOverScale = 1.0f;
+                    sim.animationComplete = true;
                 }
-                if (animationComplete) {
-                    if (IsKeyPressed(KEY_R)) {
-                        ResetGame(selectedDifficulty);
-                        if (selectedDifficulty == DIFFICULTY_HARD) SpawnObstacles();
-                        secondChanceUsed = false;
-                        gameState = GAMEPLAY;
-                    }
-                    if (IsKeyPressed(KEY_H)) {
-                        ResetGame(selectedDifficulty);
-                        secondChanceUsed = false;
-                        gameState = OPENING_SCENE;
-                    }
+            }
+            if (sim.animationComplete) {
+                if (PlayerPressing(INPUT_RESTART) >= 0) {
+                    ResetGame(sim.selectedDifficulty);
+                    if (sim.selectedDifficulty == DIFFICULTY_HARD) SpawnObstacles();
+                    // The revive mini-games are single-player
+                    sim.secondChanceUsed = sim.coop;
+                    sim.gameState = GAMEPLAY;
                 }
-            } break;
+                // Co-op has no menu to go back to
+                if (!sim.coop && SimKeyPressed(KEY_H)) {
+                    ResetGame(sim.selectedDifficulty);
+                    sim.secondChanceUsed = false;
+                    sim.gameState = OPENING_SCENE;
+                }
+            }
+        } break;
+    }
+}
+
+// ------------ Co-op ------------
+// a.exe --coop 1|2 [--peer address] [--port N] [--difficulty easy|medium|hard]
+//                  [--latency ms] [--jitter ms] [--loss percent] [--bot]
+// Two Pikachus in one arena, one steered from each machine, kept in step by
+// rollback (see rollback.h). Every packet carries this side's inputs from
+// the first frame the peer may lack, how much of the peer's it has, and the
+// checksum of its latest final frame, so a lost packet is covered by the
+// next. Player 1 picks the seed and the difficulty and player 2 takes them
+// from the first packet. --latency, --jitter and --loss hold back and drop
+// this side's sends, so two copies on one machine (the default: 127.0.0.1,
+// ports N and N+1) behave like a real connection. The window keeps its
+// starting size, since spawns and the bowling rack are placed by it.
+
+typedef struct {
+    unsigned int magic;
+    unsigned char player;           // sender, 0 or 1
+    unsigned char difficulty;       // of the run player 1 hosts
+    unsigned char inputCount;
+    signed char advantage;          // sender's RollbackAdvantage, for time sync
+    unsigned int seed;              // of the run player 1 hosts
+    int firstFrame;                 // frame of inputs[0]
+    int ackFrame;                   // frames of the receiver's input the sender has
+    int checksumFrame;              // sender's latest final frame, -1 for none
+    unsigned long long checksum;
+    RollbackInput inputs[COOP_MAX_INPUTS];
+} CoopPacket;
+#define COOP_HEADER_SIZE ((int)offsetof(CoopPacket, inputs))
+
+static void SaveCoopFrame(SnapshotStream *stream, void *user) {
+    SaveGameState(stream);
+}
+
+static bool LoadCoopFrame(SnapshotStream *stream, void *user) {
+    return RestoreGameState(stream);
+}
+
+static void StepCoopFrame(const RollbackInput *inputs, bool resimulating, void *user) {
+    stepInput[0] = inputs[0];
+    stepInput[1] = inputs[1];
+    simReplaying = resimulating;
+    SnapshotPositions();
+    UpdateGame(SIM_DT);
+    simReplaying = false;
+}
+
+// --bot: a new heading every half second and a shot every quarter, hashed
+// from the frame so each side keeps mispredicting the other, and a restart
+// as soon as a run is over
+static RollbackInput BotInput(int frame) {
+    unsigned int h = (unsigned int)(frame / (SIM_HZ / 2) + 1) * 2654435761u ^ (unsigned int)(coopPlayer + 1) * 40503u;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    RollbackInput input = (RollbackInput)(h & INPUT_HELD);
+    if (frame % (SIM_HZ / 4) == 0) input |= INPUT_SHOOT;
+    if (sim.gameState == CLOSING_SCENE && sim.animationComplete) input |= INPUT_RESTART;
+    return input;
+}
+
+// Both sides build the same opening state from the seed. The mini-games are
+// reset as well, since their state is in every snapshot.
+static bool StartCoopRun(void) {
+    sim.rng = coopSeed;
+    for (int d = DIFFICULTY_EASY; d <= DIFFICULTY_HARD; d++) ResetMiniGame(d);
+    sim.coop = true;
+    sim.selectedDifficulty = coopDifficulty;
+    StartRun(coopDifficulty);
+    // The revive mini-games are single-player
+    sim.secondChanceUsed = true;
+    // No transition: the run's textures are loaded straight away, as rock
+    // and Pikachu sizes feed the sim
+    sim.gameState = DIFFICULTY_TRANSITION;
+    UpdateAssetResidency();
+    EnterRun();
+    SnapshotPositions();
+    simAccumulator = 0.0f;
+
+    // Room for a flow field rebuild in every snapshot
+    if (!SaveGameState(&stateSnapshot) || !LoadRollbackSession(&coopSession, coopPlayer, stateSnapshot.size * 2)) {
+        TraceLog(LOG_WARNING, "COOP: Could not allocate the rollback window");
+        return false;
+    }
+    coopSession.save = SaveCoopFrame;
+    coopSession.load = LoadCoopFrame;
+    coopSession.step = StepCoopFrame;
+    coopSession.heldButtons = INPUT_HELD;
+    coopPhase = COOP_PLAYING;
+    TraceLog(LOG_INFO, "COOP: Playing as player %d, seed %u, difficulty %d", coopPlayer + 1, coopSeed, (int)coopDifficulty);
+    return true;
+}
+
+// Takes every packet waiting; the first one from the peer starts the run
+static bool ReceiveCoopPackets(void) {
+    CoopPacket packet;
+    int size;
+    while ((size = ReceiveNetPacket(&coopLink, &packet, (int)sizeof(packet))) > 0) {
+        if (size < COOP_HEADER_SIZE || packet.magic != COOP_MAGIC || packet.player != 1 - coopPlayer ||
+            packet.inputCount > COOP_MAX_INPUTS || size < COOP_HEADER_SIZE + packet.inputCount) continue;
+        if (coopPhase == COOP_CONNECTING) {
+            if (coopPlayer == 1) {
+                if (packet.difficulty > DIFFICULTY_HARD) continue;
+                coopSeed = packet.seed;
+                coopDifficulty = (Difficulty)packet.difficulty;
+            }
+            if (!StartCoopRun()) return false;
         }
+        AckLocalInput(&coopSession, packet.ackFrame);
+        coopSession.peerAdvantage = packet.advantage;
+        for (int k = 0; k < packet.inputCount; k++) AddRemoteInput(&coopSession, packet.firstFrame + k, packet.inputs[k]);
+        if (packet.checksumFrame >= 0) AddRemoteChecksum(&coopSession, packet.checksumFrame, packet.checksum);
+    }
+    return true;
+}
 
-        // ---------------- DRAW ----------------
-        BeginDrawing();
-        ClearBackground(RAYWHITE);
+// Sent once per rendered frame, also while waiting for the peer
+static void SendCoopPacket(double now) {
+    CoopPacket packet = {
+        .magic = COOP_MAGIC,
+        .player = (unsigned char)coopPlayer,
+        .difficulty = (unsigned char)coopDifficulty,
+        .seed = coopSeed,
+        .checksumFrame = -1,
+    };
+    if (coopPhase == COOP_PLAYING) {
+        int first = UnackedLocalFrame(&coopSession);
+        int count = coopSession.frame - first;
+        if (count > COOP_MAX_INPUTS) count = COOP_MAX_INPUTS;
+        packet.firstFrame = first;
+        packet.inputCount = (unsigned char)count;
+        for (int k = 0; k < count; k++) packet.inputs[k] = LocalInputAt(&coopSession, first + k);
+        packet.ackFrame = coopSession.remoteFrame;
+        packet.advantage = (signed char)Clamp((float)RollbackAdvantage(&coopSession), -127.0f, 127.0f);
+        packet.checksumFrame = ConfirmedRollbackFrame(&coopSession);
+        if (packet.checksumFrame >= 0) packet.checksum = GetRollbackChecksum(&coopSession, packet.checksumFrame);
+    }
+    SendNetPacket(&coopLink, &packet, COOP_HEADER_SIZE + packet.inputCount, now);
+}
 
-        switch (gameState) {
-            case OPENING_SCENE: {
-                if (homeBg.id != 0) {
-                    DrawTexturePro(
-                        homeBg,
-                        (Rectangle){0, 0, (float)homeBg.width, (float)homeBg.height},
-                        (Rectangle){0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()},
-                        (Vector2){0, 0}, 0.0f, WHITE
-                    );
-                } else {
-                    DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), DARKGRAY);
-                    DrawText("home.png missing!", GetScreenWidth()/2 - 100, GetScreenHeight()/2, 20, RED);
+// Runs the steps that are due, like the solo loop, but through the rollback
+// session. A step the session holds back for time sync still uses up its
+// time, so the side that is ahead slows down. Returns the steps due.
+static int UpdateCoop(void) {
+    double now = ProfilerTime();
+    if (!ReceiveCoopPackets()) {
+        coopPhase = COOP_OFF;
+        sim.coop = false;
+        CloseNetLink(&coopLink);
+        return 0;
+    }
+
+    int steps = 0;
+    coopFrameDepth = 0;
+    coopFrameResim = 0.0;
+    while (simAccumulator >= SIM_DT && steps < SIM_MAX_STEPS) {
+        simAccumulator -= SIM_DT;
+        steps++;
+        if (coopPhase != COOP_PLAYING) {
+            ClearLatchedInput();
+            continue;
+        }
+        if (RollbackShouldWait(&coopSession)) continue;
+        RollbackInput input = coopBot ? BotInput(coopSession.frame) : LocalPlayerInput();
+        AdvanceRollback(&coopSession, input);
+        ClearLatchedInput();
+        if (coopSession.depth > coopFrameDepth) coopFrameDepth = coopSession.depth;
+        coopFrameResim += coopSession.resimSeconds;
+    }
+
+    static bool desyncReported = false;
+    if (coopPhase == COOP_PLAYING && coopSession.desyncFrame >= 0 && !desyncReported) {
+        TraceLog(LOG_WARNING, "COOP: Desync at frame %d", coopSession.desyncFrame);
+        desyncReported = true;
+    }
+
+    SendCoopPacket(now);
+    FlushNetLink(&coopLink, now);
+    return steps;
+}
+
+// Parses the --coop arguments and opens the socket; the run starts once the
+// peer is heard from
+static bool StartCoop(int argc, char **argv) {
+    int player = (argc > 0) ? atoi(argv[0]) : 0;
+    if (player != 1 && player != 2) {
+        TraceLog(LOG_WARNING, "COOP: Usage: --coop 1|2 [--peer address] [--port N] [--difficulty easy|medium|hard] "
+                              "[--latency ms] [--jitter ms] [--loss percent] [--bot]");
+        return false;
+    }
+    coopPlayer = player - 1;
+    const char *peer = "127.0.0.1";
+    int port = COOP_PORT;
+    NetFaults faults = {0};
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bot") == 0) coopBot = true;
+        else if (i + 1 >= argc) break;
+        else if (strcmp(argv[i], "--peer") == 0) peer = argv[++i];
+        else if (strcmp(argv[i], "--port") == 0) port = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--latency") == 0) faults.latency = atof(argv[++i]) / 1000.0;
+        else if (strcmp(argv[i], "--jitter") == 0) faults.jitter = atof(argv[++i]) / 1000.0;
+        else if (strcmp(argv[i], "--loss") == 0) faults.loss = (float)atof(argv[++i]) / 100.0f;
+        else if (strcmp(argv[i], "--difficulty") == 0) {
+            i++;
+            coopDifficulty = (strcmp(argv[i], "easy") == 0) ? DIFFICULTY_EASY :
+                             (strcmp(argv[i], "hard") == 0) ? DIFFICULTY_HARD : DIFFICULTY_MEDIUM;
+        }
+    }
+
+    int localPort = port + coopPlayer;
+    int remotePort = port + 1 - coopPlayer;
+    if (!OpenNetLink(&coopLink, localPort, peer, remotePort)) {
+        TraceLog(LOG_WARNING, "COOP: Could not open UDP port %d for %s:%d", localPort, peer, remotePort);
+        return false;
+    }
+    faults.rng = (unsigned int)GetRandomValue(1, 0x7fffffff);
+    coopLink.faults = faults;
+    if (coopPlayer == 0) coopSeed = (unsigned int)GetRandomValue(1, 0x7fffffff);
+
+    ClearWindowState(FLAG_WINDOW_RESIZABLE);
+    coopPhase = COOP_CONNECTING;
+    TraceLog(LOG_INFO, "COOP: Player %d on port %d, waiting for %s:%d", player, localPort, peer, remotePort);
+    return true;
+}
+
+// Bottom left: rollback cost of the last rendered frame, the worst so far,
+// and how far the checksums agree
+static void DrawCoopStatus(void) {
+    int y = GetScreenHeight() - 50;
+    if (coopPhase == COOP_CONNECTING) {
+        DrawText(TextFormat("CO-OP: waiting for player %d...", 2 - coopPlayer), 20, y, 20, YELLOW);
+        return;
+    }
+    const RollbackSession *s = &coopSession;
+    DrawText(TextFormat("P%d  frame %d  ahead %d  rollback %d frames %.2f ms  (max %d, %.2f ms)  waits %d",
+                        coopPlayer + 1, s->frame, RollbackAdvantage(s), coopFrameDepth, coopFrameResim * 1000.0,
+                        s->maxDepth, s->maxResimSeconds * 1000.0, s->waits), 20, y, 10, WHITE);
+    if (s->desyncFrame >= 0) DrawText(TextFormat("DESYNC at frame %d", s->desyncFrame), 20, y + 15, 20, RED);
+    else DrawText(TextFormat("in sync to frame %d", s->checkedFrame), 20, y + 15, 10, LIME);
+}
+
+static void LogCoopStats(void) {
+    const RollbackSession *s = &coopSession;
+    if (coopPhase == COOP_PLAYING) {
+        double rollbacks = (s->rollbacks > 0) ? (double)s->rollbacks : 1.0;
+        TraceLog(LOG_INFO, "COOP: %d frames, %lld rollbacks, depth mean %.1f max %d, re-simulation mean %.3f ms max %.3f ms, %d waits",
+                 s->frame, s->rollbacks, s->resimulatedFrames / rollbacks, s->maxDepth,
+                 s->totalResimSeconds * 1000.0 / rollbacks, s->maxResimSeconds * 1000.0, s->waits);
+        if (s->desyncFrame >= 0) TraceLog(LOG_WARNING, "COOP: Desync at frame %d", s->desyncFrame);
+        else TraceLog(LOG_INFO, "COOP: In sync to frame %d", s->checkedFrame);
+    }
+    TraceLog(LOG_INFO, "COOP: %d packets sent (%d dropped), %d received", coopLink.sent, coopLink.dropped, coopLink.received);
+}
+
+// ------------ Game draw ------------
+// Sprites with equal layer and texture are drawn in depth order
+static void PushTintedSprite(DrawLayer layer, Texture2D texture, Rectangle dest, Vector2 origin, float rotation, unsigned int depth, Color tint) {
+    DrawCommand command = { texture, { 0, 0, (float)texture.width, (float)texture.height }, dest, origin, rotation, tint };
+    PushDrawCommand(&drawList, layer, depth, &command);
+}
+
+static void PushSprite(DrawLayer layer, Texture2D texture, Rectangle dest, Vector2 origin, float rotation, unsigned int depth) {
+    PushTintedSprite(layer, texture, dest, origin, rotation, depth, WHITE);
+}
+
+// Raichu while the thunderstone lasts; depth is the player number
+static void PushPlayer(Vector2 playerPos, Color tint, unsigned int depth) {
+    if (sim.thunderstoneEffectActive && raichuTex.id != 0) {
+        Rectangle destRec = { playerPos.x, playerPos.y, (float)pikachuTex.width, (float)pikachuTex.height };
+        Vector2 origin = { (float)pikachuTex.width/2, (float)pikachuTex.height/2 };
+        PushTintedSprite(LAYER_PLAYER, raichuTex, destRec, origin, 0.0f, depth, tint);
+    } else if (pikachuTex.id != 0) {
+        // Whole pixels, as DrawTexture places it
+        Rectangle destRec = { (float)(int)(playerPos.x - pikachuTex.width/2), (float)(int)(playerPos.y - pikachuTex.height/2),
+                              (float)pikachuTex.width, (float)pikachuTex.height };
+        PushTintedSprite(LAYER_PLAYER, pikachuTex, destRec, (Vector2){0, 0}, 0.0f, depth, tint);
+    }
+}
+
+// Power-ups are drawn POWERUP_WIDTH wide and centred; a missing texture
+// falls back to a lettered circle, drawn straight away
+static void PushPowerUp(Rectangle cull, Texture2D texture, Vector2 position, Color fallback, const char *letter) {
+    if (!CheckCollisionPointRec(position, cull)) return;
+    if (texture.id != 0) {
+        float height = POWERUP_WIDTH * (float)texture.height / (float)texture.width;
+        PushSprite(LAYER_POWERUPS, texture, (Rectangle){ position.x, position.y, POWERUP_WIDTH, height },
+                   (Vector2){ POWERUP_WIDTH / 2, height / 2 }, 0.0f, 0);
+    } else {
+        DrawCircleV(position, 50.0f, fallback);
+        DrawText(letter, (int)position.x - 20, (int)position.y - 24, 40, WHITE);
+    }
+}
+
+// Draws the sorted commands up to and including lastLayer, switching shaders
+// only where the sort put a change
+static void SubmitDrawList(DrawList *list, int lastLayer) {
+    unsigned int shader = 0;
+    for (; list->submitted < list->count; list->submitted++) {
+        if (DrawKeyLayer(list->keys[list->submitted]) > lastLayer) break;
+        const DrawCommand *c = &list->commands[list->order[list->submitted]];
+        if (c->shader.id != shader) {
+            if (c->shader.id != 0) BeginShaderMode(c->shader);
+            else EndShaderMode();
+            shader = c->shader.id;
+        }
+        DrawTexturePro(c->texture, c->source, c->dest, c->origin, c->rotation, c->tint);
+    }
+    if (shader != 0) EndShaderMode();
+}
+
+// Tiles the difficulty backdrop over the arena, mirroring every other tile so
+// neighbouring edges meet, and draws only the tiles the view overlaps
+static void DrawArenaBackground(Rectangle view) {
+    Texture2D bg = (sim.selectedDifficulty == DIFFICULTY_EASY) ? easyBg :
+                   (sim.selectedDifficulty == DIFFICULTY_MEDIUM) ? mediumBg : hardBg;
+    if (bg.id == 0) {
+        ClearBackground(sim.selectedDifficulty == DIFFICULTY_EASY ? GREEN :
+                       (sim.selectedDifficulty == DIFFICULTY_MEDIUM ? BLUE : RED));
+        return;
+    }
+
+    int cols = (int)ceilf(ARENA_WIDTH / ARENA_TILE_WIDTH);
+    int rows = (int)ceilf(ARENA_HEIGHT / ARENA_TILE_HEIGHT);
+    int x0 = (int)Clamp(floorf(view.x / ARENA_TILE_WIDTH), 0, cols - 1);
+    int x1 = (int)Clamp(floorf((view.x + view.width) / ARENA_TILE_WIDTH), 0, cols - 1);
+    int y0 = (int)Clamp(floorf(view.y / ARENA_TILE_HEIGHT), 0, rows - 1);
+    int y1 = (int)Clamp(floorf((view.y + view.height) / ARENA_TILE_HEIGHT), 0, rows - 1);
+    for (int ty = y0; ty <= y1; ty++) {
+        for (int tx = x0; tx <= x1; tx++) {
+            Rectangle source = { 0, 0, (float)bg.width, (float)bg.height };
+            if (tx % 2) source.width = -source.width;
+            if (ty % 2) source.height = -source.height;
+            DrawTexturePro(bg, source, (Rectangle){ tx * ARENA_TILE_WIDTH, ty * ARENA_TILE_HEIGHT, ARENA_TILE_WIDTH, ARENA_TILE_HEIGHT },
+                           (Vector2){0, 0}, 0.0f, WHITE);
+        }
+    }
+}
+
+// Player, bullets, enemies, power-ups and obstacles inside view, in world
+// coordinates. Pushed in slot order, they would alternate pokeball/ultra/master
+// textures and break the batch at nearly every enemy; sorted, each layer
+// costs one draw call per texture. Enemies and rocks come from their spatial
+// indexes, so the cost follows what is on screen rather than the arena size.
+static void DrawPlayfield(Rectangle view, Vector2 playerPos, Vector2 partnerPos, float alpha, bool withParticles) {
+    Rectangle cull = { view.x - VIEW_CULL_MARGIN, view.y - VIEW_CULL_MARGIN,
+                       view.width + 2 * VIEW_CULL_MARGIN, view.height + 2 * VIEW_CULL_MARGIN };
+    ClearDrawList(&drawList);
+
+    PushPlayer(playerPos, WHITE, 0);
+    // Player 2 is tinted so the two can be told apart
+    if (sim.coop) PushPlayer(partnerPos, (Color){ 170, 210, 255, 255 }, 1);
+
+    Texture2D bulletTex = sim.powerEffectActive ? specialBulletTex : normalBulletTex;
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        if (sim.bullets[i].active) {
+            Vector2 pos = InterpolatePosition(sim.bullets[i].previous, sim.bullets[i].position, alpha);
+            if (!CheckCollisionPointRec(pos, cull)) continue;
+            if (bulletTex.id != 0) {
+                float rotation = atan2f(sim.bullets[i].velocity.y, sim.bullets[i].velocity.x) * RAD2DEG;
+                Rectangle destRec = { pos.x - bulletTex.width / 2.0f, pos.y - bulletTex.height / 2.0f,
+                                      (float)bulletTex.width, (float)bulletTex.height };
+                PushSprite(LAYER_BULLETS, bulletTex, destRec, (Vector2){0, 0}, rotation, 0);
+            } else {
+                DrawCircleV(pos, 5, WHITE);
+            }
+        }
+    }
+
+    // The hash holds positions from the start of the last step; the cull
+    // margin covers the distance moved since. Slot order as depth keeps
+    // overlapping enemies stacked the same way every frame.
+    static int visible[MAX_ENEMIES];
+    int visibleCount = QuerySpatialHashRec(&enemyHash, cull, visible, MAX_ENEMIES);
+    for (int k = 0; k < visibleCount; k++) {
+        int i = visible[k];
+        if (!sim.enemies[i].active) continue;
+        Vector2 pos = InterpolatePosition(sim.enemies[i].previous, sim.enemies[i].position, alpha);
+        Texture2D enemyTex = (sim.enemies[i].type == 0) ? pokeballTex : (sim.enemies[i].type == 1) ? ultraBallTex : masterBallTex;
+        if (enemyTex.id != 0) {
+            Rectangle destRec = { (float)(int)(pos.x - enemyTex.width/2), (float)(int)(pos.y - enemyTex.height/2),
+                                  (float)enemyTex.width, (float)enemyTex.height };
+            PushSprite(LAYER_ENEMIES, enemyTex, destRec, (Vector2){0, 0}, 0.0f, (unsigned int)i);
+        }
+    }
+
+    if (sim.elixirAvailable) PushPowerUp(cull, elixirTex, sim.elixirPos, PURPLE, "E");
+    if (sim.thunderstoneAvailable) PushPowerUp(cull, thunderstoneTex, sim.thunderstonePos, ORANGE, "T");
+    if (sim.speedAvailable) PushPowerUp(cull, speedTex, sim.speedPos, BLUE, "S");
+    if (sim.powerAvailable) PushPowerUp(cull, powerTex, sim.powerPos, RED, "P");
+
+    if (sim.selectedDifficulty == DIFFICULTY_HARD && obstacleTex.id != 0) {
+        static int rocks[MAX_OBSTACLES];
+        int rockCount = QueryRectGridRec(&obstacleIndex, view, rocks, MAX_OBSTACLES);
+        for (int k = 0; k < rockCount; k++) {
+            PushSprite(LAYER_OBSTACLES, obstacleTex, obstacleIndex.rects[rocks[k]], (Vector2){0, 0}, 0.0f, (unsigned int)rocks[k]);
+        }
+    }
+
+    SortDrawList(&drawList);
+    SubmitDrawList(&drawList, LAYER_ENEMIES);
+    if (withParticles) DrawParticles(&particles, view);
+    SubmitDrawList(&drawList, LAYER_COUNT);
+}
+
+// Draws the active scene, alpha of the way from the previous sim step to the latest
+static void DrawGame(float alpha) {
+    Vector2 drawPlayerPos = InterpolatePosition(prevPlayerPos, sim.playerPos, alpha);
+    Vector2 drawPartnerPos = InterpolatePosition(prevPartnerPos, sim.partnerPos, alpha);
+    Vector2 drawBallPos = InterpolatePosition(prevBallPos, sim.ballPos, alpha);
+    // The camera follows the drawn player, so it scrolls as smoothly as the
+    // sprite moves; each co-op side follows its own
+    Rectangle view = ArenaView((sim.coop && coopPlayer == 1) ? drawPartnerPos : drawPlayerPos);
+    Camera2D camera = { .target = { view.x, view.y }, .zoom = 1.0f };
+
+    BeginDrawing();
+    ClearBackground(RAYWHITE);
+
+    switch (sim.gameState) {
+        case OPENING_SCENE: {
+            if (homeBg.id != 0) {
+                DrawTexturePro(
+                    homeBg,
+                    (Rectangle){0, 0, (float)homeBg.width, (float)homeBg.height},
+                    (Rectangle){0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()},
+                    (Vector2){0, 0}, 0.0f, WHITE
+                );
+            } else {
+                DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), DARKGRAY);
+                DrawText("home.png missing!", GetScreenWidth()/2 - 100, GetScreenHeight()/2, 20, RED);
+            }
+
+            if (logo.id != 0) {
+                float logoWidth = LOGO_WIDTH;
+                float logoHeight = logoWidth * (float)logo.height / (float)logo.width;
+                float logoX = GetScreenWidth()/2 - logoWidth/2;
+                float logoY = 50;
+                DrawTexturePro(logo, (Rectangle){0, 0, (float)logo.width, (float)logo.height},
+                               (Rectangle){logoX, logoY, logoWidth, logoHeight}, (Vector2){0, 0}, 0.0f, WHITE);
+            }
+
+            DrawTextEx(emojiFont, "Select Game Difficulty", (Vector2){GetScreenWidth()/2 - 160, 200}, 30, 2, WHITE);
+
+            DrawRectangleRec(easyBtn, sim.selectedDifficulty == DIFFICULTY_EASY ? LIME : LIGHTGRAY);
+            Vector2 textSize = MeasureTextEx(emojiFont, "Easy", 20, 2);
+            DrawTextEx(emojiFont, "Easy", 
+                      (Vector2){easyBtn.x + (easyBtn.width - textSize.x)/2, easyBtn.y + (easyBtn.height - textSize.y)/2}, 
+                      20, 2, DARKGRAY);
+
+            DrawRectangleRec(mediumBtn, sim.selectedDifficulty == DIFFICULTY_MEDIUM ? LIME : LIGHTGRAY);
+            textSize = MeasureTextEx(emojiFont, "Medium", 20, 2);
+            DrawTextEx(emojiFont, "Medium", 
+                      (Vector2){mediumBtn.x + (mediumBtn.width - textSize.x)/2, mediumBtn.y + (mediumBtn.height - textSize.y)/2}, 
+                      20, 2, DARKGRAY);
+
+            DrawRectangleRec(hardBtn, sim.selectedDifficulty == DIFFICULTY_HARD ? LIME : LIGHTGRAY);
+            textSize = MeasureTextEx(emojiFont, "Hard", 20, 2);
+            DrawTextEx(emojiFont, "Hard", 
+                      (Vector2){hardBtn.x + (hardBtn.width - textSize.x)/2, hardBtn.y + (hardBtn.height - textSize.y)/2}, 
+                      20, 2, DARKGRAY);
+
+            DrawRectangleRec(startBtn, SKYBLUE);
+            textSize = MeasureTextEx(emojiFont, "Start", 30, 2);
+            DrawTextEx(emojiFont, "Start", 
+                      (Vector2){startBtn.x + (startBtn.width - textSize.x)/2, startBtn.y + (startBtn.height - textSize.y)/2}, 
+                      30, 2, DARKBLUE);
+        } break;
+
+        case DIFFICULTY_TRANSITION: {
+            if (aoiTex.id != 0) {
+                float scale = fminf((float)GetScreenWidth() / aoiTex.width, (float)GetScreenHeight() / aoiTex.height);
+                float scaledWidth = aoiTex.width * scale;
+                float scaledHeight = aoiTex.height * scale;
+                float x = (GetScreenWidth() - scaledWidth) / 2.0f;
+                float y = (GetScreenHeight() - scaledHeight) / 2.0f;
+                DrawTexturePro(
+                    aoiTex,
+                    (Rectangle){0, 0, (float)aoiTex.width, (float)aoiTex.height},
+                    (Rectangle){x, y, scaledWidth, scaledHeight},
+                    (Vector2){0, 0}, 0.0f, WHITE
+                );
+            } else {
+                DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), DARKGRAY);
+                DrawText("aoi.png missing!", GetScreenWidth()/2 - 100, GetScreenHeight()/2, 20, RED);
+            }
+        } break;
+
+        case GAMEPLAY: {
+            // World layer through the camera; the text below stays on screen
+            float elixirProgress = 1.0f - (sim.elixirEffectTimer / ELIXIR_EFFECT_DURATION);
+            float thunderstoneProgress = 1.0f - (sim.thunderstoneEffectTimer / THUNDERSTONE_EFFECT_DURATION);
+            BeginMode2D(camera);
+                DrawArenaBackground(view);
+
+                if (sim.elixirEffectActive) {
+                    float radius = 10.0f + elixirProgress * 100.0f;
+                    Vector2 center = (sim.elixirUser == 1) ? drawPartnerPos : drawPlayerPos;
+                    DrawShockwave(center, radius, 20.0f * elixirProgress, 30, Fade(YELLOW, 1.0f - elixirProgress));
                 }
 
-                if (logo.id != 0) {
-                    float logoScale = 0.3f;
-                    float logoWidth = logo.width * logoScale;
-                    float logoHeight = logo.height * logoScale;
-                    float logoX = GetScreenWidth()/2 - logoWidth/2;
-                    float logoY = 50;
-                    DrawTextureEx(logo, (Vector2){logoX, logoY}, 0.0f, logoScale, WHITE);
+                if (sim.thunderstoneEffectActive) {
+                    float radius = 10.0f + thunderstoneProgress * 100.0f;
+                    DrawShockwave(drawPlayerPos, radius, 20.0f * thunderstoneProgress, 3, Fade(ORANGE, 1.0f - thunderstoneProgress));
                 }
 
-                DrawTextEx(emojiFont, "Select Game Difficulty", (Vector2){GetScreenWidth()/2 - 160, 200}, 30, 2, WHITE);
-
-                DrawRectangleRec(easyBtn, selectedDifficulty == DIFFICULTY_EASY ? LIME : LIGHTGRAY);
-                Vector2 textSize = MeasureTextEx(emojiFont, "Easy", 20, 2);
-                DrawTextEx(emojiFont, "Easy", 
-                          (Vector2){easyBtn.x + (easyBtn.width - textSize.x)/2, easyBtn.y + (easyBtn.height - textSize.y)/2}, 
-                          20, 2, DARKGRAY);
-
-                DrawRectangleRec(mediumBtn, selectedDifficulty == DIFFICULTY_MEDIUM ? LIME : LIGHTGRAY);
-                textSize = MeasureTextEx(emojiFont, "Medium", 20, 2);
-                DrawTextEx(emojiFont, "Medium", 
-                          (Vector2){mediumBtn.x + (mediumBtn.width - textSize.x)/2, mediumBtn.y + (mediumBtn.height - textSize.y)/2}, 
-                          20, 2, DARKGRAY);
-
-                DrawRectangleRec(hardBtn, selectedDifficulty == DIFFICULTY_HARD ? LIME : LIGHTGRAY);
-                textSize = MeasureTextEx(emojiFont, "Hard", 20, 2);
-                DrawTextEx(emojiFont, "Hard", 
-                          (Vector2){hardBtn.x + (hardBtn.width - textSize.x)/2, hardBtn.y + (hardBtn.height - textSize.y)/2}, 
-                          20, 2, DARKGRAY);
-
-                DrawRectangleRec(startBtn, SKYBLUE);
-                textSize = MeasureTextEx(emojiFont, "Start", 30, 2);
-                DrawTextEx(emojiFont, "Start", 
-                          (Vector2){startBtn.x + (startBtn.width - textSize.x)/2, startBtn.y + (startBtn.height - textSize.y)/2}, 
-                          30, 2, DARKBLUE);
-            } break;
-
-            case DIFFICULTY_TRANSITION: {
-                if (aoiTex.id != 0) {
-                    float scale = fminf((float)GetScreenWidth() / aoiTex.width, (float)GetScreenHeight() / aoiTex.height);
-                    float scaledWidth = aoiTex.width * scale;
-                    float scaledHeight = aoiTex.height * scale;
-                    float x = (GetScreenWidth() - scaledWidth) / 2.0f;
-                    float y = (GetScreenHeight() - scaledHeight) / 2.0f;
-                    DrawTexturePro(
-                        aoiTex,
-                        (Rectangle){0, 0, (float)aoiTex.width, (float)aoiTex.height},
-                        (Rectangle){x, y, scaledWidth, scaledHeight},
-                        (Vector2){0, 0}, 0.0f, WHITE
-                    );
-                } else {
-                    DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), DARKGRAY);
-                    DrawText("aoi.png missing!", GetScreenWidth()/2 - 100, GetScreenHeight()/2, 20, RED);
+                DrawPlayfield(view, drawPlayerPos, drawPartnerPos, alpha, true);
+            EndMode2D();
+
+            if (sim.elixirEffectActive) {
+                DrawTextEx(emojiFont, "ELIXIR ACTIVATED!", 
+                          (Vector2){GetScreenWidth()/2 - 120, GetScreenHeight()/2 - 30}, 
+                          30, 2, Fade(YELLOW, 1.0f - elixirProgress));
+            }
+
+            if (sim.thunderstoneEffectActive) {
+                DrawTextEx(emojiFont, "RAICHU EVOLVED!", 
+                          (Vector2){GetScreenWidth()/2 - 100, GetScreenHeight()/2 - 30}, 
+                          30, 2, Fade(ORANGE, 1.0f - thunderstoneProgress));
+            }
+
+            if (sim.elixirReady) {
+                DrawText("Elixir READY! Press S to clear enemies!", 20, 50, 18, WHITE);
+            }
+
+            if (sim.thunderstoneEffectActive) {
+                DrawText(TextFormat("RAICHU FORM: %.1f seconds left", sim.thunderstoneEffectTimer), 
+                        20, 80, 18, ORANGE);
+            }
+
+            if (sim.speedEffectActive) {
+                DrawText(TextFormat("SPEED BOOST: %.1f seconds left", sim.speedEffectTimer), 
+                        20, 110, 18, BLUE);
+            }
+
+            if (sim.powerEffectActive) {
+                DrawText(TextFormat("POWER BOOST: %.1f seconds left", sim.powerEffectTimer), 
+                        20, 140, 18, RED);
+            }
+
+            DrawTextEx(emojiFont, TextFormat("Score: %d", sim.score), (Vector2){20, 20}, 20, 2, WHITE);
+        } break;
+
+        case REVIVE_PROMPT: {
+            // Draw game state into render texture
+            FlushBatchForTarget();
+            BeginTextureMode(reviveTarget);
+                ClearBackground(RAYWHITE);
+                BeginMode2D(camera);
+                    DrawArenaBackground(view);
+                    DrawPlayfield(view, drawPlayerPos, drawPartnerPos, alpha, false);
+                EndMode2D();
+                if (sim.elixirReady) {
+                    DrawText("Elixir READY! Press S to clear enemies!", 20, 50, 18, WHITE);
+                }
+                if (sim.thunderstoneEffectActive) {
+                    DrawText(TextFormat("RAICHU FORM: %.1f seconds left", sim.thunderstoneEffectTimer), 
+                            20, 80, 18, ORANGE);
                 }
-            } break;
-
-            case GAMEPLAY: {
-                Texture2D currentBg;
-                switch(selectedDifficulty) {
-                    case DIFFICULTY_EASY: currentBg = easyBg; break;
-                    case DIFFICULTY_MEDIUM: currentBg = mediumBg; break;
-                    case DIFFICULTY_HARD: currentBg = hardBg; break;
+                if (sim.speedEffectActive) {
+                    DrawText(TextFormat("SPEED BOOST: %.1f seconds left", sim.speedEffectTimer), 
+                            20, 110, 18, BLUE);
                 }
-                
-                if (currentBg.id != 0) {
+                if (sim.powerEffectActive) {
+                    DrawText(TextFormat("POWER BOOST: %.1f seconds left", sim.powerEffectTimer), 
+                            20, 140, 18, RED);
+                }
+                DrawTextEx(emojiFont, TextFormat("Score: %d", sim.score), (Vector2){20, 20}, 20, 2, WHITE);
+            FlushBatchForTarget();
+            EndTextureMode();
+
+            // Draw to screen
+            ClearBackground(BLACK);
+            // Apply blur shader
+            BeginShaderMode(blurShader);
+                DrawTextureRec(reviveTarget.texture, 
+                              (Rectangle){0, 0, (float)reviveTarget.texture.width, -(float)reviveTarget.texture.height}, 
+                              (Vector2){0, 0}, WHITE);
+            EndShaderMode();
+            // Dim overlay
+            DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(BLACK, 0.5f));
+            // Title
+            Vector2 titleSize = MeasureTextEx(emojiFont, "Continue?", 60, 2);
+            DrawTextEx(emojiFont, "Continue?", 
+                      (Vector2){GetScreenWidth()/2 - titleSize.x/2, 120}, 
+                      60, 2, YELLOW);
+            // YES/NO with highlight boxes
+            if (sim.reviveChoice == 0) {
+                DrawRectangleRounded((Rectangle){280, 280, 200, 70}, 0.3f, 10, Fade(GREEN, 0.4f));
+                DrawTextEx(emojiFont, "YES", (Vector2){330, 300}, 40, 2, GREEN);
+                DrawTextEx(emojiFont, "NO", (Vector2){530, 300}, 40, 2, WHITE);
+            } else {
+                DrawRectangleRounded((Rectangle){480, 280, 200, 70}, 0.3f, 10, Fade(RED, 0.4f));
+                DrawTextEx(emojiFont, "YES", (Vector2){330, 300}, 40, 2, WHITE);
+                DrawTextEx(emojiFont, "NO", (Vector2){530, 300}, 40, 2, RED);
+            }
+            // Timer countdown
+            char buf[32];
+            sprintf(buf, "Time left: %d", (int)sim.reviveTimer);
+            Vector2 timerSize = MeasureTextEx(emojiFont, buf, 30, 2);
+            DrawTextEx(emojiFont, buf, 
+                      (Vector2){GetScreenWidth()/2 - timerSize.x/2, 400}, 
+                      30, 2, ORANGE);
+            Vector2 instructionSize = MeasureTextEx(emojiFont, "Use LEFT/RIGHT to choose, ENTER to confirm", 20, 2);
+            DrawTextEx(emojiFont, "Use LEFT/RIGHT to choose, ENTER to confirm", 
+                      (Vector2){GetScreenWidth()/2 - instructionSize.x/2, 520}, 
+                      20, 2, LIGHTGRAY);
+        } break;
+
+        case MINI_GAME: {
+            if (sim.selectedDifficulty == DIFFICULTY_EASY) {
+                if (ballsBg.id != 0) {
                     DrawTexturePro(
-                        currentBg,
-                        (Rectangle){0, 0, (float)currentBg.width, (float)currentBg.height},
+                        ballsBg,
+                        (Rectangle){0, 0, (float)ballsBg.width, (float)ballsBg.height},
                         (Rectangle){0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()},
                         (Vector2){0, 0}, 0.0f, WHITE
                     );
                 } else {
-                    ClearBackground(selectedDifficulty == DIFFICULTY_EASY ? GREEN : 
-                                   (selectedDifficulty == DIFFICULTY_MEDIUM ? BLUE : RED));
+                    ClearBackground(RAYWHITE);
                 }
 
-                if (elixirEffectActive) {
-                    float progress = 1.0f - (elixirEffectTimer / ELIXIR_EFFECT_DURATION);
-                    float radius = 10.0f + progress * 100.0f;
-                    int alpha = (int)(255 * (1.0f - progress));
-                    Color color = Fade(YELLOW, alpha/255.0f);
-                    
-                    for (int i = 0; i < 30; i++) {
-                        float offset = i * 20.0f * progress;
-                        DrawCircleLines((int)playerPos.x, (int)playerPos.y, radius - offset, color);
+                for (int i = 0; i < ballRain.capacity; i++) {
+                    if (ballRain.balls[i].active) {
+                        DrawCircleV(ballRain.balls[i].position, BALLS_RADIUS, ballRain.balls[i].color);
                     }
-                    
-                    DrawTextEx(emojiFont, "ELIXIR ACTIVATED!", 
-                              (Vector2){GetScreenWidth()/2 - 120, GetScreenHeight()/2 - 30}, 
-                              30, 2, Fade(YELLOW, alpha/255.0f));
                 }
 
-                if (thunderstoneEffectActive) {
-                    float progress = 1.0f - (thunderstoneEffectTimer / THUNDERSTONE_EFFECT_DURATION);
-                    float radius = 10.0f + progress * 100.0f;
-                    int alpha = (int)(255 * (1.0f - progress));
-                    Color color = Fade(ORANGE, alpha/255.0f);
-                    
-                    for (int i = 0; i < 3; i++) {
-                        float offset = i * 20.0f * progress;
-                        DrawCircleLines((int)playerPos.x, (int)playerPos.y, radius - offset, color);
-                    }
-                    
-                    DrawTextEx(emojiFont, "RAICHU EVOLVED!", 
-                              (Vector2){GetScreenWidth()/2 - 100, GetScreenHeight()/2 - 30}, 
-                              30, 2, Fade(ORANGE, alpha/255.0f));
+                float basketX = ballRain.basketX;
+                float basketY = ballRain.basketY;
+                float basketWidth = ballRain.basketWidth;
+             // Draw basket using PNG
+if (basketTex.id != 0) {
+// Display full original image, scaled to basketWidth while maintaining aspect ratio
+Rectangle sourceRec = { 0, 0, 
+                      (float)basketTex.width, 
+                      (float)basketTex.height };
+float aspectRatio = (float)basketTex.height / (float)basketTex.width;
+float scaledHeight = basketWidth * aspectRatio;
+Rectangle destRec = { basketX, basketY - scaledHeight, 
+                    basketWidth, scaledHeight };
+DrawTexturePro(
+    basketTex,
+    sourceRec,
+    destRec,
+    (Vector2){0, 0}, 0.0f, WHITE
+);
+} else {
+// Fallback if basket texture is missing
+DrawRectangle(basketX, basketY, basketWidth, sim.basketHeight, BROWN);
+Vector2 leftTriangle[3] = {
+    {basketX, basketY},
+    {basketX, basketY - sim.basketSideHeight},
+    {basketX + 25, basketY}
+};
+Vector2 rightTriangle[3] = {
+    {basketX + basketWidth, basketY},
+    {basketX + basketWidth, basketY - sim.basketSideHeight},
+    {basketX + basketWidth - 25, basketY}
+};
+DrawTriangle(leftTriangle[0], leftTriangle[1], leftTriangle[2], BROWN);
+DrawTriangle(rightTriangle[0], rightTriangle[1], rightTriangle[2], BROWN);
+}
+                DrawText(TextFormat("Score: %d / %d", ballRain.score, TARGET_SCORE), 10, 10, 20, BLACK);
+                DrawText(TextFormat("Misses: %d / %d", ballRain.misses, MAX_MISSES), 10, 40, 20, BLACK);
+            } else if (sim.selectedDifficulty == DIFFICULTY_MEDIUM) {
+                ClearBackground(BLACK);
+                DrawText("Wordle Mini-Game: Guess the 5-letter word", 100, 20, 24, WHITE);
+                DrawText("Type letters, BACKSPACE to delete, ENTER to submit, TAB for a hint", 100, 50, 18, WHITE);
+                if (sim.wordleNoticeTimer > 0.0f) {
+                    DrawText("Not in word list", GetScreenWidth()/2 - MeasureText("Not in word list", 20)/2, 80, 20, RED);
                 }
-
-                if (thunderstoneEffectActive && raichuTex.id != 0) {
-                    Rectangle srcRec = { 0, 0, (float)raichuTex.width, (float)raichuTex.height };
-                    Rectangle destRec = { playerPos.x, playerPos.y, (float)pikachuTex.width, (float)pikachuTex.height };
-                    Vector2 origin = { (float)pikachuTex.width/2, (float)pikachuTex.height/2 };
-                    DrawTexturePro(raichuTex, srcRec, destRec, origin, 0.0f, WHITE);
-                } else if (pikachuTex.id != 0) {
-                    DrawTexture(pikachuTex, playerPos.x - pikachuTex.width/2, playerPos.y - pikachuTex.height/2, WHITE);
+                if (sim.wordleHintShown && !sim.wordleWon && sim.currentGuess < MAX_GUESSES) {
+                    const char *hintText = "No hint available";
+                    if (sim.wordleHint.guess != 0) {
+                        char word[WORD_LENGTH + 1];
+                        UnpackWord(sim.wordleHint.guess, word);
+                        hintText = TextFormat("Hint: %s  (%.2f bits, %d words left, %.0f ms)", word,
+                                              sim.wordleHint.entropy, sim.wordleHint.candidates, wordleHintTime * 1000.0);
+                    }
+                    DrawText(hintText, GetScreenWidth()/2 - MeasureText(hintText, 20)/2, 110, 20, GOLD);
                 }
 
-                for (int i = 0; i < MAX_BULLETS; i++) {
-                    if (bullets[i].active) {
-                        Texture2D bulletTex = powerEffectActive ? specialBulletTex : normalBulletTex;
-                        if (bulletTex.id != 0) {
-                            float rotation = atan2f(bullets[i].velocity.y, bullets[i].velocity.x) * RAD2DEG;
-                            DrawTextureEx(bulletTex, (Vector2){bullets[i].position.x - bulletTex.width / 2.0f, bullets[i].position.y - bulletTex.height / 2.0f}, rotation, 1.0f, WHITE);
-                        } else {
-                            DrawCircleV(bullets[i].position, 5, WHITE);
+                const int boxSize = 60;
+                const int spacing = 5;
+                int startX = (GetScreenWidth() - (WORD_LENGTH * boxSize + (WORD_LENGTH - 1) * spacing)) / 2;
+                int startY = (GetScreenHeight() - (MAX_GUESSES * boxSize + (MAX_GUESSES - 1) * spacing)) / 2 + 50;
+
+                for (int row = 0; row < MAX_GUESSES; row++) {
+                    for (int col = 0; col < WORD_LENGTH; col++) {
+                        int x = startX + col * (boxSize + spacing);
+                        int y = startY + row * (boxSize + spacing);
+                        Color bgColor = LIGHTGRAY;
+                        char letter = '\0';
+
+                        if (row < sim.currentGuess) {
+                            bgColor = sim.guessColors[row][col];
+                            letter = sim.guesses[row][col];
+                        } else if (row == sim.currentGuess && col < sim.currentLetter) {
+                            bgColor = WHITE;
+                            letter = sim.guesses[row][col];
                         }
-                    }
-                }
 
-                for (int i = 0; i < MAX_ENEMIES; i++) {
-                    if (enemies[i].active) {
-                        Texture2D enemyTex = (enemies[i].type == 0) ? pokeballTex : (enemies[i].type == 1) ? ultraBallTex : masterBallTex;
-                        if (enemyTex.id != 0) {
-                            DrawTexture(enemyTex, enemies[i].position.x - enemyTex.width/2, enemies[i].position.y - enemyTex.height/2, WHITE);
+                        DrawRectangle(x, y, boxSize, boxSize, bgColor);
+                        DrawRectangleLines(x, y, boxSize, boxSize, BLACK);
+
+                        if (letter != '\0') {
+                            DrawText(TextFormat("%c", letter), x + boxSize/2 - 10, y + boxSize/2 - 20, 40, BLACK);
                         }
                     }
                 }
 
-                if (elixirAvailable) {
-                    if (elixirTex.id != 0) {
-                        float elixirWidth = 100.0f;
-                        float elixirHeight = elixirWidth * (float)elixirTex.height / (float)elixirTex.width;
-                        DrawTexturePro(
-                            elixirTex,
-                            (Rectangle){0, 0, (float)elixirTex.width, (float)elixirTex.height},
-                            (Rectangle){elixirPos.x, elixirPos.y, elixirWidth, elixirHeight},
-                            (Vector2){elixirWidth/2, elixirHeight/2}, 0.0f, WHITE
-                        );
-                    } else {
-                        DrawCircleV(elixirPos, 50.0f, PURPLE);
-                        DrawText("E", (int)elixirPos.x - 20, (int)elixirPos.y - 24, 40, WHITE);
-                    }
+                if (sim.currentGuess == MAX_GUESSES && !sim.wordleWon) {
+                    DrawText(TextFormat("The word was: %s", sim.targetWord), 100, GetScreenHeight() - 50, 20, RED);
                 }
-
-                if (thunderstoneAvailable) {
-                    if (thunderstoneTex.id != 0) {
-                        float thunderstoneWidth = 100.0f;
-                        float thunderstoneHeight = thunderstoneWidth * (float)thunderstoneTex.height / (float)thunderstoneTex.width;
-                        DrawTexturePro(
-                            thunderstoneTex,
-                            (Rectangle){0, 0, (float)thunderstoneTex.width, (float)thunderstoneTex.height},
-                            (Rectangle){thunderstonePos.x, thunderstonePos.y, thunderstoneWidth, thunderstoneHeight},
-                            (Vector2){thunderstoneWidth/2, thunderstoneHeight/2}, 0.0f, WHITE
-                        );
-                    } else {
-                        DrawCircleV(thunderstonePos, 50.0f, ORANGE);
-                        DrawText("T", (int)thunderstonePos.x - 20, (int)thunderstonePos.y - 24, 40, WHITE);
-                    }
+            } else {
+                if (bowlingBg.id != 0) {
+                    DrawTexturePro(bowlingBg,
+                                   (Rectangle){0,0,(float)bowlingBg.width,(float)bowlingBg.height},
+                                   (Rectangle){0,0,(float)GetScreenWidth(),(float)GetScreenHeight()},
+                                   (Vector2){0,0}, 0.0f, WHITE);
+                } else {
+                    ClearBackground(DARKGREEN);
+                    DrawRectangle(LANE_LEFT - 20, 60, (LANE_RIGHT - LANE_LEFT) + 40, GetScreenHeight() - 120, BROWN);
                 }
 
-                if (speedAvailable) {
-                    if (speedTex.id != 0) {
-                        float speedWidth = 100.0f;
-                        float speedHeight = speedWidth * (float)speedTex.height / (float)speedTex.width;
-                        DrawTexturePro(
-                            speedTex,
-                            (Rectangle){0, 0, (float)speedTex.width, (float)speedTex.height},
-                            (Rectangle){speedPos.x, speedPos.y, speedWidth, speedHeight},
-                            (Vector2){speedWidth/2, speedHeight/2}, 0.0f, WHITE
-                        );
-                    } else {
-                        DrawCircleV(speedPos, 50.0f, BLUE);
-                        DrawText("S", (int)speedPos.x - 20, (int)speedPos.y - 24, 40, WHITE);
-                    }
-                }
+                DrawText("SECOND CHANCE! Score a STRIKE to revive!", 140, 20, 24, WHITE);
+                DrawText(TextFormat("Angle: LEFT/RIGHT | Power: Hold SPACE | P: Rack (%d pins)", sim.bowl.pinCount), 120, 50, 18, WHITE);
 
-                if (powerAvailable) {
-                    if (powerTex.id != 0) {
-                        float powerWidth = 100.0f;
-                        float powerHeight = powerWidth * (float)powerTex.height / (float)powerTex.width;
-                        DrawTexturePro(
-                            powerTex,
-                            (Rectangle){0, 0, (float)powerTex.width, (float)powerTex.height},
-                            (Rectangle){powerPos.x, powerPos.y, powerWidth, powerHeight},
-                            (Vector2){powerWidth/2, powerHeight/2}, 0.0f, WHITE
-                        );
-                    } else {
-                        DrawCircleV(powerPos, 50.0f, RED);
-                        DrawText("P", (int)powerPos.x - 20, (int)powerPos.y - 24, 40, WHITE);
-                    }
+                for (int i = 0; i < sim.bowl.pinCount; i++) {
+                    const RigidCircle *body = &pinWorld.bodies[sim.bowl.pins[i].body];
+                    if (!body->active) continue;
+                    DrawCircleV(body->position, PIN_RADIUS, sim.bowl.pins[i].fallen ? Fade(LIGHTGRAY, 0.6f) : WHITE);
+                    DrawCircleV(body->position, 8, sim.bowl.pins[i].fallen ? Fade(MAROON, 0.6f) : RED);
                 }
 
-                if (elixirReady) {
-                    DrawText("Elixir READY! Press S to clear enemies!", 20, 50, 18, WHITE);
-                }
+                DrawParticles(&particles, (Rectangle){0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()});
 
-                if (selectedDifficulty == DIFFICULTY_HARD) {
-                    for (int i = 0; i < MAX_OBSTACLES; i++) {
-                        if (obstacles[i].active && obstacleTex.id != 0) {
-                            Rectangle src = {0, 0, (float)obstacleTex.width, (float)obstacleTex.height};
-                            Rectangle dst = obstacles[i].rect;
-                            DrawTexturePro(obstacleTex, src, dst, (Vector2){0,0}, 0.0f, WHITE);
-                        }
-                    }
-                }
+                DrawCircleV(drawBallPos, BOWLING_BALL_RADIUS, BLUE);
 
-                if (thunderstoneEffectActive) {
-                    DrawText(TextFormat("RAICHU FORM: %.1f seconds left", thunderstoneEffectTimer), 
-                            20, 80, 18, ORANGE);
+                if (!sim.bowl.launched) {
+                    Vector2 guideEnd = {drawBallPos.x + 50 * sinf(sim.throwAngle), drawBallPos.y - 50 * cosf(sim.throwAngle)};
+                    DrawLineEx(drawBallPos, guideEnd, 2, DARKBLUE);
                 }
 
-                if (speedEffectActive) {
-                    DrawText(TextFormat("SPEED BOOST: %.1f seconds left", speedEffectTimer), 
-                            20, 110, 18, BLUE);
+                if (sim.charging) {
+                    DrawRectangle(50, GetScreenHeight() - 40, (int)(200 * (sim.power / maxPower)), 20, GREEN);
+                    DrawRectangleLines(50, GetScreenHeight() - 40, 200, 20, BLACK);
                 }
+            }
+        } break;
+
+        case CLOSING_SCENE: {
+            if (homeBg.id != 0) {
+                DrawTexturePro(
+                    homeBg,
+                    (Rectangle){0, 0, (float)homeBg.width, (float)homeBg.height},
+                    (Rectangle){0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()},
+                    (Vector2){0, 0}, 0.0f, WHITE
+                );
+            } else {
+                ClearBackground(BLACK);
+            }
+            
+            if (balhTex.id != 0) {
+                DrawTexture(balhTex, GetScreenWidth()/2 - balhTex.width/2, GetScreenHeight()/2 - balhTex.height - 50, WHITE);
+            }
+            
+            const char* message = "OOPS THE POKEMON IS CAPTURED!";
+            Vector2 textSize = MeasureTextEx(emojiFont, message, 40 * sim.gameOverScale, 2);
+            DrawTextEx(emojiFont, message, 
+                      (Vector2){GetScreenWidth()/2 - textSize.x/2, GetScreenHeight()/2 - 50}, 
+                      40 * sim.gameOverScale, 2, RED);
+
+            if (sim.animationComplete) {
+                const char* replayText = "Press R to Replay";
+                const char* homeText = "Press H to go to Home Menu";
+                
+                Vector2 replaySize = MeasureTextEx(emojiFont, replayText, 20, 2);
+                Vector2 homeSize = MeasureTextEx(emojiFont, homeText, 20, 2);
+                
+                DrawTextEx(emojiFont, replayText, 
+                          (Vector2){GetScreenWidth()/2 - replaySize.x/2, GetScreenHeight()/2 + 30}, 
+                          20, 2, WHITE);
+                // Co-op has no menu to go back to
+                if (!sim.coop) DrawTextEx(emojiFont, homeText, 
+                          (Vector2){GetScreenWidth()/2 - homeSize.x/2, GetScreenHeight()/2 + 60}, 
+                          20, 2, WHITE);
+            }
+        } break;
+    }
 
-                if (powerEffectActive) {
-                    DrawText(TextFormat("POWER BOOST: %.1f seconds left", powerEffectTimer), 
-                            20, 140, 18, RED);
-                }
+    if (profilerVisible) DrawProfilerOverlay();
+    if (coopPhase != COOP_OFF) DrawCoopStatus();
+    if (timeScale != 1.0f) DrawText(TextFormat("TIME x%.3g", timeScale), GetScreenWidth() - 110, 10, 20, YELLOW);
 
-                DrawTextEx(emojiFont, TextFormat("Score: %d", score), (Vector2){20, 20}, 20, 2, WHITE);
-            } break;
+    EndDrawing();
+    FinishBatchFrame();
+}
 
-            case REVIVE_PROMPT: {
-                // Draw game state into render texture
-                BeginTextureMode(reviveTarget);
-                    ClearBackground(RAYWHITE);
-                    Texture2D currentBg;
-                    switch(selectedDifficulty) {
-                        case DIFFICULTY_EASY: currentBg = easyBg; break;
-                        case DIFFICULTY_MEDIUM: currentBg = mediumBg; break;
-                        case DIFFICULTY_HARD: currentBg = hardBg; break;
-                    }
-                    if (currentBg.id != 0) {
-                        DrawTexturePro(
-                            currentBg,
-                            (Rectangle){0, 0, (float)currentBg.width, (float)currentBg.height},
-                            (Rectangle){0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()},
-                            (Vector2){0, 0}, 0.0f, WHITE
-                        );
-                    } else {
-                        ClearBackground(selectedDifficulty == DIFFICULTY_EASY ? GREEN : 
-                                       (selectedDifficulty == DIFFICULTY_MEDIUM ? BLUE : RED));
-                    }
-                    if (thunderstoneEffectActive && raichuTex.id != 0) {
-                        Rectangle srcRec = { 0, 0, (float)raichuTex.width, (float)raichuTex.height };
-                        Rectangle destRec = { playerPos.x, playerPos.y, (float)pikachuTex.width, (float)pikachuTex.height };
-                        Vector2 origin = { (float)pikachuTex.width/2, (float)pikachuTex.height/2 };
-                        DrawTexturePro(raichuTex, srcRec, destRec, origin, 0.0f, WHITE);
-                    } else if (pikachuTex.id != 0) {
-                        DrawTexture(pikachuTex, playerPos.x - pikachuTex.width/2, playerPos.y - pikachuTex.height/2, WHITE);
-                    }
-                    for (int i = 0; i < MAX_BULLETS; i++) {
-                        if (bullets[i].active) {
-                            Texture2D bulletTex = powerEffectActive ? specialBulletTex : normalBulletTex;
-                            if (bulletTex.id != 0) {
-                                float rotation = atan2f(bullets[i].velocity.y, bullets[i].velocity.x) * RAD2DEG;
-                                DrawTextureEx(bulletTex, (Vector2){bullets[i].position.x - bulletTex.width / 2.0f, bullets[i].position.y - bulletTex.height / 2.0f}, rotation, 1.0f, WHITE);
-                            } else {
-                                DrawCircleV(bullets[i].position, 5, WHITE);
-                            }
-                        }
-                    }
-                    for (int i = 0; i < MAX_ENEMIES; i++) {
-                        if (enemies[i].active) {
-                            Texture2D enemyTex = (enemies[i].type == 0) ? pokeballTex : (enemies[i].type == 1) ? ultraBallTex : masterBallTex;
-                            if (enemyTex.id != 0) {
-                                DrawTexture(enemyTex, enemies[i].position.x - enemyTex.width/2, enemies[i].position.y - enemyTex.height/2, WHITE);
-                            }
-                        }
-                    }
-                    if (elixirAvailable) {
-                        if (elixirTex.id != 0) {
-                            float elixirWidth = 100.0f;
-                            float elixirHeight = elixirWidth * (float)elixirTex.height / (float)elixirTex.width;
-                            DrawTexturePro(
-                                elixirTex,
-                                (Rectangle){0, 0, (float)elixirTex.width, (float)elixirTex.height},
-                                (Rectangle){elixirPos.x, elixirPos.y, elixirWidth, elixirHeight},
-                                (Vector2){elixirWidth/2, elixirHeight/2}, 0.0f, WHITE
-                            );
-                        } else {
-                            DrawCircleV(elixirPos, 50.0f, PURPLE);
-                            DrawText("E", (int)elixirPos.x - 20, (int)elixirPos.y - 24, 40, WHITE);
-                        }
-                    }
-                    if (thunderstoneAvailable) {
-                        if (thunderstoneTex.id != 0) {
-                            float thunderstoneWidth = 100.0f;
-                            float thunderstoneHeight = thunderstoneWidth * (float)thunderstoneTex.height / (float)thunderstoneTex.width;
-                            DrawTexturePro(
-                                thunderstoneTex,
-                                (Rectangle){0, 0, (float)thunderstoneTex.width, (float)thunderstoneTex.height},
-                                (Rectangle){thunderstonePos.x, thunderstonePos.y, thunderstoneWidth, thunderstoneHeight},
-                                (Vector2){thunderstoneWidth/2, thunderstoneHeight/2}, 0.0f, WHITE
-                            );
-                        } else {
-                            DrawCircleV(thunderstonePos, 50.0f, ORANGE);
-                            DrawText("T", (int)thunderstonePos.x - 20, (int)thunderstonePos.y - 24, 40, WHITE);
-                        }
-                    }
-                    if (speedAvailable) {
-                        if (speedTex.id != 0) {
-                            float speedWidth = 100.0f;
-                            float speedHeight = speedWidth * (float)speedTex.height / (float)speedTex.width;
-                            DrawTexturePro(
-                                speedTex,
-                                (Rectangle){0, 0, (float)speedTex.width, (float)speedTex.height},
-                                (Rectangle){speedPos.x, speedPos.y, speedWidth, speedHeight},
-                                (Vector2){speedWidth/2, speedHeight/2}, 0.0f, WHITE
-                            );
-                        } else {
-                            DrawCircleV(speedPos, 50.0f, BLUE);
-                            DrawText("S", (int)speedPos.x - 20, (int)speedPos.y - 24, 40, WHITE);
-                        }
-                    }
-                    if (powerAvailable) {
-                        if (powerTex.id != 0) {
-                            float powerWidth = 100.0f;
-                            float powerHeight = powerWidth * (float)powerTex.height / (float)powerTex.width;
-                            DrawTexturePro(
-                                powerTex,
-                                (Rectangle){0, 0, (float)powerTex.width, (float)powerTex.height},
-                                (Rectangle){powerPos.x, powerPos.y, powerWidth, powerHeight},
-                                (Vector2){powerWidth/2, powerHeight/2}, 0.0f, WHITE
-                            );
-                        } else {
-                            DrawCircleV(powerPos, 50.0f, RED);
-                            DrawText("P", (int)powerPos.x - 20, (int)powerPos.y - 24, 40, WHITE);
-                        }
-                    }
-                    if (elixirReady) {
-                        DrawText("Elixir READY! Press S to clear enemies!", 20, 50, 18, WHITE);
-                    }
-                    if (selectedDifficulty == DIFFICULTY_HARD) {
-                        for (int i = 0; i < MAX_OBSTACLES; i++) {
-                            if (obstacles[i].active && obstacleTex.id != 0) {
-                                Rectangle src = {0, 0, (float)obstacleTex.width, (float)obstacleTex.height};
-                                Rectangle dst = obstacles[i].rect;
-                                DrawTexturePro(obstacleTex, src, dst, (Vector2){0,0}, 0.0f, WHITE);
-                            }
-                        }
-                    }
-                    if (thunderstoneEffectActive) {
-                        DrawText(TextFormat("RAICHU FORM: %.1f seconds left", thunderstoneEffectTimer), 
-                                20, 80, 18, ORANGE);
-                    }
-                    if (speedEffectActive) {
-                        DrawText(TextFormat("SPEED BOOST: %.1f seconds left", speedEffectTimer), 
-                                20, 110, 18, BLUE);
-                    }
-                    if (powerEffectActive) {
-                        DrawText(TextFormat("POWER BOOST: %.1f seconds left", powerEffectTimer), 
-                                20, 140, 18, RED);
-                    }
-                    DrawTextEx(emojiFont, TextFormat("Score: %d", score), (Vector2){20, 20}, 20, 2, WHITE);
-                EndTextureMode();
+// ------------ Scenario benchmarks ------------
+// a.exe --bench [scenario] [--frames N] [--json file] [--baseline file|none] [--threshold percent]
+// Each scenario builds its game state directly and runs one sim step plus one
+// unpaced draw per frame. The frames are split into batches that each start
+// from a fresh copy of the scenario; the 95% confidence interval comes from
+// the spread of the batch means. Every run is checked against the committed
+// scenarios_baseline.json (recorded with the NULL_RENDER build) unless
+// another baseline, or none, is given, and is written to scenarios.json,
+// which git ignores; copy that over the baseline to accept new numbers.
+// Times only compare on the machine that recorded them. Exits with 1 when a
+// scenario is slower than the baseline by more than the threshold and their
+// confidence intervals do not overlap. With RLGL_BATCH_STATS, flushes, draw
+// calls and vertices per frame are reported too, and a scenario that
+// flushes or draws more often than its baseline fails as a batching
+// regression. Built with NULL_RENDER the draw time is rlgl batching alone,
+// and texture binds per frame are added. The state each scenario ends in is
+// then snapshotted and restored repeatedly to time the save-state path.
+#define SCENARIO_BATCHES 10
+#define SCENARIO_T95 2.262           // Student's t, 95%, SCENARIO_BATCHES - 1 degrees of freedom
+#define SCENARIO_DEFAULT_FRAMES 1200
+#define SCENARIO_MAX_NAME 32
+#define SCENARIO_BATCH_SLACK 0.5     // flushes or draw calls per frame over the baseline that still pass
+#define SCENARIO_SNAPSHOTS 200
+#define SCENARIO_BASELINE "scenarios_baseline.json"
 
-                // Draw to screen
-                ClearBackground(BLACK);
-                // Apply blur shader
-                BeginShaderMode(blurShader);
-                    DrawTextureRec(reviveTarget.texture, 
-                                  (Rectangle){0, 0, (float)reviveTarget.texture.width, -(float)reviveTarget.texture.height}, 
-                                  (Vector2){0, 0}, WHITE);
-                EndShaderMode();
-                // Dim overlay
-                DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), Fade(BLACK, 0.5f));
-                // Title
-                Vector2 titleSize = MeasureTextEx(emojiFont, "Continue?", 60, 2);
-                DrawTextEx(emojiFont, "Continue?", 
-                          (Vector2){GetScreenWidth()/2 - titleSize.x/2, 120}, 
-                          60, 2, YELLOW);
-                // YES/NO with highlight boxes
-                if (reviveChoice == 0) {
-                    DrawRectangleRounded((Rectangle){280, 280, 200, 70}, 0.3f, 10, Fade(GREEN, 0.4f));
-                    DrawTextEx(emojiFont, "YES", (Vector2){330, 300}, 40, 2, GREEN);
-                    DrawTextEx(emojiFont, "NO", (Vector2){530, 300}, 40, 2, WHITE);
-                } else {
-                    DrawRectangleRounded((Rectangle){480, 280, 200, 70}, 0.3f, 10, Fade(RED, 0.4f));
-                    DrawTextEx(emojiFont, "YES", (Vector2){330, 300}, 40, 2, WHITE);
-                    DrawTextEx(emojiFont, "NO", (Vector2){530, 300}, 40, 2, RED);
-                }
-                // Timer countdown
-                char buf[32];
-                sprintf(buf, "Time left: %d", reviveTimer / 60);
-                Vector2 timerSize = MeasureTextEx(emojiFont, buf, 30, 2);
-                DrawTextEx(emojiFont, buf, 
-                          (Vector2){GetScreenWidth()/2 - timerSize.x/2, 400}, 
-                          30, 2, ORANGE);
-                Vector2 instructionSize = MeasureTextEx(emojiFont, "Use LEFT/RIGHT to choose, ENTER to confirm", 20, 2);
-                DrawTextEx(emojiFont, "Use LEFT/RIGHT to choose, ENTER to confirm", 
-                          (Vector2){GetScreenWidth()/2 - instructionSize.x/2, 520}, 
-                          20, 2, LIGHTGRAY);
-            } break;
-
-            case MINI_GAME: {
-                if (selectedDifficulty == DIFFICULTY_EASY) {
-                    if (ballsBg.id != 0) {
-                        DrawTexturePro(
-                            ballsBg,
-                            (Rectangle){0, 0, (float)ballsBg.width, (float)ballsBg.height},
-                            (Rectangle){0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()},
-                            (Vector2){0, 0}, 0.0f, WHITE
-                        );
-                    } else {
-                        ClearBackground(RAYWHITE);
-                    }
+typedef struct {
+    const char *name;
+    void (*setup)(void);
+    void (*input)(int frame);   // latches scripted input before a step, may be NULL
+} Scenario;
 
-                    for (int i = 0; i < MAX_BALLS; i++) {
-                        if (balls[i].active) {
-                            DrawCircleV(balls[i].position, BALLS_RADIUS, balls[i].color);
-                        }
-                    }
+typedef struct {
+    const char *name;
+    double meanNs;
+    double ci95Ns;
+    double updateNs;
+    double drawNs;
+    double snapshotNs;
+    double restoreNs;
+    int snapshotBytes;
+#ifdef RLGL_BATCH_STATS
+    double flushes;
+    double drawCalls;
+    double vertices;
+#endif
+#ifdef NULL_RENDER
+    double textureBinds;
+#endif
+} ScenarioResult;
+
+static void BeginScenario(Difficulty difficulty, GameState state) {
+    sim.rng = 1234;
+    LayoutMenuButtons();
+    sim.selectedDifficulty = difficulty;
+    StartRun(difficulty);
+    sim.gameState = state;
+    UpdateAssetResidency();
+    if (difficulty == DIFFICULTY_HARD) SpawnObstacles();
+}
 
-                 // Draw basket using PNG
-if (basketTex.id != 0) {
-    // Display full original image, scaled to basketWidth while maintaining aspect ratio
-    Rectangle sourceRec = { 0, 0, 
-                          (float)basketTex.width, 
-                          (float)basketTex.height };
-    float aspectRatio = (float)basketTex.height / (float)basketTex.width;
-    float scaledHeight = basketWidth * aspectRatio;
-    Rectangle destRec = { basketX, basketY - scaledHeight, 
-                        basketWidth, scaledHeight };
-    DrawTexturePro(
-        basketTex,
-        sourceRec,
-        destRec,
-        (Vector2){0, 0}, 0.0f, WHITE
-    );
-} else {
-    // Fallback if basket texture is missing
-    DrawRectangle(basketX, basketY, basketWidth, basketHeight, BROWN);
-    Vector2 leftTriangle[3] = {
-        {basketX, basketY},
-        {basketX, basketY - basketSideHeight},
-        {basketX + 25, basketY}
-    };
-    Vector2 rightTriangle[3] = {
-        {basketX + basketWidth, basketY},
-        {basketX + basketWidth, basketY - basketSideHeight},
-        {basketX + basketWidth - 25, basketY}
-    };
-    DrawTriangle(leftTriangle[0], leftTriangle[1], leftTriangle[2], BROWN);
-    DrawTriangle(rightTriangle[0], rightTriangle[1], rightTriangle[2], BROWN);
-}
-                    DrawText(TextFormat("Score: %d / %d", ballScore, TARGET_SCORE), 10, 10, 20, BLACK);
-                    DrawText(TextFormat("Misses: %d / %d", misses, MAX_MISSES), 10, 40, 20, BLACK);
-                } else if (selectedDifficulty == DIFFICULTY_MEDIUM) {
-                    ClearBackground(BLACK);
-                    DrawText("Wordle Mini-Game: Guess the 5-letter word", 100, 20, 24, WHITE);
-                    DrawText("Type letters, BACKSPACE to delete, ENTER to submit", 100, 50, 18, WHITE);
-
-                    const int boxSize = 60;
-                    const int spacing = 5;
-                    int startX = (GetScreenWidth() - (WORD_LENGTH * boxSize + (WORD_LENGTH - 1) * spacing)) / 2;
-                    int startY = (GetScreenHeight() - (MAX_GUESSES * boxSize + (MAX_GUESSES - 1) * spacing)) / 2 + 50;
-
-                    for (int row = 0; row < MAX_GUESSES; row++) {
-                        for (int col = 0; col < WORD_LENGTH; col++) {
-                            int x = startX + col * (boxSize + spacing);
-                            int y = startY + row * (boxSize + spacing);
-                            Color bgColor = LIGHTGRAY;
-                            char letter = '\0';
-
-                            if (row < currentGuess) {
-                                bgColor = guessColors[row][col];
-                                letter = guesses[row][col];
-                            } else if (row == currentGuess && col < currentLetter) {
-                                bgColor = WHITE;
-                                letter = guesses[row][col];
-                            }
+static void PlaceScenarioEnemy(int i, Vector2 pos) {
+    sim.enemies[i].position = pos;
+    sim.enemies[i].previous = pos;
+    sim.enemies[i].speed = sim.director.enemySpeed;
+    sim.enemies[i].velocity = Vector2Scale(Vector2Normalize(Vector2Subtract(sim.playerPos, pos)), sim.director.enemySpeed);
+    sim.enemies[i].active = true;
+    sim.enemies[i].type = i % 3;
+    sim.enemies[i].health = sim.enemies[i].type + 1;
+}
 
-                            DrawRectangle(x, y, boxSize, boxSize, bgColor);
-                            DrawRectangleLines(x, y, boxSize, boxSize, BLACK);
+// A full ring of enemies closing in on the player from every side
+static void SetupHorde(void) {
+    for (int i = 0; i < MAX_ENEMIES; i++) {
+        float angle = 2.0f * PI * i / MAX_ENEMIES;
+        float distance = 220.0f + 40.0f * (i % 4);
+        PlaceScenarioEnemy(i, Vector2Add(sim.playerPos, (Vector2){ cosf(angle) * distance, sinf(angle) * distance }));
+    }
+    // Scenes that do not step gameplay still cull against it
+    RebuildEnemyHash();
+}
 
-                            if (letter != '\0') {
-                                DrawText(TextFormat("%c", letter), x + boxSize/2 - 10, y + boxSize/2 - 20, 40, BLACK);
-                            }
-                        }
-                    }
+static void SetupMenu(void) {
+    BeginScenario(DIFFICULTY_MEDIUM, OPENING_SCENE);
+}
 
-                    if (currentGuess == MAX_GUESSES && !wordleWon) {
-                        DrawText(TextFormat("The word was: %s", targetWord), 100, GetScreenHeight() - 50, 20, RED);
-                    }
-                } else {
-                    if (bowlingBg.id != 0) {
-                        DrawTexturePro(bowlingBg,
-                                       (Rectangle){0,0,(float)bowlingBg.width,(float)bowlingBg.height},
-                                       (Rectangle){0,0,(float)GetScreenWidth(),(float)GetScreenHeight()},
-                                       (Vector2){0,0}, 0.0f, WHITE);
-                    } else {
-                        ClearBackground(DARKGREEN);
-                        DrawRectangle(LANE_LEFT - 20, 60, (LANE_RIGHT - LANE_LEFT) + 40, GetScreenHeight() - 120, BROWN);
-                    }
+static void SetupHordeScenario(void) {
+    BeginScenario(DIFFICULTY_MEDIUM, GAMEPLAY);
+    SetupHorde();
+}
 
-                    DrawText("SECOND CHANCE! Score a STRIKE to revive!", 140, 20, 24, WHITE);
-                    DrawText("Angle: LEFT/RIGHT | Power: Hold SPACE | S: Strike Mode", 120, 50, 18, WHITE);
+// Raichu firing eight ways every step into an already full bullet pool
+static void SetupThunderstone(void) {
+    BeginScenario(DIFFICULTY_MEDIUM, GAMEPLAY);
+    sim.thunderstoneEffectActive = true;
+    sim.thunderstoneEffectTimer = THUNDERSTONE_EFFECT_DURATION;
+    for (int i = 0; i < MAX_BULLETS; i++) {
+        float angle = 2.0f * PI * (i % 8) / 8.0f;
+        float distance = 20.0f + 1.5f * (i / 8);
+        sim.bullets[i].position = Vector2Add(sim.playerPos, (Vector2){ cosf(angle) * distance, sinf(angle) * distance });
+        sim.bullets[i].previous = sim.bullets[i].position;
+        sim.bullets[i].velocity = (Vector2){ cosf(angle) * 400.0f, sinf(angle) * 400.0f };
+        sim.bullets[i].active = true;
+    }
+}
 
-                    for (int i = 0; i < NUM_PINS; i++) {
-                        if (!pins[i].fallen || pins[i].animating) {
-                            DrawCircleV(pins[i].position, PIN_RADIUS, WHITE);
-                            DrawCircleV(pins[i].position, 8, RED);
-                        }
-                    }
+static void InputThunderstone(int frame) {
+    simKeysPressed[KEY_SPACE] = true;
+}
 
-                    DrawCircleV(ballPos, BOWLING_BALL_RADIUS, BLUE);
+static void SetupElixir(void) {
+    BeginScenario(DIFFICULTY_MEDIUM, GAMEPLAY);
+    SetupHorde();
+    sim.elixirReady = true;
+}
 
-                    if (!ballLaunched) {
-                        Vector2 guideEnd = {ballPos.x + 50 * sinf(throwAngle), ballPos.y - 50 * cosf(throwAngle)};
-                        DrawLineEx(ballPos, guideEnd, 2, strikeMode ? RED : DARKBLUE);
-                    }
+static void InputElixir(int frame) {
+    if (frame == 0) simKeysPressed[KEY_S] = true;
+}
 
-                    if (charging) {
-                        DrawRectangle(50, GetScreenHeight() - 40, (int)(200 * (power / maxPower)), 20, GREEN);
-                        DrawRectangleLines(50, GetScreenHeight() - 40, 200, 20, BLACK);
-                    }
-                }
-            } break;
+static void SetupObstacles(void) {
+    BeginScenario(DIFFICULTY_HARD, GAMEPLAY);
+    SetupHorde();
+}
 
-            case CLOSING_SCENE: {
-                if (homeBg.id != 0) {
-                    DrawTexturePro(
-                        homeBg,
-                        (Rectangle){0, 0, (float)homeBg.width, (float)homeBg.height},
-                        (Rectangle){0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()},
-                        (Vector2){0, 0}, 0.0f, WHITE
-                    );
-                } else {
-                    ClearBackground(BLACK);
-                }
-                
-                if (balhTex.id != 0) {
-                    DrawTexture(balhTex, GetScreenWidth()/2 - balhTex.width/2, GetScreenHeight()/2 - balhTex.height - 50, WHITE);
-                }
-                
-                const char* message = "OOPS THE POKEMON IS CAPTURED!";
-                Vector2 textSize = MeasureTextEx(emojiFont, message, 40 * gameOverScale, 2);
-                DrawTextEx(emojiFont, message, 
-                          (Vector2){GetScreenWidth()/2 - textSize.x/2, GetScreenHeight()/2 - 50}, 
-                          40 * gameOverScale, 2, RED);
-
-                if (animationComplete) {
-                    const char* replayText = "Press R to Replay";
-                    const char* homeText = "Press H to go to Home Menu";
-                    
-                    Vector2 replaySize = MeasureTextEx(emojiFont, replayText, 20, 2);
-                    Vector2 homeSize = MeasureTextEx(emojiFont, homeText, 20, 2);
-                    
-                    DrawTextEx(emojiFont, replayText, 
-                              (Vector2){GetScreenWidth()/2 - replaySize.x/2, GetScreenHeight()/2 + 30}, 
-                              20, 2, WHITE);
-                    DrawTextEx(emojiFont, homeText, 
-                              (Vector2){GetScreenWidth()/2 - homeSize.x/2, GetScreenHeight()/2 + 60}, 
-                              20, 2, WHITE);
-                }
-            } break;
+// Enemies scattered over the whole arena with a steady stream of bullets,
+// most of both out of view: draw cost should follow the few on screen
+static void SetupArena(void) {
+    BeginScenario(DIFFICULTY_HARD, GAMEPLAY);
+    for (int i = 0; i < MAX_ENEMIES; i++) {
+        Vector2 pos;
+        do {
+            pos.x = (float)SimRandom(0, (int)ARENA_WIDTH);
+            pos.y = (float)SimRandom(0, (int)ARENA_HEIGHT);
+        } while (Vector2Distance(pos, sim.playerPos) < 300.0f);
+        PlaceScenarioEnemy(i, pos);
+    }
+    RebuildEnemyHash();
+}
+
+static void SetupRevive(void) {
+    BeginScenario(DIFFICULTY_MEDIUM, REVIVE_PROMPT);
+    SetupHorde();
+    sim.reviveChoice = 0;
+    sim.reviveTimer = REVIVE_TIME;
+}
+
+static void SetupMiniGame(Difficulty difficulty) {
+    BeginScenario(difficulty, MINI_GAME);
+    ResetMiniGame(difficulty);
+}
+
+static void SetupBalls(void) { SetupMiniGame(DIFFICULTY_EASY); }
+static void SetupWordle(void) { SetupMiniGame(DIFFICULTY_MEDIUM); }
+static void SetupBowling(void) {
+    SetupMiniGame(DIFFICULTY_HARD);
+    sim.charging = true;
+    sim.power = 0.6f * maxPower;
+}
+
+// Types three guesses, one letter per step, then keeps the board on screen
+static void InputWordle(int frame) {
+    static const char *words[] = { "CRANE", "SLOTH", "PIOUS" };
+    int guess = frame / (WORD_LENGTH + 1);
+    int letter = frame % (WORD_LENGTH + 1);
+    if (guess >= 3) return;
+    if (letter < WORD_LENGTH) simChars[simCharCount++] = words[guess][letter];
+    else simKeysPressed[KEY_ENTER] = true;
+}
+
+static void InputBowling(int frame) {
+    if (frame == 0) simKeysReleased[KEY_SPACE] = true;
+}
+
+static const Scenario scenarios[] = {
+    { "menu",        SetupMenu,          NULL },
+    { "horde",       SetupHordeScenario, NULL },
+    { "thunderstone", SetupThunderstone, InputThunderstone },
+    { "elixir",      SetupElixir,        InputElixir },
+    { "obstacles",   SetupObstacles,     NULL },
+    { "arena",       SetupArena,         InputThunderstone },
+    { "revive",      SetupRevive,        NULL },
+    { "balls",       SetupBalls,         NULL },
+    { "wordle",      SetupWordle,        InputWordle },
+    { "bowling",     SetupBowling,       InputBowling },
+};
+#define SCENARIO_COUNT (int)(sizeof(scenarios) / sizeof(scenarios[0]))
+
+static ScenarioResult RunScenario(const Scenario *scenario, int frames) {
+    ScenarioResult result = { scenario->name };
+    int perBatch = frames / SCENARIO_BATCHES;
+    double batchNs[SCENARIO_BATCHES];
+    double updateTime = 0.0, drawTime = 0.0;
+#ifdef RLGL_BATCH_STATS
+    BatchStats batchTotal = {0};
+#endif
+
+    // Batch -1 warms caches and the driver and is not counted
+    for (int b = -1; b < SCENARIO_BATCHES; b++) {
+        scenario->setup();
+        SnapshotPositions();
+#ifdef NULL_RENDER
+        if (b == 0) ResetNullRenderStats();
+#endif
+        double batchTime = 0.0;
+        for (int f = 0; f < perBatch; f++) {
+            ClearLatchedInput();
+            if (scenario->input) scenario->input(f);
+            double start = ProfilerTime();
+            SnapshotPositions();
+            UpdateGame(SIM_DT);
+            UpdateAssetResidency();
+            double mid = ProfilerTime();
+            DrawGame(1.0f);
+            double end = ProfilerTime();
+            FinishProfileZone(&separationZone);
+            batchTime += end - start;
+            if (b >= 0) {
+                updateTime += mid - start;
+                drawTime += end - mid;
+#ifdef RLGL_BATCH_STATS
+                batchTotal.flushes += batchStats.flushes;
+                batchTotal.drawCalls += batchStats.drawCalls;
+                batchTotal.vertices += batchStats.vertices;
+#endif
+            }
+        }
+        if (b >= 0) batchNs[b] = batchTime * 1e9 / perBatch;
+    }
+    ClearLatchedInput();
+
+    // The first save grows the buffer and is not counted
+    SaveGameState(&stateSnapshot);
+    double start = ProfilerTime();
+    for (int i = 0; i < SCENARIO_SNAPSHOTS; i++) SaveGameState(&stateSnapshot);
+    double mid = ProfilerTime();
+    for (int i = 0; i < SCENARIO_SNAPSHOTS; i++) RestoreGameState(&stateSnapshot);
+    double end = ProfilerTime();
+    result.snapshotNs = (mid - start) * 1e9 / SCENARIO_SNAPSHOTS;
+    result.restoreNs = (end - mid) * 1e9 / SCENARIO_SNAPSHOTS;
+    result.snapshotBytes = (int)stateSnapshot.size;
+
+    double sum = 0.0, sumSq = 0.0;
+    for (int b = 0; b < SCENARIO_BATCHES; b++) sum += batchNs[b];
+    result.meanNs = sum / SCENARIO_BATCHES;
+    for (int b = 0; b < SCENARIO_BATCHES; b++) sumSq += (batchNs[b] - result.meanNs) * (batchNs[b] - result.meanNs);
+    result.ci95Ns = SCENARIO_T95 * sqrt(sumSq / (SCENARIO_BATCHES - 1)) / sqrt(SCENARIO_BATCHES);
+    result.updateNs = updateTime * 1e9 / (perBatch * SCENARIO_BATCHES);
+    result.drawNs = drawTime * 1e9 / (perBatch * SCENARIO_BATCHES);
+#ifdef RLGL_BATCH_STATS
+    double measured = (double)(perBatch * SCENARIO_BATCHES);
+    result.flushes = batchTotal.flushes / measured;
+    result.drawCalls = batchTotal.drawCalls / measured;
+    result.vertices = batchTotal.vertices / measured;
+#endif
+#ifdef NULL_RENDER
+    result.textureBinds = nullRenderStats.textureBinds / (double)(perBatch * SCENARIO_BATCHES);
+#endif
+    return result;
+}
+
+static bool WriteScenarioJson(const char *fileName, const ScenarioResult *results, int count, int frames) {
+    FILE *file = fopen(fileName, "w");
+    if (file == NULL) return false;
+    fprintf(file, "{\n  \"frames\": %d,\n  \"scenarios\": [\n", frames);
+    for (int i = 0; i < count; i++) {
+        // One scenario per line keeps LoadScenarioBaseline trivial
+        fprintf(file, "    {\"name\": \"%s\", \"mean_ns\": %.1f, \"ci95_ns\": %.1f, \"update_ns\": %.1f, \"draw_ns\": %.1f",
+                results[i].name, results[i].meanNs, results[i].ci95Ns, results[i].updateNs, results[i].drawNs);
+        fprintf(file, ", \"snapshot_ns\": %.1f, \"restore_ns\": %.1f, \"snapshot_bytes\": %d",
+                results[i].snapshotNs, results[i].restoreNs, results[i].snapshotBytes);
+#ifdef RLGL_BATCH_STATS
+        fprintf(file, ", \"flushes\": %.2f, \"draw_calls\": %.2f, \"vertices\": %.1f",
+                results[i].flushes, results[i].drawCalls, results[i].vertices);
+#endif
+#ifdef NULL_RENDER
+        fprintf(file, ", \"texture_binds\": %.2f", results[i].textureBinds);
+#endif
+        fprintf(file, "}%s\n", (i + 1 < count) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return true;
+}
+
+// One value ("mean_ns", "flushes", ...) of the named scenario in a file
+// written by WriteScenarioJson, or -1
+static double LoadScenarioBaseline(const char *fileName, const char *name, const char *key) {
+    FILE *file = fopen(fileName, "r");
+    if (file == NULL) return -1.0;
+    char line[512];
+    char field[SCENARIO_MAX_NAME + 4];
+    snprintf(field, sizeof(field), "\"%s\": ", key);
+    double value = -1.0;
+    while (fgets(line, sizeof(line), file)) {
+        char found[SCENARIO_MAX_NAME];
+        const char *n = strstr(line, "\"name\": \"");
+        const char *v = strstr(line, field);
+        if (n == NULL || v == NULL) continue;
+        if (sscanf(n + 9, "%31[^\"]", found) == 1 && strcmp(found, name) == 0) {
+            value = atof(v + strlen(field));
+            break;
+        }
+    }
+    fclose(file);
+    return value;
+}
+
+static int RunScenarioBench(int argc, char **argv) {
+    const char *only = NULL;
+    const char *jsonFile = "scenarios.json";
+    const char *baselineFile = SCENARIO_BASELINE;
+    double threshold = 5.0;
+    int frames = SCENARIO_DEFAULT_FRAMES;
+
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) frames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--json") == 0 && i + 1 < argc) jsonFile = argv[++i];
+        else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) baselineFile = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) threshold = atof(argv[++i]);
+        else only = argv[i];
+    }
+    if (frames < SCENARIO_BATCHES) frames = SCENARIO_BATCHES;
+    if (strcmp(baselineFile, "none") == 0) {
+        baselineFile = NULL;
+    } else {
+        FILE *probe = fopen(baselineFile, "r");
+        if (probe != NULL) {
+            fclose(probe);
+        } else {
+            printf("no baseline at %s, nothing to compare against\n", baselineFile);
+            baselineFile = NULL;
         }
+    }
 
-        EndDrawing();
+    // Nothing may wait on the display while measuring
+    ApplyPaceMode(PACE_UNCAPPED);
+    SetMasterVolume(0.0f);
+
+    ScenarioResult results[SCENARIO_COUNT];
+    int count = 0;
+    int regressions = 0;
+    for (int i = 0; i < SCENARIO_COUNT; i++) {
+        if (only != NULL && strcmp(only, scenarios[i].name) != 0) continue;
+        ScenarioResult *r = &results[count++];
+        *r = RunScenario(&scenarios[i], frames);
+        printf("scenario %-12s %10.0f ns/frame +/- %8.0f (95%%)  update %10.0f  draw %10.0f",
+               r->name, r->meanNs, r->ci95Ns, r->updateNs, r->drawNs);
+        printf("  save %6.1f us  restore %6.1f us  %4d KB",
+               r->snapshotNs / 1000.0, r->restoreNs / 1000.0, (r->snapshotBytes + 1023) / 1024);
+#ifdef RLGL_BATCH_STATS
+        printf("  flushes %5.1f  calls %6.1f  verts %8.0f", r->flushes, r->drawCalls, r->vertices);
+#endif
+#ifdef NULL_RENDER
+        printf("  binds %6.1f", r->textureBinds);
+#endif
+
+        double base = baselineFile ? LoadScenarioBaseline(baselineFile, r->name, "mean_ns") : -1.0;
+        if (base > 0.0) {
+            double baseCi = LoadScenarioBaseline(baselineFile, r->name, "ci95_ns");
+            double change = (r->meanNs - base) / base * 100.0;
+            // Noise alone can move a mean past the threshold
+            bool regressed = change > threshold && r->meanNs - r->ci95Ns > base + fmax(baseCi, 0.0);
+            printf("  baseline %10.0f  %+6.1f%%%s", base, change, regressed ? "  REGRESSION" : "");
+            if (regressed) regressions++;
+        }
+#ifdef RLGL_BATCH_STATS
+        // Counts are deterministic, so any real growth is a batching regression
+        double baseFlushes = baselineFile ? LoadScenarioBaseline(baselineFile, r->name, "flushes") : -1.0;
+        double baseCalls = baselineFile ? LoadScenarioBaseline(baselineFile, r->name, "draw_calls") : -1.0;
+        if ((baseFlushes >= 0.0 && r->flushes > baseFlushes + SCENARIO_BATCH_SLACK) ||
+            (baseCalls >= 0.0 && r->drawCalls > baseCalls + SCENARIO_BATCH_SLACK)) {
+            printf("  BATCHING REGRESSION (flushes %.1f, calls %.1f in baseline)", baseFlushes, baseCalls);
+            regressions++;
+        }
+#endif
+        printf("\n");
     }
 
-    // Cleanup
-    if (logo.id != 0) UnloadTexture(logo);
-    if (homeBg.id != 0) UnloadTexture(homeBg);
+    if (count == 0) {
+        printf("no scenario named %s\n", only);
+        return 1;
+    }
+    if (!WriteScenarioJson(jsonFile, results, count, frames)) printf("could not write %s\n", jsonFile);
+    if (baselineFile != NULL) printf("%d regression(s) against %s (time threshold %.1f%%)\n", regressions, baselineFile, threshold);
+    return (regressions > 0) ? 1 : 0;
+}
+
+// ------------ Shutdown ------------
+static void UnloadGame(void) {
+    if (coopPhase != COOP_OFF) {
+        LogCoopStats();
+        CloseNetLink(&coopLink);
+        UnloadRollbackSession(&coopSession);
+    }
+    AssetSet *sets[] = { &menuAssets, &transitionAssets, &runAssets };
+    for (int i = 0; i < 3; i++) {
+        HoldAssetSet(&assetLoader, sets[i], false, false);
+        HoldAssetSet(&assetLoader, &difficultyAssets[i], false, false);
+        HoldAssetSet(&assetLoader, &miniGameAssets[i], false, false);
+    }
+    UnloadAssetLoader(&assetLoader);
     if (emojiFont.texture.id != 0) UnloadFont(emojiFont);
-    if (pokeballTex.id != 0) UnloadTexture(pokeballTex);
-    if (ultraBallTex.id != 0) UnloadTexture(ultraBallTex);
-    if (masterBallTex.id != 0) UnloadTexture(masterBallTex);
-    if (pikachuTex.id != 0) UnloadTexture(pikachuTex);
-    if (raichuTex.id != 0) UnloadTexture(raichuTex);
-    if (balhTex.id != 0) UnloadTexture(balhTex);
-    if (aoiTex.id != 0) UnloadTexture(aoiTex);
-    if (easyBg.id != 0) UnloadTexture(easyBg);
-    if (mediumBg.id != 0) UnloadTexture(mediumBg);
-    if (hardBg.id != 0) UnloadTexture(hardBg);
-    if (obstacleTex.id != 0) UnloadTexture(obstacleTex);
-    if (bowlingBg.id != 0) UnloadTexture(bowlingBg);
-    if (ballsBg.id != 0) UnloadTexture(ballsBg);
-    if (elixirTex.id != 0) UnloadTexture(elixirTex);
-    if (thunderstoneTex.id != 0) UnloadTexture(thunderstoneTex);
-    if (speedTex.id != 0) UnloadTexture(speedTex);
-    if (powerTex.id != 0) UnloadTexture(powerTex);
-    if (normalBulletTex.id != 0) UnloadTexture(normalBulletTex);
-    if (specialBulletTex.id != 0) UnloadTexture(specialBulletTex);
-    if (basketTex.id != 0) UnloadTexture(basketTex);
-    if (hitSound.frameCount > 0) UnloadSound(hitSound);
     if (deadSound.frameCount > 0) UnloadSound(deadSound);
     if (bgm.ctxData != NULL) UnloadMusicStream(bgm);
     if (blurShader.id != 0) UnloadShader(blurShader);
+    if (shockwaveShader.id != 0) UnloadShader(shockwaveShader);
     if (reviveTarget.id != 0) UnloadRenderTexture(reviveTarget);
+    UnloadRectGrid(&obstacleIndex);
+    UnloadFlowField(&enemyFlow);
+    UnloadSpatialHash(&enemyHash);
+    UnloadParticleSystem(&particles);
+    UnloadDrawList(&drawList);
+    UnloadRigidWorld(&pinWorld);
+    UnloadBallRain(&ballRain);
+    UnloadSnapshotStream(&stateSnapshot);
+    UnloadWordList(&wordleAnswers);
+    UnloadWordList(&wordleAllowed);
+    if (particleTex.id != 0) UnloadTexture(particleTex);
     CloseAudioDevice();
     CloseWindow();
+}
+
+// ------------ Main ------------
+int main(int argc, char **argv) {
+    const int screenWidth = 800;
+    const int screenHeight = 600;
+
+    SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+    InitWindow(screenWidth, screenHeight, "Capture or Escape");
+    sim.rng = (unsigned int)GetRandomValue(1, 0x7fffffff);   // raylib seeds from the clock
+#ifdef RLGL_BATCH_STATS
+    rlSetFlushCallback(CountBatchFlush);
+#endif
+    InitAudioDevice();
+    ApplyPaceMode(PACE_ADAPTIVE);
+    SetScreenAssetSize();
+    assetLoader.budget = (long)VRAM_BUDGET_MB * 1024 * 1024;
+
+    // --- Load assets ---
+    // Scene textures and the strike sound are loaded per scene, see UpdateAssetResidency
+    if (!FileExists("resources/emoji_font.ttf")) TraceLog(LOG_WARNING, "emoji_font.ttf missing! Using default.");
+    emojiFont = LoadFont("resources/emoji_font.ttf");
+    if (emojiFont.texture.id == 0) emojiFont = GetFontDefault();
+
+    // Wordle dictionaries
+    if (!LoadWordList(&wordleAnswers, "resources/answers.txt")) TraceLog(LOG_WARNING, "answers.txt missing! Using built-in words.");
+    if (!LoadWordList(&wordleAllowed, "resources/words.txt")) TraceLog(LOG_WARNING, "words.txt missing! Any five letters will be accepted.");
+
+    // Load death sound
+    if (!FileExists("resources/dead.mp3")) TraceLog(LOG_WARNING, "dead.mp3 missing!");
+    deadSound = LoadSound("resources/dead.mp3");
+    
+    // Load background music
+    if (!FileExists("resources/bgm.mp3")) TraceLog(LOG_WARNING, "bgm.mp3 missing!");
+    bgm = LoadMusicStream("resources/bgm.mp3");
+    if (bgm.ctxData != NULL) {
+        PlayMusicStream(bgm);
+        musicPlaying = true;
+        SetMusicVolume(bgm, 0.9f);
+    }
+
+    // Initialize blur shader and render texture for revive prompt
+    blurShader = LoadShaderFromMemory(0, blurShaderCode);
+    int resolutionLoc = GetShaderLocation(blurShader, "resolution");
+    Vector2 resolution = { (float)screenWidth, (float)screenHeight };
+    SetShaderValue(blurShader, resolutionLoc, &resolution, SHADER_UNIFORM_VEC2);
+    reviveTarget = LoadRenderTexture(screenWidth, screenHeight);
+
+    shockwaveShader = LoadShaderFromMemory(0, shockwaveShaderCode);
+    shockwaveSizeLoc = GetShaderLocation(shockwaveShader, "size");
+    shockwaveRadiusLoc = GetShaderLocation(shockwaveShader, "radius");
+    shockwaveSpacingLoc = GetShaderLocation(shockwaveShader, "spacing");
+    shockwaveCountLoc = GetShaderLocation(shockwaveShader, "ringCount");
+    shockwaveThicknessLoc = GetShaderLocation(shockwaveShader, "thickness");
+    shockwaveColorLoc = GetShaderLocation(shockwaveShader, "ringColor");
+
+    LoadSpatialHash(&enemyHash, MAX_ENEMIES, SEPARATION_RADIUS);
+
+    Image dot = GenImageColor(32, 32, BLANK);
+    ImageDrawCircle(&dot, 16, 16, 15, WHITE);
+    particleTex = LoadTextureFromImage(dot);
+    UnloadImage(dot);
+    LoadParticleSystem(&particles, MAX_PARTICLES, particleTex);
+    LoadDrawList(&drawList, MAX_SPRITES);
+    LoadRigidWorld(&pinWorld, MAX_PINS + 1, (Rectangle){0});
+    LoadBallRain(&ballRain, MAX_BALLS, BALLS_RADIUS, screenWidth, screenHeight);
+    pinWorld.drive = DriveBowlingThrow;
+    pinWorld.driveData = &sim.bowl;
+
+    ResetMiniGame(sim.selectedDifficulty);
+    ResetElixirState();
+    ResetThunderstoneState();
+    ResetSpeedState();
+    ResetPowerState();
+
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        int status = RunScenarioBench(argc - 2, argv + 2);
+        UnloadGame();
+        return status;
+    }
+    if (argc > 1 && strcmp(argv[1], "--resume") == 0) QuickLoad();
+    if (argc > 1 && strcmp(argv[1], "--coop") == 0 && !StartCoop(argc - 2, argv + 2)) {
+        UnloadGame();
+        return 1;
+    }
+
+    while (!WindowShouldClose()) {
+        float dt = GetFrameTime();
+        
+        if (musicPlaying) {
+            UpdateMusicStream(bgm);
+        }
+
+        if (IsKeyPressed(KEY_F3)) profilerVisible = !profilerVisible;
+        if (IsKeyPressed(KEY_RIGHT_BRACKET)) timeScale = fminf(timeScale * 2.0f, MAX_TIME_SCALE);
+        if (IsKeyPressed(KEY_LEFT_BRACKET))  timeScale = fmaxf(timeScale * 0.5f, MIN_TIME_SCALE);
+        if (IsKeyPressed(KEY_BACKSLASH))     timeScale = 1.0f;
+        if (IsKeyPressed(KEY_F4)) ApplyPaceMode((framePacer.mode + 1) % PACE_MODE_COUNT);
+        if (IsKeyPressed(KEY_F5)) {
+            frameCapIndex = (frameCapIndex + 1) % (int)(sizeof(frameCaps) / sizeof(frameCaps[0]));
+            if (framePacer.mode == PACE_FIXED) ApplyPaceMode(PACE_FIXED);
+        }
+        if (IsKeyPressed(KEY_F6)) LogSceneAssets();
+        if (IsKeyPressed(KEY_F7)) QuickSave();
+        // Loading would put this side's sim out of step with the peer's
+        if (IsKeyPressed(KEY_F8) && coopPhase == COOP_OFF) QuickLoad();
+        // The window may have moved to a monitor with another refresh rate
+        if (framePacer.mode == PACE_ADAPTIVE) framePacer.interval = MonitorRefreshInterval();
+
+        LayoutMenuButtons();
+
+        // ---------------- UPDATE ----------------
+        // Whole SIM_DT steps only; the remainder blends the last two steps on screen
+        LatchInput();
+        simAccumulator += fminf(dt, SIM_MAX_FRAME_TIME) * timeScale;
+        int steps = 0;
+        if (coopPhase != COOP_OFF) {
+            steps = UpdateCoop();
+        } else {
+            while (simAccumulator >= SIM_DT && steps < SIM_MAX_STEPS) {
+                SnapshotPositions();
+                UpdateGame(SIM_DT);
+                ClearLatchedInput();
+                simAccumulator -= SIM_DT;
+                steps++;
+            }
+        }
+        if (steps == SIM_MAX_STEPS) simAccumulator = fminf(simAccumulator, SIM_DT);
+        float alpha = simAccumulator / SIM_DT;
+        UpdateAssetResidency();
+
+        // ---------------- DRAW ----------------
+        DrawGame(alpha);
+        WaitFramePacer(&framePacer);
+
+        FinishProfileZone(&separationZone);
+    }
+
+    UnloadGame();
     return 0;
 }
\ No newline at end of file
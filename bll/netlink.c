@@ -0,0 +1,156 @@
+#include "netlink.h"
+#include <string.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <winsock2.h>
+    typedef SOCKET NetSocket;
+    typedef int socklen_t;
+    #define CloseSocket closesocket
+#else
+    #include <arpa/inet.h>
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <netinet/in.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    typedef int NetSocket;
+    #define CloseSocket close
+#endif
+
+static unsigned int NextFaultRandom(NetFaults *faults) {
+    if (faults->rng == 0) faults->rng = 0x9E3779B9u;
+    faults->rng ^= faults->rng << 13;
+    faults->rng ^= faults->rng >> 17;
+    faults->rng ^= faults->rng << 5;
+    return faults->rng;
+}
+
+// Uniform in [0, 1)
+static float FaultUnit(NetFaults *faults) {
+    return (NextFaultRandom(faults) >> 8) / 16777216.0f;
+}
+
+static bool SetNonBlocking(NetSocket s) {
+#if defined(_WIN32)
+    u_long on = 1;
+    return ioctlsocket(s, FIONBIO, &on) == 0;
+#else
+    int flags = fcntl(s, F_GETFL, 0);
+    return flags != -1 && fcntl(s, F_SETFL, flags | O_NONBLOCK) != -1;
+#endif
+}
+
+// Errors that only concern one datagram; the next may be fine
+static bool DatagramError(void) {
+#if defined(_WIN32)
+    // An ICMP port unreachable from an earlier send shows up here while the peer is not up yet
+    int error = WSAGetLastError();
+    return error == WSAECONNRESET || error == WSAEMSGSIZE;
+#else
+    return errno == EINTR || errno == ECONNREFUSED;
+#endif
+}
+
+bool OpenNetLink(NetLink *link, int localPort, const char *remoteHost, int remotePort) {
+    memset(link, 0, sizeof(*link));
+    link->socket = -1;
+
+#if defined(_WIN32)
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0) return false;
+#endif
+    unsigned long address = inet_addr(remoteHost);
+    NetSocket s = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+#if defined(_WIN32)
+    if (s == INVALID_SOCKET) {
+        WSACleanup();
+        return false;
+    }
+#else
+    if (s < 0) return false;
+#endif
+    link->socket = (long long)s;
+
+    struct sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons((unsigned short)localPort);
+    if (address == INADDR_NONE || bind(s, (struct sockaddr *)&local, sizeof(local)) != 0 || !SetNonBlocking(s)) {
+        CloseNetLink(link);
+        return false;
+    }
+    link->remoteAddress = (unsigned int)address;
+    link->remotePort = htons((unsigned short)remotePort);
+    return true;
+}
+
+void CloseNetLink(NetLink *link) {
+    if (link->socket == -1) return;
+    CloseSocket((NetSocket)link->socket);
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+    link->socket = -1;
+    link->delayedCount = 0;
+}
+
+static bool SendNow(NetLink *link, const void *data, int size) {
+    struct sockaddr_in to;
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_addr.s_addr = link->remoteAddress;
+    to.sin_port = link->remotePort;
+    return sendto((NetSocket)link->socket, (const char *)data, size, 0, (struct sockaddr *)&to, sizeof(to)) == size;
+}
+
+bool SendNetPacket(NetLink *link, const void *data, int size, double now) {
+    if (link->socket == -1 || size <= 0 || size > NET_MAX_PACKET) return false;
+    link->sent++;
+
+    NetFaults *faults = &link->faults;
+    if (faults->loss > 0.0f && FaultUnit(faults) < faults->loss) {
+        link->dropped++;
+        return true;
+    }
+    if (faults->latency <= 0.0 && faults->jitter <= 0.0) return SendNow(link, data, size);
+
+    // A full queue overflows like a router's would
+    if (link->delayedCount == NET_MAX_DELAYED) {
+        link->dropped++;
+        return true;
+    }
+    NetDelayedPacket *packet = &link->delayed[link->delayedCount++];
+    packet->due = now + faults->latency + faults->jitter * FaultUnit(faults);
+    packet->size = size;
+    memcpy(packet->data, data, size);
+    return true;
+}
+
+void FlushNetLink(NetLink *link, double now) {
+    for (int i = 0; i < link->delayedCount; ) {
+        if (link->delayed[i].due <= now) {
+            SendNow(link, link->delayed[i].data, link->delayed[i].size);
+            link->delayed[i] = link->delayed[--link->delayedCount];
+        } else {
+            i++;
+        }
+    }
+}
+
+int ReceiveNetPacket(NetLink *link, void *data, int capacity) {
+    if (link->socket == -1) return 0;
+    for (;;) {
+        struct sockaddr_in from;
+        socklen_t fromLength = sizeof(from);
+        int size = (int)recvfrom((NetSocket)link->socket, (char *)data, capacity, 0, (struct sockaddr *)&from, &fromLength);
+        if (size < 0) {
+            if (DatagramError()) continue;
+            return 0;   // nothing waiting
+        }
+        if (from.sin_addr.s_addr != link->remoteAddress || from.sin_port != link->remotePort) continue;
+        link->received++;
+        return size;
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef NETLINK_H
+#define NETLINK_H
+
+#include <stdbool.h>
+
+// Connectionless UDP link to one peer: non-blocking sends and receives of
+// whole datagrams, Winsock on Windows and BSD sockets elsewhere. A fault
+// injector can sit in front of the socket, holding every outgoing packet
+// back by a latency plus random jitter and dropping a share of them, so
+// netcode can be tried over loopback as if over a real connection. Held
+// packets go out from FlushNetLink once they are due, so jitter reorders
+// them as a real network would.
+#define NET_MAX_PACKET 512
+#define NET_MAX_DELAYED 256     // packets held by the injector at once; more are dropped
+
+typedef struct {
+    double latency;             // seconds every packet is held back
+    double jitter;              // up to this many seconds more, at random
+    float loss;                 // share of packets dropped, 0..1
+    unsigned int rng;
+} NetFaults;
+
+typedef struct {
+    double due;
+    int size;
+    unsigned char data[NET_MAX_PACKET];
+} NetDelayedPacket;
+
+typedef struct {
+    long long socket;           // -1 when closed
+    unsigned int remoteAddress; // IPv4, network byte order
+    unsigned short remotePort;  // network byte order
+    NetFaults faults;           // all zero sends straight away
+    NetDelayedPacket delayed[NET_MAX_DELAYED];
+    int delayedCount;
+    // Totals
+    int sent;
+    int received;
+    int dropped;                // by the injector
+} NetLink;
+
+// Binds localPort on every interface and talks to remoteHost (a dotted
+// IPv4 address) on remotePort. Faults are cleared; set them afterwards.
+bool OpenNetLink(NetLink *link, int localPort, const char *remoteHost, int remotePort);
+void CloseNetLink(NetLink *link);
+
+// now is the caller's clock in seconds, only read while faults are set
+bool SendNetPacket(NetLink *link, const void *data, int size, double now);
+// Sends the held packets that are due by now
+void FlushNetLink(NetLink *link, double now);
+
+// Copies the next datagram from the peer into data and returns its size, or
+// 0 when none is waiting. Datagrams from anywhere else are skipped.
+int ReceiveNetPacket(NetLink *link, void *data, int capacity);
+
+#endif // NETLINK_H
@@ -0,0 +1,408 @@
+#ifndef NULLGL_GLAD_H
+#define NULLGL_GLAD_H
+
+// Null OpenGL 3.3 for the null render backend, in place of raylib's glad
+// loader. rlgl.h includes it as "external/glad.h" when nullrender.c builds
+// rlgl with RLGL_IMPLEMENTATION; nothing else should include it. Every call
+// succeeds and draws nothing. Object names are handed out, shader sources
+// are kept so uniform and attribute lookups give -1 the way a real driver
+// does for names a shader never mentions, and the calls that carry work to
+// the GPU are counted in nullRenderStats (see nullrender.h).
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef unsigned int GLenum;
+typedef unsigned int GLuint;
+typedef int GLint;
+typedef int GLsizei;
+typedef float GLfloat;
+typedef double GLdouble;
+typedef unsigned char GLboolean;
+typedef unsigned char GLubyte;
+typedef unsigned short GLushort;
+typedef unsigned int GLbitfield;
+typedef char GLchar;
+typedef void GLvoid;
+typedef ptrdiff_t GLsizeiptr;
+typedef ptrdiff_t GLintptr;
+
+typedef void *(*GLADloadfunc)(const char *name);
+
+#define GL_FALSE                                        0
+#define GL_TRUE                                         1
+#define GL_NO_ERROR                                     0
+#define GL_ONE                                          1
+#define GL_TRIANGLES                                    0x0004
+#define GL_TRIANGLE_STRIP                               0x0005
+#define GL_LEQUAL                                       0x0203
+#define GL_SRC_ALPHA                                    0x0302
+#define GL_ONE_MINUS_SRC_ALPHA                          0x0303
+#define GL_DST_COLOR                                    0x0306
+#define GL_FRONT                                        0x0404
+#define GL_BACK                                         0x0405
+#define GL_FRONT_AND_BACK                               0x0408
+#define GL_CCW                                          0x0901
+#define GL_LINE_SMOOTH                                  0x0B20
+#define GL_LINE_WIDTH                                   0x0B21
+#define GL_CULL_FACE                                    0x0B44
+#define GL_DEPTH_TEST                                   0x0B71
+#define GL_BLEND                                        0x0BE2
+#define GL_SCISSOR_TEST                                 0x0C11
+#define GL_UNPACK_ALIGNMENT                             0x0CF5
+#define GL_PACK_ALIGNMENT                               0x0D05
+#define GL_MAX_TEXTURE_SIZE                             0x0D33
+#define GL_TEXTURE_2D                                   0x0DE1
+#define GL_UNSIGNED_BYTE                                0x1401
+#define GL_UNSIGNED_SHORT                               0x1403
+#define GL_UNSIGNED_INT                                 0x1405
+#define GL_FLOAT                                        0x1406
+#define GL_HALF_FLOAT                                   0x140B
+#define GL_TEXTURE                                      0x1702
+#define GL_DEPTH_COMPONENT                              0x1902
+#define GL_RED                                          0x1903
+#define GL_GREEN                                        0x1904
+#define GL_RGB                                          0x1907
+#define GL_RGBA                                         0x1908
+#define GL_POINT                                        0x1B00
+#define GL_LINE                                         0x1B01
+#define GL_FILL                                         0x1B02
+#define GL_VENDOR                                       0x1F00
+#define GL_RENDERER                                     0x1F01
+#define GL_VERSION                                      0x1F02
+#define GL_EXTENSIONS                                   0x1F03
+#define GL_NEAREST                                      0x2600
+#define GL_LINEAR                                       0x2601
+#define GL_LINEAR_MIPMAP_LINEAR                         0x2703
+#define GL_TEXTURE_MAG_FILTER                           0x2800
+#define GL_TEXTURE_MIN_FILTER                           0x2801
+#define GL_TEXTURE_WRAP_S                               0x2802
+#define GL_TEXTURE_WRAP_T                               0x2803
+#define GL_REPEAT                                       0x2901
+#define GL_DEPTH_BUFFER_BIT                             0x0100
+#define GL_COLOR_BUFFER_BIT                             0x4000
+#define GL_FUNC_ADD                                     0x8006
+#define GL_FUNC_SUBTRACT                                0x800A
+#define GL_UNSIGNED_SHORT_4_4_4_4                       0x8033
+#define GL_UNSIGNED_SHORT_5_5_5_1                       0x8034
+#define GL_RGB8                                         0x8051
+#define GL_RGBA4                                        0x8056
+#define GL_RGB5_A1                                      0x8057
+#define GL_RGBA8                                        0x8058
+#define GL_TEXTURE_WRAP_R                               0x8072
+#define GL_CLAMP_TO_EDGE                                0x812F
+#define GL_NUM_EXTENSIONS                               0x821D
+#define GL_RG                                           0x8227
+#define GL_R8                                           0x8229
+#define GL_RG8                                          0x822B
+#define GL_R16F                                         0x822D
+#define GL_R32F                                         0x822E
+#define GL_UNSIGNED_SHORT_5_6_5                         0x8363
+#define GL_TEXTURE0                                     0x84C0
+#define GL_TEXTURE_LOD_BIAS                             0x8501
+#define GL_TEXTURE_CUBE_MAP                             0x8513
+#define GL_TEXTURE_CUBE_MAP_POSITIVE_X                  0x8515
+#define GL_RGBA32F                                      0x8814
+#define GL_RGB32F                                       0x8815
+#define GL_RGBA16F                                      0x881A
+#define GL_RGB16F                                       0x881B
+#define GL_TEXTURE_CUBE_MAP_SEAMLESS                    0x884F
+#define GL_ARRAY_BUFFER                                 0x8892
+#define GL_ELEMENT_ARRAY_BUFFER                         0x8893
+#define GL_STATIC_DRAW                                  0x88E4
+#define GL_DYNAMIC_DRAW                                 0x88E8
+#define GL_FRAGMENT_SHADER                              0x8B30
+#define GL_VERTEX_SHADER                                0x8B31
+#define GL_COMPILE_STATUS                               0x8B81
+#define GL_LINK_STATUS                                  0x8B82
+#define GL_INFO_LOG_LENGTH                              0x8B84
+#define GL_ACTIVE_UNIFORMS                              0x8B86
+#define GL_ACTIVE_ATTRIBUTES                            0x8B89
+#define GL_SHADING_LANGUAGE_VERSION                     0x8B8C
+#define GL_DRAW_FRAMEBUFFER_BINDING                     0x8CA6
+#define GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE           0x8CD0
+#define GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME           0x8CD1
+#define GL_FRAMEBUFFER_COMPLETE                         0x8CD5
+#define GL_FRAMEBUFFER_INCOMPLETE_ATTACHMENT            0x8CD6
+#define GL_FRAMEBUFFER_INCOMPLETE_MISSING_ATTACHMENT    0x8CD7
+#define GL_FRAMEBUFFER_UNSUPPORTED                      0x8CDD
+#define GL_COLOR_ATTACHMENT0                            0x8CE0
+#define GL_COLOR_ATTACHMENT1                            0x8CE1
+#define GL_COLOR_ATTACHMENT2                            0x8CE2
+#define GL_COLOR_ATTACHMENT3                            0x8CE3
+#define GL_COLOR_ATTACHMENT4                            0x8CE4
+#define GL_COLOR_ATTACHMENT5                            0x8CE5
+#define GL_COLOR_ATTACHMENT6                            0x8CE6
+#define GL_COLOR_ATTACHMENT7                            0x8CE7
+#define GL_DEPTH_ATTACHMENT                             0x8D00
+#define GL_STENCIL_ATTACHMENT                           0x8D20
+#define GL_FRAMEBUFFER                                  0x8D40
+#define GL_RENDERBUFFER                                 0x8D41
+#define GL_RGB565                                       0x8D62
+#define GL_TEXTURE_SWIZZLE_RGBA                         0x8E46
+#define GL_COMPUTE_SHADER                               0x91B9
+
+// Core 3.3 covers what rlgl asks of these; no compressed formats
+#define GLAD_GL_KHR_texture_compression_astc_hdr 0
+#define GLAD_GL_KHR_texture_compression_astc_ldr 0
+#define GLAD_GL_EXT_texture_compression_s3tc 0
+#define GLAD_GL_ARB_ES3_compatibility 0
+
+#define NULLGL_MAX_SHADERS 64
+
+static GLuint nullglNextName = 1;
+static GLuint nullglBoundTexture = 0;
+static GLuint nullglProgram = 0;
+static char *nullglSource[NULLGL_MAX_SHADERS];          // by shader name
+static GLuint nullglAttached[NULLGL_MAX_SHADERS][2];    // by program name
+
+static int gladLoadGL(GLADloadfunc load) { (void)load; return 1; }
+
+static void nullglGen(GLsizei n, GLuint *names) { for (GLsizei i = 0; i < n; i++) names[i] = nullglNextName++; }
+
+// Whether any shader attached to the program mentions the name
+static GLint nullglLocation(GLuint program, const GLchar *name) {
+    if (program >= NULLGL_MAX_SHADERS) return -1;
+    for (int i = 0; i < 2; i++) {
+        GLuint shader = nullglAttached[program][i];
+        if (shader < NULLGL_MAX_SHADERS && nullglSource[shader] != NULL && strstr(nullglSource[shader], name) != NULL) {
+            return (GLint)(strlen(name) + 8 * i);
+        }
+    }
+    return -1;
+}
+
+// Objects
+static void glGenTextures(GLsizei n, GLuint *textures) { nullglGen(n, textures); }
+static void glGenBuffers(GLsizei n, GLuint *buffers) { nullglGen(n, buffers); }
+static void glGenVertexArrays(GLsizei n, GLuint *arrays) { nullglGen(n, arrays); }
+static void glGenFramebuffers(GLsizei n, GLuint *framebuffers) { nullglGen(n, framebuffers); }
+static void glGenRenderbuffers(GLsizei n, GLuint *renderbuffers) { nullglGen(n, renderbuffers); }
+static void glDeleteTextures(GLsizei n, const GLuint *textures) { (void)n; (void)textures; }
+static void glDeleteBuffers(GLsizei n, const GLuint *buffers) { (void)n; (void)buffers; }
+static void glDeleteVertexArrays(GLsizei n, const GLuint *arrays) { (void)n; (void)arrays; }
+static void glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers) { (void)n; (void)framebuffers; }
+static void glDeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers) { (void)n; (void)renderbuffers; }
+
+// Binding
+static void glBindTexture(GLenum target, GLuint texture) {
+    (void)target;
+    if (texture != nullglBoundTexture) nullRenderStats.textureBinds++;
+    nullglBoundTexture = texture;
+}
+static void glUseProgram(GLuint program) {
+    if (program != nullglProgram) nullRenderStats.shaderBinds++;
+    nullglProgram = program;
+}
+static void glActiveTexture(GLenum texture) { (void)texture; }
+static void glBindBuffer(GLenum target, GLuint buffer) { (void)target; (void)buffer; }
+static void glBindVertexArray(GLuint array) { (void)array; }
+static void glBindFramebuffer(GLenum target, GLuint framebuffer) { (void)target; (void)framebuffer; }
+static void glBindRenderbuffer(GLenum target, GLuint renderbuffer) { (void)target; (void)renderbuffer; }
+
+// Data
+static void glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage) {
+    (void)target; (void)data; (void)usage;
+    nullRenderStats.uploadBytes += size;
+}
+static void glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void *data) {
+    (void)target; (void)offset; (void)data;
+    nullRenderStats.uploadBytes += size;
+}
+static long nullglPixelBytes(GLenum format, GLenum type) {
+    if (type == GL_UNSIGNED_SHORT_5_6_5 || type == GL_UNSIGNED_SHORT_5_5_5_1 || type == GL_UNSIGNED_SHORT_4_4_4_4) return 2;
+    long channels = (format == GL_RGBA) ? 4 : (format == GL_RGB) ? 3 : (format == GL_RG) ? 2 : 1;
+    long size = (type == GL_FLOAT) ? 4 : (type == GL_HALF_FLOAT) ? 2 : 1;
+    return channels * size;
+}
+static void glTexImage2D(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border,
+                         GLenum format, GLenum type, const void *pixels) {
+    (void)target; (void)level; (void)internalformat; (void)border;
+    if (pixels != NULL) nullRenderStats.uploadBytes += (long long)width * height * nullglPixelBytes(format, type);
+}
+static void glTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height,
+                            GLenum format, GLenum type, const void *pixels) {
+    (void)target; (void)level; (void)xoffset; (void)yoffset; (void)width; (void)height; (void)format; (void)type; (void)pixels;
+}
+static void glCompressedTexImage2D(GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height,
+                                   GLint border, GLsizei imageSize, const void *data) {
+    (void)target; (void)level; (void)internalformat; (void)width; (void)height; (void)border; (void)data;
+    nullRenderStats.uploadBytes += imageSize;
+}
+static void glGetTexImage(GLenum target, GLint level, GLenum format, GLenum type, void *pixels) {
+    (void)target; (void)level; (void)format; (void)type; (void)pixels;
+}
+static void glReadPixels(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels) {
+    (void)x; (void)y; (void)format; (void)type;
+    if (pixels != NULL) memset(pixels, 0, (size_t)width * height * 4);
+}
+static void glGenerateMipmap(GLenum target) { (void)target; }
+static void glPixelStorei(GLenum pname, GLint param) { (void)pname; (void)param; }
+static void glTexParameteri(GLenum target, GLenum pname, GLint param) { (void)target; (void)pname; (void)param; }
+static void glTexParameterf(GLenum target, GLenum pname, GLfloat param) { (void)target; (void)pname; (void)param; }
+static void glTexParameteriv(GLenum target, GLenum pname, const GLint *params) { (void)target; (void)pname; (void)params; }
+
+// Drawing
+static void glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+    (void)mode; (void)first;
+    nullRenderStats.drawCalls++;
+    nullRenderStats.vertices += count;
+}
+// rlgl only draws indexed quads: 6 indices per 4 vertices
+static void glDrawElements(GLenum mode, GLsizei count, GLenum type, const void *indices) {
+    (void)mode; (void)type; (void)indices;
+    nullRenderStats.drawCalls++;
+    nullRenderStats.vertices += count / 6 * 4;
+}
+static void glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances) {
+    (void)mode; (void)first;
+    nullRenderStats.drawCalls++;
+    nullRenderStats.vertices += (long long)count * instances;
+}
+static void glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instances) {
+    (void)mode; (void)type; (void)indices;
+    nullRenderStats.drawCalls++;
+    nullRenderStats.vertices += (long long)count * instances;
+}
+static void glClear(GLbitfield mask) { (void)mask; }
+static void glClearColor(GLfloat r, GLfloat g, GLfloat b, GLfloat a) { (void)r; (void)g; (void)b; (void)a; }
+static void glClearDepth(GLdouble depth) { (void)depth; }
+static void glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1,
+                              GLint dstY1, GLbitfield mask, GLenum filter) {
+    (void)srcX0; (void)srcY0; (void)srcX1; (void)srcY1; (void)dstX0; (void)dstY0; (void)dstX1; (void)dstY1; (void)mask; (void)filter;
+}
+
+// Vertex attributes
+static void glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer) {
+    (void)index; (void)size; (void)type; (void)normalized; (void)stride; (void)pointer;
+}
+static void glEnableVertexAttribArray(GLuint index) { (void)index; }
+static void glDisableVertexAttribArray(GLuint index) { (void)index; }
+static void glVertexAttribDivisor(GLuint index, GLuint divisor) { (void)index; (void)divisor; }
+static void glVertexAttrib1fv(GLuint index, const GLfloat *v) { (void)index; (void)v; }
+static void glVertexAttrib2fv(GLuint index, const GLfloat *v) { (void)index; (void)v; }
+static void glVertexAttrib3fv(GLuint index, const GLfloat *v) { (void)index; (void)v; }
+static void glVertexAttrib4fv(GLuint index, const GLfloat *v) { (void)index; (void)v; }
+
+// Shaders
+static GLuint glCreateShader(GLenum type) {
+    (void)type;
+    return nullglNextName++;
+}
+static GLuint glCreateProgram(void) {
+    GLuint program = nullglNextName++;
+    if (program < NULLGL_MAX_SHADERS) nullglAttached[program][0] = nullglAttached[program][1] = 0;
+    return program;
+}
+static void glShaderSource(GLuint shader, GLsizei count, const GLchar *const *string, const GLint *length) {
+    (void)length;
+    if (shader >= NULLGL_MAX_SHADERS || count < 1) return;
+    free(nullglSource[shader]);
+    nullglSource[shader] = malloc(strlen(string[0]) + 1);
+    if (nullglSource[shader] != NULL) strcpy(nullglSource[shader], string[0]);
+}
+static void glAttachShader(GLuint program, GLuint shader) {
+    if (program >= NULLGL_MAX_SHADERS) return;
+    nullglAttached[program][(nullglAttached[program][0] == 0) ? 0 : 1] = shader;
+}
+static void glDeleteShader(GLuint shader) {
+    if (shader >= NULLGL_MAX_SHADERS) return;
+    free(nullglSource[shader]);
+    nullglSource[shader] = NULL;
+}
+static void glDetachShader(GLuint program, GLuint shader) { (void)program; (void)shader; }
+static void glCompileShader(GLuint shader) { (void)shader; }
+static void glLinkProgram(GLuint program) { (void)program; }
+static void glDeleteProgram(GLuint program) { (void)program; }
+static void glBindAttribLocation(GLuint program, GLuint index, const GLchar *name) { (void)program; (void)index; (void)name; }
+static void glGetShaderiv(GLuint shader, GLenum pname, GLint *params) {
+    (void)shader;
+    *params = (pname == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+}
+static void glGetProgramiv(GLuint program, GLenum pname, GLint *params) {
+    (void)program;
+    *params = (pname == GL_LINK_STATUS) ? GL_TRUE : 0;
+}
+static void glGetShaderInfoLog(GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog) {
+    (void)shader;
+    if (length != NULL) *length = 0;
+    if (bufSize > 0) infoLog[0] = '\0';
+}
+static void glGetProgramInfoLog(GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog) {
+    glGetShaderInfoLog(program, bufSize, length, infoLog);
+}
+static GLint glGetUniformLocation(GLuint program, const GLchar *name) { return nullglLocation(program, name); }
+static GLint glGetAttribLocation(GLuint program, const GLchar *name) { return nullglLocation(program, name); }
+
+// Uniforms
+static void glUniform1i(GLint location, GLint v0) { (void)location; (void)v0; }
+static void glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) { (void)location; (void)v0; (void)v1; (void)v2; (void)v3; }
+static void glUniform1fv(GLint location, GLsizei count, const GLfloat *value) { (void)location; (void)count; (void)value; }
+static void glUniform2fv(GLint location, GLsizei count, const GLfloat *value) { (void)location; (void)count; (void)value; }
+static void glUniform3fv(GLint location, GLsizei count, const GLfloat *value) { (void)location; (void)count; (void)value; }
+static void glUniform4fv(GLint location, GLsizei count, const GLfloat *value) { (void)location; (void)count; (void)value; }
+static void glUniform1iv(GLint location, GLsizei count, const GLint *value) { (void)location; (void)count; (void)value; }
+static void glUniform2iv(GLint location, GLsizei count, const GLint *value) { (void)location; (void)count; (void)value; }
+static void glUniform3iv(GLint location, GLsizei count, const GLint *value) { (void)location; (void)count; (void)value; }
+static void glUniform4iv(GLint location, GLsizei count, const GLint *value) { (void)location; (void)count; (void)value; }
+static void glUniform1uiv(GLint location, GLsizei count, const GLuint *value) { (void)location; (void)count; (void)value; }
+static void glUniform2uiv(GLint location, GLsizei count, const GLuint *value) { (void)location; (void)count; (void)value; }
+static void glUniform3uiv(GLint location, GLsizei count, const GLuint *value) { (void)location; (void)count; (void)value; }
+static void glUniform4uiv(GLint location, GLsizei count, const GLuint *value) { (void)location; (void)count; (void)value; }
+static void glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat *value) {
+    (void)location; (void)count; (void)transpose; (void)value;
+}
+
+// Framebuffers
+static void glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level) {
+    (void)target; (void)attachment; (void)textarget; (void)texture; (void)level;
+}
+static void glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer) {
+    (void)target; (void)attachment; (void)renderbuffertarget; (void)renderbuffer;
+}
+static void glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) {
+    (void)target; (void)internalformat; (void)width; (void)height;
+}
+static GLenum glCheckFramebufferStatus(GLenum target) { (void)target; return GL_FRAMEBUFFER_COMPLETE; }
+static void glGetFramebufferAttachmentParameteriv(GLenum target, GLenum attachment, GLenum pname, GLint *params) {
+    (void)target; (void)attachment; (void)pname;
+    *params = 0;
+}
+static void glDrawBuffers(GLsizei n, const GLenum *bufs) { (void)n; (void)bufs; }
+
+// State
+static void glEnable(GLenum cap) { (void)cap; }
+static void glDisable(GLenum cap) { (void)cap; }
+static void glViewport(GLint x, GLint y, GLsizei width, GLsizei height) { (void)x; (void)y; (void)width; (void)height; }
+static void glScissor(GLint x, GLint y, GLsizei width, GLsizei height) { (void)x; (void)y; (void)width; (void)height; }
+static void glBlendFunc(GLenum sfactor, GLenum dfactor) { (void)sfactor; (void)dfactor; }
+static void glBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    (void)srcRGB; (void)dstRGB; (void)srcAlpha; (void)dstAlpha;
+}
+static void glBlendEquation(GLenum mode) { (void)mode; }
+static void glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) { (void)modeRGB; (void)modeAlpha; }
+static void glDepthFunc(GLenum func) { (void)func; }
+static void glDepthMask(GLboolean flag) { (void)flag; }
+static void glColorMask(GLboolean r, GLboolean g, GLboolean b, GLboolean a) { (void)r; (void)g; (void)b; (void)a; }
+static void glCullFace(GLenum mode) { (void)mode; }
+static void glFrontFace(GLenum mode) { (void)mode; }
+static void glPolygonMode(GLenum face, GLenum mode) { (void)face; (void)mode; }
+static void glLineWidth(GLfloat width) { (void)width; }
+static GLenum glGetError(void) { return GL_NO_ERROR; }
+static void glGetIntegerv(GLenum pname, GLint *data) { *data = (pname == GL_MAX_TEXTURE_SIZE) ? 16384 : 0; }
+static void glGetFloatv(GLenum pname, GLfloat *data) { (void)pname; *data = 1.0f; }
+static const GLubyte *glGetString(GLenum name) {
+    switch (name) {
+        case GL_VENDOR: return (const GLubyte *)"null";
+        case GL_RENDERER: return (const GLubyte *)"null renderer";
+        case GL_VERSION: return (const GLubyte *)"3.3 null";
+        case GL_SHADING_LANGUAGE_VERSION: return (const GLubyte *)"3.30";
+        default: return (const GLubyte *)"";
+    }
+}
+#if defined(RLGL_SHOW_GL_DETAILS_INFO)     // rlgl only lists extensions then
+static const GLubyte *glGetStringi(GLenum name, GLuint index) { (void)name; (void)index; return (const GLubyte *)""; }
+#endif
+
+#endif // NULLGL_GLAD_H
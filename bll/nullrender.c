@@ -0,0 +1,1108 @@
+#include "nullrender.h"
+#include "raylib.h"
+#include "profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+
+// raylib builds rlgl and raymath into the library; here they are built into
+// this file, rlgl over the null GL in nullgl/external/glad.h and always with
+// batch flush reporting
+#define TRACELOG(level, ...) TraceLog(level, __VA_ARGS__)
+#define TRACELOGD(...) (void)0
+#define GRAPHICS_API_OPENGL_33
+#ifndef RLGL_BATCH_STATS
+#define RLGL_BATCH_STATS
+#endif
+#define RLGL_IMPLEMENTATION
+#include "rlgl.h"
+#define RAYMATH_IMPLEMENTATION
+#include "raymath.h"
+
+// The function bodies below follow raylib 5.5 (rcore, rshapes, rtextures,
+// rtext) closely enough to feed rlgl the same vertices, textures and batch
+// breaks the real library would.
+
+#define NULL_MONITOR_WIDTH 1920
+#define NULL_MONITOR_HEIGHT 1080
+#define NULL_MONITOR_HZ 60
+#define NULL_DEFAULT_FRAMES 600
+#define SMOOTH_CIRCLE_ERROR_RATE 0.5f
+#define TEXT_LINE_SPACING 2
+#define TEXTFORMAT_BUFFERS 4
+#define TEXTFORMAT_LENGTH 1024
+
+NullRenderStats nullRenderStats = {0};
+
+static struct {
+    int width;
+    int height;
+    unsigned int flags;
+    long long frameLimit;
+    double previousFrame;
+    float frameTime;
+    float smoothedFrameTime;
+    Font defaultFont;
+    Texture2D shapesTexture;
+    Rectangle shapesRec;
+} null = {0};
+
+void ResetNullRenderStats(void) {
+    memset(&nullRenderStats, 0, sizeof(nullRenderStats));
+}
+
+// ------------ Logging and text formatting ------------
+void TraceLog(int logLevel, const char *text, ...) {
+    static const char *prefixes[] = { "", "TRACE: ", "DEBUG: ", "INFO: ", "WARNING: ", "ERROR: ", "FATAL: " };
+    if (logLevel < LOG_INFO || logLevel > LOG_FATAL) return;
+
+    va_list args;
+    va_start(args, text);
+    printf("%s", prefixes[logLevel]);
+    vprintf(text, args);
+    printf("\n");
+    va_end(args);
+    if (logLevel == LOG_FATAL) exit(EXIT_FAILURE);
+}
+
+const char *TextFormat(const char *text, ...) {
+    static char buffers[TEXTFORMAT_BUFFERS][TEXTFORMAT_LENGTH];
+    static int index = 0;
+    char *buffer = buffers[index];
+    index = (index + 1) % TEXTFORMAT_BUFFERS;
+
+    va_list args;
+    va_start(args, text);
+    vsnprintf(buffer, TEXTFORMAT_LENGTH, text, args);
+    va_end(args);
+    return buffer;
+}
+
+bool FileExists(const char *fileName) {
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return false;
+    fclose(file);
+    return true;
+}
+
+// ------------ Random values (raylib's rprand: xoshiro128** seeded by splitmix64) ------------
+static uint64_t randSeed = 0xAABBCCDD;
+static uint32_t randState[4] = { 0x96ea83c1, 0x218b21e5, 0xaa91febd, 0x976414d4 };
+
+static uint64_t SplitMix64(void) {
+    uint64_t z = (randSeed += 0x9e3779b97f4a7c15);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+    return z ^ (z >> 31);
+}
+
+static uint32_t RotateLeft(uint32_t x, int bits) {
+    return (x << bits) | (x >> (32 - bits));
+}
+
+static uint32_t Xoshiro(void) {
+    uint32_t result = RotateLeft(randState[1] * 5, 7) * 9;
+    uint32_t t = randState[1] << 9;
+    randState[2] ^= randState[0];
+    randState[3] ^= randState[1];
+    randState[1] ^= randState[2];
+    randState[0] ^= randState[3];
+    randState[2] ^= t;
+    randState[3] = RotateLeft(randState[3], 11);
+    return result;
+}
+
+void SetRandomSeed(unsigned int seed) {
+    randSeed = (uint64_t)seed;
+    uint64_t a = SplitMix64(), b = SplitMix64();
+    randState[0] = (uint32_t)(a & 0xffffffff);
+    randState[1] = (uint32_t)(a >> 32);
+    randState[2] = (uint32_t)(b & 0xffffffff);
+    randState[3] = (uint32_t)(b >> 32);
+}
+
+int GetRandomValue(int min, int max) {
+    if (min > max) {
+        int tmp = max;
+        max = min;
+        min = tmp;
+    }
+    return (int)(Xoshiro() % (unsigned int)(abs(max - min) + 1)) + min;
+}
+
+// ------------ Colors and collisions ------------
+Color Fade(Color color, float alpha) {
+    if (alpha < 0.0f) alpha = 0.0f;
+    else if (alpha > 1.0f) alpha = 1.0f;
+    return (Color){ color.r, color.g, color.b, (unsigned char)(255.0f * alpha) };
+}
+
+Vector4 ColorNormalize(Color color) {
+    return (Vector4){ color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+}
+
+bool CheckCollisionCircles(Vector2 center1, float radius1, Vector2 center2, float radius2) {
+    float dx = center2.x - center1.x;
+    float dy = center2.y - center1.y;
+    return dx * dx + dy * dy <= (radius1 + radius2) * (radius1 + radius2);
+}
+
+bool CheckCollisionPointRec(Vector2 point, Rectangle rec) {
+    return point.x >= rec.x && point.x < rec.x + rec.width && point.y >= rec.y && point.y < rec.y + rec.height;
+}
+
+// ------------ Images ------------
+int GetPixelDataSize(int width, int height, int format) {
+    int bpp = 0;
+    switch (format) {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: bpp = 8; break;
+        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA:
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
+        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
+        case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4:
+        case PIXELFORMAT_UNCOMPRESSED_R16: bpp = 16; break;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8A8:
+        case PIXELFORMAT_UNCOMPRESSED_R32: bpp = 32; break;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8: bpp = 24; break;
+        case PIXELFORMAT_UNCOMPRESSED_R16G16B16: bpp = 48; break;
+        case PIXELFORMAT_UNCOMPRESSED_R16G16B16A16: bpp = 64; break;
+        case PIXELFORMAT_UNCOMPRESSED_R32G32B32: bpp = 96; break;
+        case PIXELFORMAT_UNCOMPRESSED_R32G32B32A32: bpp = 128; break;
+        case PIXELFORMAT_COMPRESSED_DXT1_RGB:
+        case PIXELFORMAT_COMPRESSED_DXT1_RGBA:
+        case PIXELFORMAT_COMPRESSED_ETC1_RGB:
+        case PIXELFORMAT_COMPRESSED_ETC2_RGB:
+        case PIXELFORMAT_COMPRESSED_PVRT_RGB:
+        case PIXELFORMAT_COMPRESSED_PVRT_RGBA: bpp = 4; break;
+        case PIXELFORMAT_COMPRESSED_DXT3_RGBA:
+        case PIXELFORMAT_COMPRESSED_DXT5_RGBA:
+        case PIXELFORMAT_COMPRESSED_ETC2_EAC_RGBA:
+        case PIXELFORMAT_COMPRESSED_ASTC_4x4_RGBA: bpp = 8; break;
+        case PIXELFORMAT_COMPRESSED_ASTC_8x8_RGBA: bpp = 2; break;
+        default: break;
+    }
+    int size = (int)((double)bpp / 8.0 * width * height);
+    // Block formats never take less than one block
+    if (width < 4 && height < 4 && format >= PIXELFORMAT_COMPRESSED_DXT1_RGB) {
+        size = (format < PIXELFORMAT_COMPRESSED_DXT3_RGBA) ? 8 : 16;
+    }
+    return size;
+}
+
+static unsigned int ReadBigEndian(const unsigned char *bytes, int count) {
+    unsigned int value = 0;
+    for (int i = 0; i < count; i++) value = (value << 8) | bytes[i];
+    return value;
+}
+
+// Size and channel layout from a PNG IHDR or a JPEG start-of-frame; false otherwise
+static bool ReadImageHeader(const char *fileName, int *width, int *height, int *format) {
+    FILE *file = fopen(fileName, "rb");
+    if (file == NULL) return false;
+    unsigned char head[32];
+    size_t got = fread(head, 1, sizeof(head), file);
+    bool found = false;
+
+    if (got >= 26 && memcmp(head, "\x89PNG\r\n\x1a\n", 8) == 0) {
+        *width = (int)ReadBigEndian(head + 16, 4);
+        *height = (int)ReadBigEndian(head + 20, 4);
+        switch (head[25]) {
+            case 0: *format = PIXELFORMAT_UNCOMPRESSED_GRAYSCALE; break;
+            case 2: *format = PIXELFORMAT_UNCOMPRESSED_R8G8B8; break;
+            case 4: *format = PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA; break;
+            default: *format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8; break;
+        }
+        found = true;
+    } else if (got >= 4 && head[0] == 0xFF && head[1] == 0xD8) {
+        // Walk the JPEG segments to the first SOFn
+        long offset = 2;
+        unsigned char segment[9];
+        while (!found && fseek(file, offset, SEEK_SET) == 0 && fread(segment, 1, sizeof(segment), file) == sizeof(segment)) {
+            if (segment[0] != 0xFF) break;
+            unsigned char marker = segment[1];
+            if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+                *height = (int)ReadBigEndian(segment + 5, 2);
+                *width = (int)ReadBigEndian(segment + 7, 2);
+                unsigned char components = 0;
+                if (fread(&components, 1, 1, file) != 1) break;
+                *format = (components == 1) ? PIXELFORMAT_UNCOMPRESSED_GRAYSCALE : PIXELFORMAT_UNCOMPRESSED_R8G8B8;
+                found = true;
+            }
+            offset += 2 + ReadBigEndian(segment + 2, 2);
+        }
+    }
+    fclose(file);
+    return found && *width > 0 && *height > 0;
+}
+
+// The real size and format, but blank (zeroed) pixels: nothing here is looked at
+Image LoadImage(const char *fileName) {
+    Image image = {0};
+    int width = 0, height = 0, format = 0;
+    if (!ReadImageHeader(fileName, &width, &height, &format)) {
+        TraceLog(LOG_WARNING, "IMAGE: Failed to load image data: %s", fileName);
+        return image;
+    }
+    image.data = calloc(1, GetPixelDataSize(width, height, format));
+    if (image.data == NULL) return image;
+    image.width = width;
+    image.height = height;
+    image.format = format;
+    image.mipmaps = 1;
+    return image;
+}
+
+void UnloadImage(Image image) {
+    free(image.data);
+}
+
+Image GenImageColor(int width, int height, Color color) {
+    Color *pixels = malloc((size_t)width * height * sizeof(Color));
+    for (int i = 0; pixels != NULL && i < width * height; i++) pixels[i] = color;
+    return (Image){ pixels, width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+}
+
+static Color ReadPixel(const unsigned char *data, int format, int i) {
+    switch (format) {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: return (Color){ data[i], data[i], data[i], 255 };
+        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA: return (Color){ data[2*i], data[2*i], data[2*i], data[2*i + 1] };
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8: return (Color){ data[3*i], data[3*i + 1], data[3*i + 2], 255 };
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5: {
+            unsigned short p = ((const unsigned short *)data)[i];
+            return (Color){ (unsigned char)((p >> 11) * 255 / 31), (unsigned char)(((p >> 5) & 0x3F) * 255 / 63),
+                            (unsigned char)((p & 0x1F) * 255 / 31), 255 };
+        }
+        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1: {
+            unsigned short p = ((const unsigned short *)data)[i];
+            return (Color){ (unsigned char)((p >> 11) * 255 / 31), (unsigned char)(((p >> 6) & 0x1F) * 255 / 31),
+                            (unsigned char)(((p >> 1) & 0x1F) * 255 / 31), (unsigned char)((p & 1) * 255) };
+        }
+        case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4: {
+            unsigned short p = ((const unsigned short *)data)[i];
+            return (Color){ (unsigned char)((p >> 12) * 17), (unsigned char)(((p >> 8) & 0xF) * 17),
+                            (unsigned char)(((p >> 4) & 0xF) * 17), (unsigned char)((p & 0xF) * 17) };
+        }
+        default: return ((const Color *)data)[i];
+    }
+}
+
+static void WritePixel(unsigned char *data, int format, int i, Color c) {
+    switch (format) {
+        case PIXELFORMAT_UNCOMPRESSED_GRAYSCALE: data[i] = (unsigned char)((c.r * 299 + c.g * 587 + c.b * 114) / 1000); break;
+        case PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA:
+            data[2*i] = (unsigned char)((c.r * 299 + c.g * 587 + c.b * 114) / 1000);
+            data[2*i + 1] = c.a;
+            break;
+        case PIXELFORMAT_UNCOMPRESSED_R8G8B8: data[3*i] = c.r; data[3*i + 1] = c.g; data[3*i + 2] = c.b; break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G6B5:
+            ((unsigned short *)data)[i] = (unsigned short)(((c.r * 31 / 255) << 11) | ((c.g * 63 / 255) << 5) | (c.b * 31 / 255));
+            break;
+        case PIXELFORMAT_UNCOMPRESSED_R5G5B5A1:
+            ((unsigned short *)data)[i] = (unsigned short)(((c.r * 31 / 255) << 11) | ((c.g * 31 / 255) << 6) |
+                                                           ((c.b * 31 / 255) << 1) | (c.a > 50));
+            break;
+        case PIXELFORMAT_UNCOMPRESSED_R4G4B4A4:
+            ((unsigned short *)data)[i] = (unsigned short)(((c.r / 17) << 12) | ((c.g / 17) << 8) | ((c.b / 17) << 4) | (c.a / 17));
+            break;
+        default: ((Color *)data)[i] = c; break;
+    }
+}
+
+static bool IsPlainFormat(int format) {
+    return format == PIXELFORMAT_UNCOMPRESSED_GRAYSCALE || format == PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA ||
+           format == PIXELFORMAT_UNCOMPRESSED_R5G6B5 || format == PIXELFORMAT_UNCOMPRESSED_R8G8B8 ||
+           format == PIXELFORMAT_UNCOMPRESSED_R5G5B5A1 || format == PIXELFORMAT_UNCOMPRESSED_R4G4B4A4 ||
+           format == PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+}
+
+Color *LoadImageColors(Image image) {
+    if (image.data == NULL || !IsPlainFormat(image.format)) return NULL;
+    Color *pixels = malloc((size_t)image.width * image.height * sizeof(Color));
+    for (int i = 0; pixels != NULL && i < image.width * image.height; i++) pixels[i] = ReadPixel(image.data, image.format, i);
+    return pixels;
+}
+
+void UnloadImageColors(Color *colors) {
+    free(colors);
+}
+
+// Replaces the pixels (top level only) with the same image in another format
+static void ConvertImage(Image *image, int format) {
+    Color *pixels = LoadImageColors(*image);
+    if (pixels == NULL) return;
+    unsigned char *data = malloc(GetPixelDataSize(image->width, image->height, format));
+    if (data == NULL) {
+        free(pixels);
+        return;
+    }
+    for (int i = 0; i < image->width * image->height; i++) WritePixel(data, format, i, pixels[i]);
+    free(pixels);
+    free(image->data);
+    image->data = data;
+    image->format = format;
+    image->mipmaps = 1;
+}
+
+// Nearest neighbour: the pixels are blank anyway, only the size matters
+void ImageResize(Image *image, int newWidth, int newHeight) {
+    if (image->data == NULL || newWidth <= 0 || newHeight <= 0 || !IsPlainFormat(image->format)) return;
+    int bytes = GetPixelDataSize(1, 1, image->format);
+    unsigned char *data = malloc((size_t)newWidth * newHeight * bytes);
+    if (data == NULL) return;
+    const unsigned char *source = image->data;
+    for (int y = 0; y < newHeight; y++) {
+        int sy = (int)((long long)y * image->height / newHeight);
+        for (int x = 0; x < newWidth; x++) {
+            int sx = (int)((long long)x * image->width / newWidth);
+            memcpy(data + ((size_t)y * newWidth + x) * bytes, source + ((size_t)sy * image->width + sx) * bytes, bytes);
+        }
+    }
+    free(image->data);
+    image->data = data;
+    image->width = newWidth;
+    image->height = newHeight;
+    image->mipmaps = 1;
+}
+
+// Allocates the full chain; the smaller levels stay blank
+void ImageMipmaps(Image *image) {
+    if (image->data == NULL || !IsPlainFormat(image->format)) return;
+    int count = 1;
+    int width = image->width, height = image->height;
+    int size = GetPixelDataSize(width, height, image->format);
+    int top = size;
+    while (width != 1 || height != 1) {
+        if (width != 1) width /= 2;
+        if (height != 1) height /= 2;
+        count++;
+        size += GetPixelDataSize(width, height, image->format);
+    }
+    unsigned char *data = realloc(image->data, size);
+    if (data == NULL) return;
+    memset(data + top, 0, size - top);
+    image->data = data;
+    image->mipmaps = count;
+}
+
+// Quantizes to the 16-bit format; blank pixels need no error diffusion
+void ImageDither(Image *image, int rBpp, int gBpp, int bBpp, int aBpp) {
+    if (rBpp == 5 && gBpp == 6 && bBpp == 5 && aBpp == 0) ConvertImage(image, PIXELFORMAT_UNCOMPRESSED_R5G6B5);
+    else if (rBpp == 5 && gBpp == 5 && bBpp == 5 && aBpp == 1) ConvertImage(image, PIXELFORMAT_UNCOMPRESSED_R5G5B5A1);
+    else if (rBpp == 4 && gBpp == 4 && bBpp == 4 && aBpp == 4) ConvertImage(image, PIXELFORMAT_UNCOMPRESSED_R4G4B4A4);
+    else TraceLog(LOG_WARNING, "IMAGE: Unsupported dithered OpenGL internal format: %ibpp (R%iG%iB%iA%i)",
+                  rBpp + gBpp + bBpp + aBpp, rBpp, gBpp, bBpp, aBpp);
+}
+
+void ImageDrawCircle(Image *dst, int centerX, int centerY, int radius, Color color) {
+    if (dst->data == NULL || !IsPlainFormat(dst->format)) return;
+    for (int y = -radius; y <= radius; y++) {
+        int py = centerY + y;
+        if (py < 0 || py >= dst->height) continue;
+        int span = (int)sqrtf((float)(radius * radius - y * y));
+        for (int x = -span; x <= span; x++) {
+            int px = centerX + x;
+            if (px >= 0 && px < dst->width) WritePixel(dst->data, dst->format, py * dst->width + px, color);
+        }
+    }
+}
+
+// ------------ Textures and render targets ------------
+Texture2D LoadTextureFromImage(Image image) {
+    Texture2D texture = {0};
+    if (image.data == NULL || image.width <= 0 || image.height <= 0) {
+        TraceLog(LOG_WARNING, "IMAGE: Data is not valid to load texture");
+        return texture;
+    }
+    texture.id = rlLoadTexture(image.data, image.width, image.height, image.format, image.mipmaps);
+    texture.width = image.width;
+    texture.height = image.height;
+    texture.mipmaps = image.mipmaps;
+    texture.format = image.format;
+    return texture;
+}
+
+void UnloadTexture(Texture2D texture) {
+    if (texture.id > 0) rlUnloadTexture(texture.id);
+}
+
+void SetTextureFilter(Texture2D texture, int filter) {
+    bool mips = texture.mipmaps > 1;
+    switch (filter) {
+        case TEXTURE_FILTER_POINT:
+            rlTextureParameters(texture.id, RL_TEXTURE_MIN_FILTER, mips ? RL_TEXTURE_FILTER_MIP_NEAREST : RL_TEXTURE_FILTER_NEAREST);
+            rlTextureParameters(texture.id, RL_TEXTURE_MAG_FILTER, RL_TEXTURE_FILTER_NEAREST);
+            break;
+        case TEXTURE_FILTER_BILINEAR:
+            rlTextureParameters(texture.id, RL_TEXTURE_MIN_FILTER, mips ? RL_TEXTURE_FILTER_LINEAR_MIP_NEAREST : RL_TEXTURE_FILTER_LINEAR);
+            rlTextureParameters(texture.id, RL_TEXTURE_MAG_FILTER, RL_TEXTURE_FILTER_LINEAR);
+            break;
+        case TEXTURE_FILTER_TRILINEAR:
+            if (!mips) TraceLog(LOG_WARNING, "TEXTURE: [ID %i] No mipmaps available for TRILINEAR texture filtering", texture.id);
+            rlTextureParameters(texture.id, RL_TEXTURE_MIN_FILTER, mips ? RL_TEXTURE_FILTER_MIP_LINEAR : RL_TEXTURE_FILTER_LINEAR);
+            rlTextureParameters(texture.id, RL_TEXTURE_MAG_FILTER, RL_TEXTURE_FILTER_LINEAR);
+            break;
+        default:
+            rlTextureParameters(texture.id, RL_TEXTURE_FILTER_ANISOTROPIC, 4 << (filter - TEXTURE_FILTER_ANISOTROPIC_4X));
+            break;
+    }
+}
+
+RenderTexture2D LoadRenderTexture(int width, int height) {
+    RenderTexture2D target = {0};
+    target.id = rlLoadFramebuffer();
+    if (target.id == 0) return target;
+
+    rlEnableFramebuffer(target.id);
+    target.texture = (Texture2D){ rlLoadTexture(NULL, width, height, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1), width, height, 1,
+                                  PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    target.depth = (Texture2D){ rlLoadTextureDepth(width, height, true), width, height, 1, 19 };
+    rlFramebufferAttach(target.id, target.texture.id, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+    rlFramebufferAttach(target.id, target.depth.id, RL_ATTACHMENT_DEPTH, RL_ATTACHMENT_RENDERBUFFER, 0);
+    rlFramebufferComplete(target.id);
+    rlDisableFramebuffer();
+    return target;
+}
+
+void UnloadRenderTexture(RenderTexture2D target) {
+    if (target.id == 0) return;
+    if (target.texture.id > 0) rlUnloadTexture(target.texture.id);
+    rlUnloadFramebuffer(target.id);
+}
+
+// ------------ Shaders ------------
+Shader LoadShaderFromMemory(const char *vsCode, const char *fsCode) {
+    Shader shader = {0};
+    shader.id = rlLoadShaderCode(vsCode, fsCode);
+    if (shader.id == rlGetShaderIdDefault()) {
+        shader.locs = rlGetShaderLocsDefault();
+    } else if (shader.id > 0) {
+        shader.locs = malloc(RL_MAX_SHADER_LOCATIONS * sizeof(int));
+        for (int i = 0; i < RL_MAX_SHADER_LOCATIONS; i++) shader.locs[i] = -1;
+        shader.locs[SHADER_LOC_VERTEX_POSITION] = rlGetLocationAttrib(shader.id, RL_DEFAULT_SHADER_ATTRIB_NAME_POSITION);
+        shader.locs[SHADER_LOC_VERTEX_TEXCOORD01] = rlGetLocationAttrib(shader.id, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD);
+        shader.locs[SHADER_LOC_VERTEX_TEXCOORD02] = rlGetLocationAttrib(shader.id, RL_DEFAULT_SHADER_ATTRIB_NAME_TEXCOORD2);
+        shader.locs[SHADER_LOC_VERTEX_NORMAL] = rlGetLocationAttrib(shader.id, RL_DEFAULT_SHADER_ATTRIB_NAME_NORMAL);
+        shader.locs[SHADER_LOC_VERTEX_TANGENT] = rlGetLocationAttrib(shader.id, RL_DEFAULT_SHADER_ATTRIB_NAME_TANGENT);
+        shader.locs[SHADER_LOC_VERTEX_COLOR] = rlGetLocationAttrib(shader.id, RL_DEFAULT_SHADER_ATTRIB_NAME_COLOR);
+        shader.locs[SHADER_LOC_MATRIX_MVP] = rlGetLocationUniform(shader.id, RL_DEFAULT_SHADER_UNIFORM_NAME_MVP);
+        shader.locs[SHADER_LOC_MATRIX_VIEW] = rlGetLocationUniform(shader.id, RL_DEFAULT_SHADER_UNIFORM_NAME_VIEW);
+        shader.locs[SHADER_LOC_MATRIX_PROJECTION] = rlGetLocationUniform(shader.id, RL_DEFAULT_SHADER_UNIFORM_NAME_PROJECTION);
+        shader.locs[SHADER_LOC_MATRIX_MODEL] = rlGetLocationUniform(shader.id, RL_DEFAULT_SHADER_UNIFORM_NAME_MODEL);
+        shader.locs[SHADER_LOC_MATRIX_NORMAL] = rlGetLocationUniform(shader.id, RL_DEFAULT_SHADER_UNIFORM_NAME_NORMAL);
+        shader.locs[SHADER_LOC_COLOR_DIFFUSE] = rlGetLocationUniform(shader.id, RL_DEFAULT_SHADER_UNIFORM_NAME_COLOR);
+        shader.locs[SHADER_LOC_MAP_DIFFUSE] = rlGetLocationUniform(shader.id, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE0);
+        shader.locs[SHADER_LOC_MAP_SPECULAR] = rlGetLocationUniform(shader.id, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE1);
+        shader.locs[SHADER_LOC_MAP_NORMAL] = rlGetLocationUniform(shader.id, RL_DEFAULT_SHADER_SAMPLER2D_NAME_TEXTURE2);
+    }
+    return shader;
+}
+
+void UnloadShader(Shader shader) {
+    if (shader.id == rlGetShaderIdDefault()) return;
+    rlUnloadShaderProgram(shader.id);
+    free(shader.locs);
+}
+
+int GetShaderLocation(Shader shader, const char *uniformName) {
+    return rlGetLocationUniform(shader.id, uniformName);
+}
+
+void SetShaderValue(Shader shader, int locIndex, const void *value, int uniformType) {
+    if (locIndex < 0) return;
+    rlEnableShader(shader.id);
+    rlSetUniform(locIndex, value, uniformType, 1);
+}
+
+void BeginShaderMode(Shader shader) {
+    rlSetShader(shader.id, shader.locs);
+}
+
+void EndShaderMode(void) {
+    rlSetShader(rlGetShaderIdDefault(), rlGetShaderLocsDefault());
+}
+
+// ------------ Window, frames and input ------------
+static void SetupViewport(int width, int height) {
+    rlViewport(0, 0, width, height);
+    rlMatrixMode(RL_PROJECTION);
+    rlLoadIdentity();
+    rlOrtho(0, width, height, 0, 0.0f, 1.0f);
+    rlMatrixMode(RL_MODELVIEW);
+    rlLoadIdentity();
+}
+
+static void LoadFontDefault(void);
+static void UnloadFontDefault(void);
+
+void InitWindow(int width, int height, const char *title) {
+    TraceLog(LOG_INFO, "NULL: Headless \"%s\" at %ix%i, nothing reaches a GPU", title, width, height);
+    null.width = width;
+    null.height = height;
+    const char *frames = getenv("NULL_RENDER_FRAMES");
+    null.frameLimit = (frames != NULL) ? atoll(frames) : NULL_DEFAULT_FRAMES;
+
+    rlLoadExtensions(NULL);
+    rlglInit(width, height);
+    SetupViewport(width, height);
+    LoadFontDefault();
+    null.shapesTexture = (Texture2D){ rlGetTextureIdDefault(), 1, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+    null.shapesRec = (Rectangle){ 0.0f, 0.0f, 1.0f, 1.0f };
+    SetRandomSeed((unsigned int)time(NULL));
+    null.previousFrame = ProfilerTime();
+}
+
+void CloseWindow(void) {
+    UnloadFontDefault();
+    rlglClose();
+}
+
+// No one can close the window, so the run ends on a frame count (0 never ends)
+bool WindowShouldClose(void) {
+    return null.frameLimit > 0 && nullRenderStats.frames >= null.frameLimit;
+}
+
+void SetConfigFlags(unsigned int flags) { null.flags |= flags; }
+void SetWindowState(unsigned int flags) { null.flags |= flags; }
+void ClearWindowState(unsigned int flags) { null.flags &= ~flags; }
+int GetScreenWidth(void) { return null.width; }
+int GetScreenHeight(void) { return null.height; }
+int GetMonitorCount(void) { return 1; }
+int GetCurrentMonitor(void) { return 0; }
+int GetMonitorWidth(int monitor) { return (monitor == 0) ? NULL_MONITOR_WIDTH : 0; }
+int GetMonitorHeight(int monitor) { return (monitor == 0) ? NULL_MONITOR_HEIGHT : 0; }
+int GetMonitorRefreshRate(int monitor) { return (monitor == 0) ? NULL_MONITOR_HZ : 0; }
+
+void BeginDrawing(void) {
+    rlLoadIdentity();
+}
+
+void EndDrawing(void) {
+    rlDrawRenderBatchActive();
+    nullRenderStats.frames++;
+
+    double now = ProfilerTime();
+    null.frameTime = (float)(now - null.previousFrame);
+    null.previousFrame = now;
+    null.smoothedFrameTime = (null.smoothedFrameTime == 0.0f) ? null.frameTime
+                           : 0.95f * null.smoothedFrameTime + 0.05f * null.frameTime;
+}
+
+float GetFrameTime(void) { return null.frameTime; }
+int GetFPS(void) { return (null.smoothedFrameTime > 0.0f) ? (int)roundf(1.0f / null.smoothedFrameTime) : 0; }
+
+void ClearBackground(Color color) {
+    rlClearColor(color.r, color.g, color.b, color.a);
+    rlClearScreenBuffers();
+}
+
+void BeginTextureMode(RenderTexture2D target) {
+    rlDrawRenderBatchActive();
+    rlEnableFramebuffer(target.id);
+    rlViewport(0, 0, target.texture.width, target.texture.height);
+    rlSetFramebufferWidth(target.texture.width);
+    rlSetFramebufferHeight(target.texture.height);
+    rlMatrixMode(RL_PROJECTION);
+    rlLoadIdentity();
+    rlOrtho(0, target.texture.width, target.texture.height, 0, 0.0f, 1.0f);
+    rlMatrixMode(RL_MODELVIEW);
+    rlLoadIdentity();
+}
+
+void EndTextureMode(void) {
+    rlDrawRenderBatchActive();
+    rlDisableFramebuffer();
+    SetupViewport(null.width, null.height);
+    rlSetFramebufferWidth(null.width);
+    rlSetFramebufferHeight(null.height);
+}
+
+// Same transform as raylib: offset, then rotate and zoom about the target
+Matrix GetCameraMatrix2D(Camera2D camera) {
+    Matrix origin = MatrixTranslate(-camera.target.x, -camera.target.y, 0.0f);
+    Matrix rotation = MatrixRotate((Vector3){ 0.0f, 0.0f, 1.0f }, camera.rotation * DEG2RAD);
+    Matrix scale = MatrixScale(camera.zoom, camera.zoom, 1.0f);
+    Matrix translation = MatrixTranslate(camera.offset.x, camera.offset.y, 0.0f);
+    return MatrixMultiply(MatrixMultiply(origin, MatrixMultiply(scale, rotation)), translation);
+}
+
+void BeginMode2D(Camera2D camera) {
+    rlDrawRenderBatchActive();
+    rlLoadIdentity();
+    rlMultMatrixf(MatrixToFloatV(GetCameraMatrix2D(camera)).v);
+}
+
+void EndMode2D(void) {
+    rlDrawRenderBatchActive();
+    rlLoadIdentity();
+}
+
+bool IsKeyPressed(int key) { (void)key; return false; }
+bool IsKeyDown(int key) { (void)key; return false; }
+bool IsKeyReleased(int key) { (void)key; return false; }
+int GetKeyPressed(void) { return 0; }
+int GetCharPressed(void) { return 0; }
+bool IsMouseButtonPressed(int button) { (void)button; return false; }
+Vector2 GetMousePosition(void) { return (Vector2){ 0.0f, 0.0f }; }
+
+// ------------ Audio: a device that plays nothing ------------
+void InitAudioDevice(void) { TraceLog(LOG_INFO, "NULL: Audio device is silent"); }
+void CloseAudioDevice(void) {}
+void SetMasterVolume(float volume) { (void)volume; }
+
+Wave LoadWave(const char *fileName) {
+    Wave wave = {0};
+    if (!FileExists(fileName)) {
+        TraceLog(LOG_WARNING, "WAVE: Failed to load %s", fileName);
+        return wave;
+    }
+    wave.frameCount = 1;
+    wave.sampleRate = 44100;
+    wave.sampleSize = 16;
+    wave.channels = 2;
+    wave.data = calloc(1, 4);
+    return wave;
+}
+
+void UnloadWave(Wave wave) { free(wave.data); }
+
+Sound LoadSoundFromWave(Wave wave) {
+    Sound sound = {0};
+    if (wave.data == NULL) return sound;
+    sound.frameCount = wave.frameCount;
+    sound.stream.sampleRate = wave.sampleRate;
+    sound.stream.sampleSize = wave.sampleSize;
+    sound.stream.channels = wave.channels;
+    return sound;
+}
+
+Sound LoadSound(const char *fileName) {
+    Wave wave = LoadWave(fileName);
+    Sound sound = LoadSoundFromWave(wave);
+    UnloadWave(wave);
+    return sound;
+}
+
+void UnloadSound(Sound sound) { (void)sound; }
+void PlaySound(Sound sound) { (void)sound; }
+
+// No decoder context, so the game never starts or unloads the stream
+Music LoadMusicStream(const char *fileName) {
+    Music music = {0};
+    if (!FileExists(fileName)) TraceLog(LOG_WARNING, "STREAM: Failed to load %s", fileName);
+    return music;
+}
+
+void UnloadMusicStream(Music music) { (void)music; }
+void PlayMusicStream(Music music) { (void)music; }
+void UpdateMusicStream(Music music) { (void)music; }
+void SetMusicVolume(Music music, float volume) { (void)music; (void)volume; }
+
+// ------------ Shapes ------------
+static void ShapesTexCoord(float u, float v) {
+    rlTexCoord2f((null.shapesRec.x + u * null.shapesRec.width) / null.shapesTexture.width,
+                 (null.shapesRec.y + v * null.shapesRec.height) / null.shapesTexture.height);
+}
+
+void DrawLine(int startPosX, int startPosY, int endPosX, int endPosY, Color color) {
+    rlBegin(RL_LINES);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        rlVertex2f((float)startPosX, (float)startPosY);
+        rlVertex2f((float)endPosX, (float)endPosY);
+    rlEnd();
+}
+
+static void DrawStrip(const Vector2 *points, int pointCount, Color color) {
+    if (pointCount < 3) return;
+    rlBegin(RL_TRIANGLES);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        for (int i = 2; i < pointCount; i++) {
+            if ((i % 2) == 0) {
+                rlVertex2f(points[i].x, points[i].y);
+                rlVertex2f(points[i - 2].x, points[i - 2].y);
+                rlVertex2f(points[i - 1].x, points[i - 1].y);
+            } else {
+                rlVertex2f(points[i].x, points[i].y);
+                rlVertex2f(points[i - 1].x, points[i - 1].y);
+                rlVertex2f(points[i - 2].x, points[i - 2].y);
+            }
+        }
+    rlEnd();
+}
+
+void DrawLineEx(Vector2 startPos, Vector2 endPos, float thick, Color color) {
+    Vector2 delta = { endPos.x - startPos.x, endPos.y - startPos.y };
+    float length = sqrtf(delta.x * delta.x + delta.y * delta.y);
+    if (length <= 0.0f || thick <= 0.0f) return;
+
+    float scale = thick / (2.0f * length);
+    Vector2 radius = { -scale * delta.y, scale * delta.x };
+    Vector2 strip[4] = {
+        { startPos.x - radius.x, startPos.y - radius.y }, { startPos.x + radius.x, startPos.y + radius.y },
+        { endPos.x - radius.x, endPos.y - radius.y }, { endPos.x + radius.x, endPos.y + radius.y }
+    };
+    DrawStrip(strip, 4, color);
+}
+
+void DrawTriangle(Vector2 v1, Vector2 v2, Vector2 v3, Color color) {
+    rlSetTexture(null.shapesTexture.id);
+    rlBegin(RL_QUADS);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        ShapesTexCoord(0, 0); rlVertex2f(v1.x, v1.y);
+        ShapesTexCoord(0, 1); rlVertex2f(v2.x, v2.y);
+        ShapesTexCoord(1, 1); rlVertex2f(v2.x, v2.y);
+        ShapesTexCoord(1, 0); rlVertex2f(v3.x, v3.y);
+    rlEnd();
+    rlSetTexture(0);
+}
+
+// Segments for a smooth arc of this radius over the given degrees
+static int ArcSegments(float radius, float degrees, int minimum) {
+    float th = acosf(2.0f * powf(1.0f - SMOOTH_CIRCLE_ERROR_RATE / radius, 2.0f) - 1.0f);
+    int segments = (int)(degrees * ceilf(2.0f * PI / th) / 360.0f);
+    return (segments > 0) ? segments : minimum;
+}
+
+// Quads fanned around a centre, two segments per quad
+static void DrawFanQuads(Vector2 center, float radius, float angle, float step, int segments, Color color) {
+    for (int i = 0; i < segments / 2; i++) {
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        ShapesTexCoord(0, 0); rlVertex2f(center.x, center.y);
+        ShapesTexCoord(1, 0); rlVertex2f(center.x + cosf(DEG2RAD * (angle + 2.0f * step)) * radius, center.y + sinf(DEG2RAD * (angle + 2.0f * step)) * radius);
+        ShapesTexCoord(1, 1); rlVertex2f(center.x + cosf(DEG2RAD * (angle + step)) * radius, center.y + sinf(DEG2RAD * (angle + step)) * radius);
+        ShapesTexCoord(0, 1); rlVertex2f(center.x + cosf(DEG2RAD * angle) * radius, center.y + sinf(DEG2RAD * angle) * radius);
+        angle += 2.0f * step;
+    }
+    if (segments % 2 == 1) {
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        ShapesTexCoord(0, 0); rlVertex2f(center.x, center.y);
+        ShapesTexCoord(1, 1); rlVertex2f(center.x + cosf(DEG2RAD * (angle + step)) * radius, center.y + sinf(DEG2RAD * (angle + step)) * radius);
+        ShapesTexCoord(0, 1); rlVertex2f(center.x + cosf(DEG2RAD * angle) * radius, center.y + sinf(DEG2RAD * angle) * radius);
+        ShapesTexCoord(1, 0); rlVertex2f(center.x, center.y);
+    }
+}
+
+void DrawCircleV(Vector2 center, float radius, Color color) {
+    if (radius <= 0.0f) radius = 0.1f;
+    int segments = 36;
+    if (segments < 4) segments = ArcSegments(radius, 360.0f, 4);
+
+    rlSetTexture(null.shapesTexture.id);
+    rlBegin(RL_QUADS);
+        DrawFanQuads(center, radius, 0.0f, 360.0f / segments, segments, color);
+    rlEnd();
+    rlSetTexture(0);
+}
+
+void DrawCircleLines(int centerX, int centerY, float radius, Color color) {
+    rlBegin(RL_LINES);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        for (int i = 0; i < 360; i += 10) {
+            rlVertex2f(centerX + cosf(DEG2RAD * i) * radius, centerY + sinf(DEG2RAD * i) * radius);
+            rlVertex2f(centerX + cosf(DEG2RAD * (i + 10)) * radius, centerY + sinf(DEG2RAD * (i + 10)) * radius);
+        }
+    rlEnd();
+}
+
+static void DrawShapeQuad(Vector2 topLeft, Vector2 bottomLeft, Vector2 bottomRight, Vector2 topRight, Color color) {
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    ShapesTexCoord(0, 0); rlVertex2f(topLeft.x, topLeft.y);
+    ShapesTexCoord(0, 1); rlVertex2f(bottomLeft.x, bottomLeft.y);
+    ShapesTexCoord(1, 1); rlVertex2f(bottomRight.x, bottomRight.y);
+    ShapesTexCoord(1, 0); rlVertex2f(topRight.x, topRight.y);
+}
+
+void DrawRectangleRec(Rectangle rec, Color color) {
+    rlSetTexture(null.shapesTexture.id);
+    rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        DrawShapeQuad((Vector2){ rec.x, rec.y }, (Vector2){ rec.x, rec.y + rec.height },
+                      (Vector2){ rec.x + rec.width, rec.y + rec.height }, (Vector2){ rec.x + rec.width, rec.y }, color);
+    rlEnd();
+    rlSetTexture(0);
+}
+
+void DrawRectangle(int posX, int posY, int width, int height, Color color) {
+    DrawRectangleRec((Rectangle){ (float)posX, (float)posY, (float)width, (float)height }, color);
+}
+
+void DrawRectangleLines(int posX, int posY, int width, int height, Color color) {
+    float x = posX + 0.5f, y = posY + 0.5f;
+    float right = posX + width - 0.5f, bottom = posY + height - 0.5f;
+    rlBegin(RL_LINES);
+        rlColor4ub(color.r, color.g, color.b, color.a);
+        rlVertex2f(x, y); rlVertex2f(right, y);
+        rlVertex2f(right, y); rlVertex2f(right, bottom);
+        rlVertex2f(right, bottom); rlVertex2f(x, bottom);
+        rlVertex2f(x, bottom); rlVertex2f(x, y);
+    rlEnd();
+}
+
+void DrawRectangleRounded(Rectangle rec, float roundness, int segments, Color color) {
+    if (roundness <= 0.0f || rec.width < 1 || rec.height < 1) {
+        DrawRectangleRec(rec, color);
+        return;
+    }
+    if (roundness > 1.0f) roundness = 1.0f;
+    float radius = ((rec.width > rec.height) ? rec.height : rec.width) * roundness / 2.0f;
+    if (radius <= 0.0f) return;
+    if (segments < 4) segments = ArcSegments(radius, 90.0f, 4);
+    float step = 90.0f / segments;
+
+    float left = rec.x, top = rec.y, right = rec.x + rec.width, bottom = rec.y + rec.height;
+    Vector2 inner[4] = {
+        { left + radius, top + radius }, { right - radius, top + radius },
+        { right - radius, bottom - radius }, { left + radius, bottom - radius }
+    };
+    const float angles[4] = { 180.0f, 270.0f, 0.0f, 90.0f };
+
+    rlSetTexture(null.shapesTexture.id);
+    rlBegin(RL_QUADS);
+        for (int k = 0; k < 4; k++) DrawFanQuads(inner[k], radius, angles[k], step, segments, color);
+        // Top, right, bottom, left bands, then the middle
+        DrawShapeQuad((Vector2){ inner[0].x, top }, inner[0], inner[1], (Vector2){ inner[1].x, top }, color);
+        DrawShapeQuad(inner[1], inner[2], (Vector2){ right, inner[2].y }, (Vector2){ right, inner[1].y }, color);
+        DrawShapeQuad(inner[3], (Vector2){ inner[3].x, bottom }, (Vector2){ inner[2].x, bottom }, inner[2], color);
+        DrawShapeQuad((Vector2){ left, inner[0].y }, (Vector2){ left, inner[3].y }, inner[3], inner[0], color);
+        DrawShapeQuad(inner[0], inner[3], inner[2], inner[1], color);
+    rlEnd();
+    rlSetTexture(0);
+}
+
+// ------------ Texture drawing ------------
+void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) {
+    if (texture.id == 0) return;
+    float width = (float)texture.width;
+    float height = (float)texture.height;
+    bool flipX = false;
+    if (source.width < 0) { flipX = true; source.width *= -1; }
+    if (source.height < 0) source.y -= source.height;
+    if (dest.width < 0) dest.width *= -1;
+    if (dest.height < 0) dest.height *= -1;
+
+    Vector2 topLeft, topRight, bottomLeft, bottomRight;
+    if (rotation == 0.0f) {
+        float x = dest.x - origin.x;
+        float y = dest.y - origin.y;
+        topLeft = (Vector2){ x, y };
+        topRight = (Vector2){ x + dest.width, y };
+        bottomLeft = (Vector2){ x, y + dest.height };
+        bottomRight = (Vector2){ x + dest.width, y + dest.height };
+    } else {
+        float s = sinf(rotation * DEG2RAD), c = cosf(rotation * DEG2RAD);
+        float dx = -origin.x, dy = -origin.y;
+        topLeft = (Vector2){ dest.x + dx * c - dy * s, dest.y + dx * s + dy * c };
+        topRight = (Vector2){ dest.x + (dx + dest.width) * c - dy * s, dest.y + (dx + dest.width) * s + dy * c };
+        bottomLeft = (Vector2){ dest.x + dx * c - (dy + dest.height) * s, dest.y + dx * s + (dy + dest.height) * c };
+        bottomRight = (Vector2){ dest.x + (dx + dest.width) * c - (dy + dest.height) * s,
+                                 dest.y + (dx + dest.width) * s + (dy + dest.height) * c };
+    }
+    float u0 = source.x / width, u1 = (source.x + source.width) / width;
+    float v0 = source.y / height, v1 = (source.y + source.height) / height;
+    if (flipX) {
+        float u = u0;
+        u0 = u1;
+        u1 = u;
+    }
+
+    rlSetTexture(texture.id);
+    rlBegin(RL_QUADS);
+        rlColor4ub(tint.r, tint.g, tint.b, tint.a);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        rlTexCoord2f(u0, v0); rlVertex2f(topLeft.x, topLeft.y);
+        rlTexCoord2f(u0, v1); rlVertex2f(bottomLeft.x, bottomLeft.y);
+        rlTexCoord2f(u1, v1); rlVertex2f(bottomRight.x, bottomRight.y);
+        rlTexCoord2f(u1, v0); rlVertex2f(topRight.x, topRight.y);
+    rlEnd();
+    rlSetTexture(0);
+}
+
+void DrawTextureEx(Texture2D texture, Vector2 position, float rotation, float scale, Color tint) {
+    Rectangle source = { 0.0f, 0.0f, (float)texture.width, (float)texture.height };
+    Rectangle dest = { position.x, position.y, texture.width * scale, texture.height * scale };
+    DrawTexturePro(texture, source, dest, (Vector2){ 0.0f, 0.0f }, rotation, tint);
+}
+
+void DrawTexture(Texture2D texture, int posX, int posY, Color tint) {
+    DrawTextureEx(texture, (Vector2){ (float)posX, (float)posY }, 0.0f, 1.0f, tint);
+}
+
+void DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint) {
+    Rectangle dest = { position.x, position.y, fabsf(source.width), fabsf(source.height) };
+    DrawTexturePro(texture, source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, tint);
+}
+
+// ------------ Text ------------
+// raylib's default font: 224 glyphs from ' ', 10 px tall, these widths
+static const unsigned char defaultGlyphWidths[224] = {
+    3, 1, 4, 6, 5, 7, 6, 2, 3, 3, 5, 5, 2, 4, 1, 7, 5, 2, 5, 5, 5, 5, 5, 5, 5, 5, 1, 1, 3, 4, 3, 6,
+    7, 6, 6, 6, 6, 6, 6, 6, 6, 3, 5, 6, 5, 7, 6, 6, 6, 6, 6, 6, 7, 6, 7, 7, 6, 6, 6, 2, 7, 2, 3, 5,
+    2, 5, 5, 5, 5, 5, 4, 5, 5, 1, 2, 5, 2, 5, 5, 5, 5, 5, 5, 5, 4, 5, 5, 5, 5, 5, 5, 3, 1, 3, 4, 4,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 5, 5, 5, 7, 1, 5, 3, 7, 3, 5, 4, 1, 7, 4, 3, 5, 3, 3, 2, 5, 6, 1, 2, 2, 3, 5, 6, 6, 6, 6,
+    6, 6, 6, 6, 6, 6, 7, 6, 6, 6, 6, 6, 3, 3, 3, 3, 7, 6, 6, 6, 6, 6, 6, 5, 6, 6, 6, 6, 6, 6, 4, 6,
+    5, 5, 5, 5, 5, 5, 9, 5, 5, 5, 5, 5, 2, 2, 3, 3, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5
+};
+
+// Same atlas layout as raylib's, on a blank 128x128 texture
+static void LoadFontDefault(void) {
+    const int glyphs = 224, atlas = 128, glyphHeight = 10, divisor = 1;
+    Font *font = &null.defaultFont;
+    font->glyphCount = glyphs;
+    font->baseSize = glyphHeight;
+    font->glyphPadding = 0;
+    font->recs = calloc(glyphs, sizeof(Rectangle));
+    font->glyphs = calloc(glyphs, sizeof(GlyphInfo));
+    font->texture = (Texture2D){ rlLoadTexture(NULL, atlas, atlas, PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA, 1), atlas, atlas, 1,
+                                 PIXELFORMAT_UNCOMPRESSED_GRAY_ALPHA };
+
+    int line = 0, x = divisor;
+    for (int i = 0; i < glyphs; i++) {
+        int width = defaultGlyphWidths[i];
+        if (x + width + divisor >= atlas) {
+            line++;
+            x = divisor;
+        }
+        font->recs[i] = (Rectangle){ (float)x, (float)(divisor + line * (glyphHeight + divisor)), (float)width, (float)glyphHeight };
+        font->glyphs[i].value = 32 + i;
+        x += width + divisor;
+    }
+}
+
+static void UnloadFontDefault(void) {
+    rlUnloadTexture(null.defaultFont.texture.id);
+    free(null.defaultFont.recs);
+    free(null.defaultFont.glyphs);
+    memset(&null.defaultFont, 0, sizeof(null.defaultFont));
+}
+
+Font GetFontDefault(void) {
+    return null.defaultFont;
+}
+
+// TTF rasterising is out of scope: every font is the default one
+Font LoadFont(const char *fileName) {
+    if (FileExists(fileName)) TraceLog(LOG_INFO, "NULL: %s stands in as the default font", fileName);
+    return GetFontDefault();
+}
+
+void UnloadFont(Font font) {
+    if (font.texture.id == null.defaultFont.texture.id) return;
+    rlUnloadTexture(font.texture.id);
+    free(font.recs);
+    free(font.glyphs);
+}
+
+// UTF-8 decode; invalid bytes read as '?'
+static int NextCodepoint(const char *text, int *size) {
+    const unsigned char *s = (const unsigned char *)text;
+    *size = 1;
+    if (s[0] < 0x80) return s[0];
+    if ((s[0] & 0xE0) == 0xC0 && (s[1] & 0xC0) == 0x80) {
+        *size = 2;
+        return ((s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+    }
+    if ((s[0] & 0xF0) == 0xE0 && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80) {
+        *size = 3;
+        return ((s[0] & 0x0F) << 12) | ((s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+    }
+    if ((s[0] & 0xF8) == 0xF0 && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80 && (s[3] & 0xC0) == 0x80) {
+        *size = 4;
+        return ((s[0] & 0x07) << 18) | ((s[1] & 0x3F) << 12) | ((s[2] & 0x3F) << 6) | (s[3] & 0x3F);
+    }
+    return '?';
+}
+
+static int GlyphIndex(Font font, int codepoint) {
+    int fallback = 0;
+    for (int i = 0; i < font.glyphCount; i++) {
+        if (font.glyphs[i].value == codepoint) return i;
+        if (font.glyphs[i].value == '?') fallback = i;
+    }
+    return fallback;
+}
+
+static float GlyphAdvance(Font font, int index) {
+    return (font.glyphs[index].advanceX > 0) ? (float)font.glyphs[index].advanceX : font.recs[index].width;
+}
+
+static void DrawGlyph(Font font, int index, Vector2 position, float fontSize, Color tint) {
+    float scale = fontSize / font.baseSize;
+    float padding = (float)font.glyphPadding;
+    Rectangle dest = {
+        position.x + (font.glyphs[index].offsetX - padding) * scale,
+        position.y + (font.glyphs[index].offsetY - padding) * scale,
+        (font.recs[index].width + 2.0f * padding) * scale,
+        (font.recs[index].height + 2.0f * padding) * scale
+    };
+    Rectangle source = { font.recs[index].x - padding, font.recs[index].y - padding,
+                         font.recs[index].width + 2.0f * padding, font.recs[index].height + 2.0f * padding };
+    DrawTexturePro(font.texture, source, dest, (Vector2){ 0.0f, 0.0f }, 0.0f, tint);
+}
+
+void DrawTextEx(Font font, const char *text, Vector2 position, float fontSize, float spacing, Color tint) {
+    if (font.texture.id == 0) font = GetFontDefault();
+    float scale = fontSize / font.baseSize;
+    float offsetX = 0.0f, offsetY = 0.0f;
+
+    for (int i = 0; text[i] != '\0';) {
+        int size = 0;
+        int codepoint = NextCodepoint(&text[i], &size);
+        int index = GlyphIndex(font, codepoint);
+        if (codepoint == '\n') {
+            offsetY += fontSize + TEXT_LINE_SPACING;
+            offsetX = 0.0f;
+        } else {
+            if (codepoint != ' ' && codepoint != '\t') {
+                DrawGlyph(font, index, (Vector2){ position.x + offsetX, position.y + offsetY }, fontSize, tint);
+            }
+            offsetX += GlyphAdvance(font, index) * scale + spacing;
+        }
+        i += size;
+    }
+}
+
+void DrawText(const char *text, int posX, int posY, int fontSize, Color color) {
+    if (null.defaultFont.texture.id == 0) return;
+    if (fontSize < 10) fontSize = 10;
+    DrawTextEx(null.defaultFont, text, (Vector2){ (float)posX, (float)posY }, (float)fontSize, (float)(fontSize / 10), color);
+}
+
+Vector2 MeasureTextEx(Font font, const char *text, float fontSize, float spacing) {
+    Vector2 size = { 0.0f, 0.0f };
+    if (font.texture.id == 0 || text == NULL || text[0] == '\0') return size;
+    float scale = fontSize / font.baseSize;
+    float width = 0.0f, widest = 0.0f, height = fontSize;
+    int letters = 0, mostLetters = 0;
+
+    for (int i = 0; text[i] != '\0';) {
+        int bytes = 0;
+        int codepoint = NextCodepoint(&text[i], &bytes);
+        int index = GlyphIndex(font, codepoint);
+        i += bytes;
+        letters++;
+        if (codepoint != '\n') {
+            width += (font.glyphs[index].advanceX > 0) ? font.glyphs[index].advanceX
+                                                       : font.recs[index].width + font.glyphs[index].offsetX;
+        } else {
+            if (widest < width) widest = width;
+            letters = 0;
+            width = 0.0f;
+            height += fontSize + TEXT_LINE_SPACING;
+        }
+        if (mostLetters < letters) mostLetters = letters;
+    }
+    if (widest < width) widest = width;
+    size.x = widest * scale + (mostLetters - 1) * spacing;
+    size.y = height;
+    return size;
+}
+
+int MeasureText(const char *text, int fontSize) {
+    if (null.defaultFont.texture.id == 0) return 0;
+    if (fontSize < 10) fontSize = 10;
+    return (int)MeasureTextEx(null.defaultFont, text, (float)fontSize, (float)(fontSize / 10)).x;
+}
@@ -0,0 +1,29 @@
+#ifndef NULLRENDER_H
+#define NULLRENDER_H
+
+// Null render backend: a build of the game with no window, GPU or audio
+// device, for CI and load-test hosts. nullrender.c stands in for the raylib
+// library, implementing the part of its API the game uses. Drawing runs
+// raylib's real rlgl batcher (rlgl.h built with RLGL_IMPLEMENTATION) on top
+// of a null OpenGL (nullgl/external/glad.h) that only counts what would have
+// been sent to the GPU. Images are sized from the file headers but not
+// decoded, fonts use the default font's metrics, and sounds are silent.
+//
+// Build with -DNULL_RENDER -Inullgl and nullrender.c in place of -lraylib.
+// Input never arrives, so WindowShouldClose ends the run after
+// NULL_RENDER_FRAMES frames (600 unless that environment variable says so).
+
+typedef struct {
+    long long frames;
+    long long drawCalls;        // glDrawArrays/glDrawElements
+    long long vertices;         // vertices those draw calls consumed
+    long long textureBinds;     // glBindTexture calls that changed the binding
+    long long shaderBinds;      // glUseProgram calls that changed the program
+    long long uploadBytes;      // buffer and texture data handed to the GL
+} NullRenderStats;
+
+extern NullRenderStats nullRenderStats;
+
+void ResetNullRenderStats(void);
+
+#endif // NULLRENDER_H
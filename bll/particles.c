@@ -0,0 +1,147 @@
+#include "particles.h"
+#include "rlgl.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static float NextRandom(unsigned int *state) {
+    // xorshift32, mapped to [0, 1)
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return (*state >> 8) * (1.0f / 16777216.0f);
+}
+
+void LoadParticleSystem(ParticleSystem *ps, int capacity, Texture2D texture) {
+    UnloadParticleSystem(ps);
+    if (capacity < 1) capacity = 1;
+
+    ps->capacity = capacity;
+    ps->texture = texture;
+    ps->x = malloc(sizeof(float) * capacity);
+    ps->y = malloc(sizeof(float) * capacity);
+    ps->vx = malloc(sizeof(float) * capacity);
+    ps->vy = malloc(sizeof(float) * capacity);
+    ps->life = malloc(sizeof(float) * capacity);
+    ps->lifeTotal = malloc(sizeof(float) * capacity);
+    ps->sizeStart = malloc(sizeof(float) * capacity);
+    ps->sizeEnd = malloc(sizeof(float) * capacity);
+    ps->gravity = malloc(sizeof(float) * capacity);
+    ps->drag = malloc(sizeof(float) * capacity);
+    ps->colorStart = malloc(sizeof(Color) * capacity);
+    ps->colorEnd = malloc(sizeof(Color) * capacity);
+    if (!ps->x || !ps->y || !ps->vx || !ps->vy || !ps->life || !ps->lifeTotal || !ps->sizeStart ||
+        !ps->sizeEnd || !ps->gravity || !ps->drag || !ps->colorStart || !ps->colorEnd) {
+        UnloadParticleSystem(ps);
+    }
+}
+
+void UnloadParticleSystem(ParticleSystem *ps) {
+    free(ps->x);
+    free(ps->y);
+    free(ps->vx);
+    free(ps->vy);
+    free(ps->life);
+    free(ps->lifeTotal);
+    free(ps->sizeStart);
+    free(ps->sizeEnd);
+    free(ps->gravity);
+    free(ps->drag);
+    free(ps->colorStart);
+    free(ps->colorEnd);
+    memset(ps, 0, sizeof(*ps));
+}
+
+void ClearParticles(ParticleSystem *ps) {
+    ps->count = 0;
+}
+
+int EmitParticles(ParticleSystem *ps, const ParticleEmitter *emitter, Vector2 position, unsigned int seed) {
+    unsigned int rng = seed ? seed : 0x9E3779B9u;
+    int emitted = 0;
+
+    // A full pool drops the rest of the burst rather than recycling live particles
+    while (emitted < emitter->count && ps->count < ps->capacity) {
+        int i = ps->count++;
+        float angle = emitter->angle + (NextRandom(&rng) * 2.0f - 1.0f) * emitter->spread;
+        float speed = emitter->speedMin + NextRandom(&rng) * (emitter->speedMax - emitter->speedMin);
+        float life = emitter->lifeMin + NextRandom(&rng) * (emitter->lifeMax - emitter->lifeMin);
+
+        ps->x[i] = position.x;
+        ps->y[i] = position.y;
+        ps->vx[i] = cosf(angle) * speed;
+        ps->vy[i] = sinf(angle) * speed;
+        ps->life[i] = life;
+        ps->lifeTotal[i] = (life > 0.0f) ? life : 1.0f;
+        ps->sizeStart[i] = emitter->sizeStart;
+        ps->sizeEnd[i] = emitter->sizeEnd;
+        ps->gravity[i] = emitter->gravity;
+        ps->drag[i] = emitter->drag;
+        ps->colorStart[i] = emitter->colorStart;
+        ps->colorEnd[i] = emitter->colorEnd;
+        emitted++;
+    }
+    return emitted;
+}
+
+static void MoveParticle(ParticleSystem *ps, int from, int to) {
+    ps->x[to] = ps->x[from];
+    ps->y[to] = ps->y[from];
+    ps->vx[to] = ps->vx[from];
+    ps->vy[to] = ps->vy[from];
+    ps->life[to] = ps->life[from];
+    ps->lifeTotal[to] = ps->lifeTotal[from];
+    ps->sizeStart[to] = ps->sizeStart[from];
+    ps->sizeEnd[to] = ps->sizeEnd[from];
+    ps->gravity[to] = ps->gravity[from];
+    ps->drag[to] = ps->drag[from];
+    ps->colorStart[to] = ps->colorStart[from];
+    ps->colorEnd[to] = ps->colorEnd[from];
+}
+
+void UpdateParticles(ParticleSystem *ps, float dt) {
+    int count = ps->count;
+
+    for (int i = 0; i < count; i++) {
+        float damping = 1.0f - ps->drag[i] * dt;
+        if (damping < 0.0f) damping = 0.0f;
+        ps->vx[i] *= damping;
+        ps->vy[i] = ps->vy[i] * damping + ps->gravity[i] * dt;
+        ps->x[i] += ps->vx[i] * dt;
+        ps->y[i] += ps->vy[i] * dt;
+        ps->life[i] -= dt;
+    }
+
+    // Stable compaction keeps emission order, which is also the draw order
+    int alive = 0;
+    for (int i = 0; i < count; i++) {
+        if (ps->life[i] > 0.0f) {
+            if (i != alive) MoveParticle(ps, i, alive);
+            alive++;
+        }
+    }
+    ps->count = alive;
+}
+
+void DrawParticles(const ParticleSystem *ps, Rectangle view) {
+    if (ps->count == 0) return;
+    float right = view.x + view.width, bottom = view.y + view.height;
+
+    rlSetTexture((ps->texture.id != 0) ? ps->texture.id : rlGetTextureIdDefault());
+    rlBegin(RL_QUADS);
+    for (int i = 0; i < ps->count; i++) {
+        float t = 1.0f - ps->life[i] / ps->lifeTotal[i];
+        float s = ps->sizeStart[i] + (ps->sizeEnd[i] - ps->sizeStart[i]) * t;
+        if (ps->x[i] + s < view.x || ps->x[i] - s > right || ps->y[i] + s < view.y || ps->y[i] - s > bottom) continue;
+        Color a = ps->colorStart[i], b = ps->colorEnd[i];
+
+        rlColor4ub((unsigned char)(a.r + (b.r - a.r) * t), (unsigned char)(a.g + (b.g - a.g) * t),
+                   (unsigned char)(a.b + (b.b - a.b) * t), (unsigned char)(a.a + (b.a - a.a) * t));
+        rlTexCoord2f(0.0f, 0.0f); rlVertex2f(ps->x[i] - s, ps->y[i] - s);
+        rlTexCoord2f(0.0f, 1.0f); rlVertex2f(ps->x[i] - s, ps->y[i] + s);
+        rlTexCoord2f(1.0f, 1.0f); rlVertex2f(ps->x[i] + s, ps->y[i] + s);
+        rlTexCoord2f(1.0f, 0.0f); rlVertex2f(ps->x[i] + s, ps->y[i] - s);
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
@@ -0,0 +1,46 @@
+#ifndef PARTICLES_H
+#define PARTICLES_H
+
+#include "raylib.h"
+
+// Pooled particle system. Particles live in fixed-capacity structure-of-arrays
+// storage, packed at the front so updates are straight loops, and are drawn
+// as textured quads in a single rlgl batch. Effects are described by
+// ParticleEmitter data rather than by code.
+typedef struct {
+    int count;                      // particles per burst
+    float angle;                    // emission direction in radians (0 = right, PI/2 = down)
+    float spread;                   // half-width of the emission cone, PI for all around
+    float speedMin, speedMax;       // pixels per second
+    float lifeMin, lifeMax;         // seconds
+    float sizeStart, sizeEnd;       // radius in pixels, interpolated over the lifetime
+    Color colorStart, colorEnd;
+    float gravity;                  // downward acceleration, pixels per second squared
+    float drag;                     // share of velocity lost per second
+} ParticleEmitter;
+
+typedef struct {
+    int capacity;
+    int count;
+    float *x, *y;
+    float *vx, *vy;
+    float *life, *lifeTotal;
+    float *sizeStart, *sizeEnd;
+    float *gravity, *drag;
+    Color *colorStart, *colorEnd;
+    Texture2D texture;              // sprite for every particle, the default white texture when unset
+} ParticleSystem;
+
+void LoadParticleSystem(ParticleSystem *ps, int capacity, Texture2D texture);
+void UnloadParticleSystem(ParticleSystem *ps);
+void ClearParticles(ParticleSystem *ps);
+
+// Emits one burst at position. The same seed always produces the same burst,
+// so several emitters can share one random layout. Returns particles emitted.
+int EmitParticles(ParticleSystem *ps, const ParticleEmitter *emitter, Vector2 position, unsigned int seed);
+
+void UpdateParticles(ParticleSystem *ps, float dt);
+// Draws the particles whose quads overlap view; the rest cost one test each
+void DrawParticles(const ParticleSystem *ps, Rectangle view);
+
+#endif // PARTICLES_H
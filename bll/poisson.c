@@ -0,0 +1,151 @@
+#include "poisson.h"
+#include <stdlib.h>
+#include <math.h>
+
+#define CANDIDATES_PER_POINT 30
+#define SEED_ATTEMPTS        30
+
+typedef struct {
+    Rectangle area;
+    float minDistance;
+    float cellSize;
+    int gridWidth;
+    int gridHeight;
+    int *grid; // index into points, -1 when empty
+    const Rectangle *exclusions;
+    int exclusionCount;
+    Vector2 *points;
+    unsigned int rng;
+} Sampler;
+
+static float NextRandom(Sampler *s) {
+    // xorshift32, mapped to [0, 1)
+    s->rng ^= s->rng << 13;
+    s->rng ^= s->rng >> 17;
+    s->rng ^= s->rng << 5;
+    return (s->rng >> 8) * (1.0f / 16777216.0f);
+}
+
+static int CellX(const Sampler *s, float x) {
+    int cx = (int)((x - s->area.x) / s->cellSize);
+    return (cx < 0) ? 0 : (cx >= s->gridWidth) ? s->gridWidth - 1 : cx;
+}
+
+static int CellY(const Sampler *s, float y) {
+    int cy = (int)((y - s->area.y) / s->cellSize);
+    return (cy < 0) ? 0 : (cy >= s->gridHeight) ? s->gridHeight - 1 : cy;
+}
+
+static bool Fits(const Sampler *s, Vector2 p) {
+    if (p.x < s->area.x || p.x > s->area.x + s->area.width ||
+        p.y < s->area.y || p.y > s->area.y + s->area.height) return false;
+
+    for (int i = 0; i < s->exclusionCount; i++) {
+        Rectangle r = s->exclusions[i];
+        if (p.x >= r.x && p.x <= r.x + r.width && p.y >= r.y && p.y <= r.y + r.height) return false;
+    }
+
+    // Cell size is minDistance/sqrt(2), so any conflict lies within two cells
+    int cx = CellX(s, p.x);
+    int cy = CellY(s, p.y);
+    float minSq = s->minDistance * s->minDistance;
+    for (int y = cy - 2; y <= cy + 2; y++) {
+        if (y < 0 || y >= s->gridHeight) continue;
+        for (int x = cx - 2; x <= cx + 2; x++) {
+            if (x < 0 || x >= s->gridWidth) continue;
+            int idx = s->grid[y * s->gridWidth + x];
+            if (idx < 0) continue;
+            float dx = s->points[idx].x - p.x;
+            float dy = s->points[idx].y - p.y;
+            if (dx * dx + dy * dy < minSq) return false;
+        }
+    }
+    return true;
+}
+
+static void Insert(Sampler *s, int index, Vector2 p) {
+    s->points[index] = p;
+    s->grid[CellY(s, p.y) * s->gridWidth + CellX(s, p.x)] = index;
+}
+
+int PoissonDiskSample(Rectangle area, float minDistance,
+                      const Rectangle *exclusions, int exclusionCount,
+                      Vector2 *points, int count, unsigned int seed) {
+    if (count <= 0 || area.width < 0.0f || area.height < 0.0f) return 0;
+    if (minDistance < 1.0f) minDistance = 1.0f;
+
+    Sampler s = {0};
+    s.area = area;
+    s.minDistance = minDistance;
+    s.cellSize = minDistance / sqrtf(2.0f);
+    s.gridWidth = (int)ceilf(area.width / s.cellSize) + 1;
+    s.gridHeight = (int)ceilf(area.height / s.cellSize) + 1;
+    s.exclusions = exclusions;
+    s.exclusionCount = exclusionCount;
+    s.rng = seed ? seed : 0x9E3779B9u;
+
+    // No two points share a cell, so the grid size bounds the full fill
+    int capacity = s.gridWidth * s.gridHeight;
+    s.grid = malloc(sizeof(int) * capacity);
+    s.points = malloc(sizeof(Vector2) * capacity);
+    int *active = malloc(sizeof(int) * capacity);
+    if (s.grid == NULL || s.points == NULL || active == NULL) {
+        free(s.grid);
+        free(s.points);
+        free(active);
+        return 0;
+    }
+    for (int i = 0; i < capacity; i++) s.grid[i] = -1;
+
+    // Fill the whole area before choosing any points. Stopping at count would
+    // leave them all in the one cluster grown from the first seed.
+    int placed = 0;
+    int activeCount = 0;
+    while (placed < capacity) {
+        if (activeCount == 0) {
+            // Start a new cluster; exclusion zones can split the area into islands
+            bool seeded = false;
+            for (int attempt = 0; attempt < SEED_ATTEMPTS && !seeded; attempt++) {
+                Vector2 p = { area.x + NextRandom(&s) * area.width, area.y + NextRandom(&s) * area.height };
+                if (Fits(&s, p)) {
+                    Insert(&s, placed, p);
+                    active[activeCount++] = placed++;
+                    seeded = true;
+                }
+            }
+            if (!seeded) break;
+            continue;
+        }
+
+        int slot = (int)(NextRandom(&s) * activeCount);
+        Vector2 origin = s.points[active[slot]];
+        bool found = false;
+        for (int k = 0; k < CANDIDATES_PER_POINT; k++) {
+            float angle = NextRandom(&s) * 2.0f * PI;
+            float dist = minDistance * (1.0f + NextRandom(&s));
+            Vector2 p = { origin.x + cosf(angle) * dist, origin.y + sinf(angle) * dist };
+            if (Fits(&s, p)) {
+                Insert(&s, placed, p);
+                active[activeCount++] = placed++;
+                found = true;
+                break;
+            }
+        }
+        if (!found) active[slot] = active[--activeCount];
+    }
+
+    // Partial Fisher-Yates: a uniform pick of count points from the fill
+    if (count > placed) count = placed;
+    for (int i = 0; i < count; i++) {
+        int j = i + (int)(NextRandom(&s) * (placed - i));
+        Vector2 t = s.points[i];
+        s.points[i] = s.points[j];
+        s.points[j] = t;
+        points[i] = s.points[i];
+    }
+
+    free(active);
+    free(s.points);
+    free(s.grid);
+    return count;
+}
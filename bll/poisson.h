@@ -0,0 +1,17 @@
+#ifndef POISSON_H
+#define POISSON_H
+
+#include "raylib.h"
+
+// Bounded-time Poisson-disk sampling (Bridson's algorithm) over a rectangle.
+// Points keep at least minDistance between each other and never fall inside
+// one of the exclusion rectangles. The whole area is filled first and count
+// points are then drawn from the fill at random, so they spread over all of
+// it. Work is capped at a fixed number of candidate tries per point, and an
+// area too small for count points returns fewer instead of spinning.
+// Returns how many points were written.
+int PoissonDiskSample(Rectangle area, float minDistance,
+                      const Rectangle *exclusions, int exclusionCount,
+                      Vector2 *points, int count, unsigned int seed);
+
+#endif // POISSON_H
@@ -1,16 +1,12 @@
 #include "raylib.h"
 #include <stdlib.h>
 #include <time.h>
+#include "fallingballs.h"
 #define SCREEN_WIDTH 800
 #define SCREEN_HEIGHT 600
 #define MAX_BALLS 10
+#define RAIN_BALLS 5000
 #define BALL_RADIUS 20
-#define BALL_SPEED 4
-typedef struct Ball {
-Vector2 position;
-Color color;
-bool active;
-} Ball;
 int main() {
 InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "Falling Balls with Basket and Background");
 SetTargetFPS(60);
@@ -20,71 +16,34 @@ Texture2D background = LoadTexture("background3.png");
 // Load basket image
 Texture2D basketTex = LoadTexture("bg_fruit_bask.png");
 // Basket properties
-float basketX = SCREEN_WIDTH / 2 - 75;
-float basketY = SCREEN_HEIGHT - 80;
-float basketWidth = 150;
 float basketHeight = 30;
 float basketSideHeight = 50;
-int basketSpeed = 7;
-// Balls setup
-Ball balls[MAX_BALLS];
-for (int i = 0; i < MAX_BALLS; i++) {
-balls[i].position = (Vector2){ GetRandomValue(BALL_RADIUS, SCREEN_WIDTH - BALL_RADIUS), 
-GetRandomValue(-600, 0) };
-balls[i].color = (Color){ GetRandomValue(50,255), GetRandomValue(50,255), GetRandomValue(50,255), 255 };
-balls[i].active = true;
-}
-int score = 0;
+// Balls setup: R toggles the rain stress mode
+bool rainMode = false;
+BallRain rain = {0};
+LoadBallRain(&rain, MAX_BALLS, BALL_RADIUS, SCREEN_WIDTH, SCREEN_HEIGHT);
+ResetBallRain(&rain, 2, (unsigned int)GetRandomValue(1, 0x7fffffff));
 while (!WindowShouldClose()) {
-// Basket movement
-if (IsKeyDown(KEY_LEFT) && basketX > 0) basketX -= basketSpeed;
-if (IsKeyDown(KEY_RIGHT) && basketX + basketWidth < SCREEN_WIDTH) basketX += basketSpeed;
-// Update balls
-int activeBalls = 0;
-for (int i = 0; i < MAX_BALLS; i++) {
-if (balls[i].active) {
-balls[i].position.y += BALL_SPEED;
-// Check collision with basket base
-if (balls[i].position.y + BALL_RADIUS >= basketY &&
-balls[i].position.x >= basketX &&
-balls[i].position.x <= basketX + basketWidth) {
-score++;
-balls[i].active = false;
-}
-// Reset ball if it goes below screen
-if (balls[i].position.y - BALL_RADIUS > SCREEN_HEIGHT) {
-balls[i].position.y = GetRandomValue(-600, 0);
-balls[i].position.x = GetRandomValue(BALL_RADIUS, SCREEN_WIDTH - BALL_RADIUS);
-balls[i].color = (Color){ GetRandomValue(50,255), GetRandomValue(50,255), 
-GetRandomValue(50,255), 255 };
-balls[i].active = true;
-}
-activeBalls++;
-}
-}
-// Ensure at least 2 balls are active
-if (activeBalls < 2) {
-for (int i = 0; i < MAX_BALLS; i++) {
-if (!balls[i].active) {
-balls[i].active = true;
-balls[i].position = (Vector2){ GetRandomValue(BALL_RADIUS, SCREEN_WIDTH - BALL_RADIUS), 
-GetRandomValue(-600, 0) };
-balls[i].color = (Color){ GetRandomValue(50,255), GetRandomValue(50,255), 
-GetRandomValue(50,255), 255 };
-activeBalls++;
-if (activeBalls >= 2) break;
-}
-}
+if (IsKeyPressed(KEY_R)) {
+rainMode = !rainMode;
+LoadBallRain(&rain, rainMode ? RAIN_BALLS : MAX_BALLS, BALL_RADIUS, SCREEN_WIDTH, SCREEN_HEIGHT);
+ResetBallRain(&rain, rainMode ? RAIN_BALLS : 2, (unsigned int)GetRandomValue(1, 0x7fffffff));
 }
+// Basket movement and balls, scaled by the frame time
+int direction = (IsKeyDown(KEY_RIGHT) ? 1 : 0) - (IsKeyDown(KEY_LEFT) ? 1 : 0);
+UpdateBallRain(&rain, GetFrameTime(), direction);
+float basketX = rain.basketX;
+float basketY = rain.basketY;
+float basketWidth = rain.basketWidth;
 // Draw everything
 BeginDrawing();
 ClearBackground(RAYWHITE);
 // Draw background image
 DrawTexture(background, 0, 0, WHITE);
 // Draw balls
-for (int i = 0; i < MAX_BALLS; i++) {
-if (balls[i].active) {
-DrawCircleV(balls[i].position, BALL_RADIUS, balls[i].color);
+for (int i = 0; i < rain.capacity; i++) {
+if (rain.balls[i].active) {
+DrawCircleV(rain.balls[i].position, BALL_RADIUS, rain.balls[i].color);
 }
 }
 // Draw basket using PNG
@@ -122,12 +81,14 @@ if (basketTex.id != 0) {
     DrawTriangle(rightTriangle[0], rightTriangle[1], rightTriangle[2], BROWN);
 }
 // Draw score
-DrawText(TextFormat("Score: %d", score), 10, 10, 20, BLACK);
+DrawText(TextFormat("Score: %d", rain.score), 10, 10, 20, BLACK);
+DrawText(rainMode ? TextFormat("Rain: %d balls, %d catch tests (R to stop)", rain.capacity, rain.catchTests) : "R: rain mode", 10, 40, 20, BLACK);
 EndDrawing();
 }
 // Cleanup
 if (background.id != 0) UnloadTexture(background);
 if (basketTex.id != 0) UnloadTexture(basketTex);
+UnloadBallRain(&rain);
 CloseWindow();
 return 0;
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE 199309L // clock_gettime()
+#endif
+
+#include "profiler.h"
+#include <string.h>
+
+#if defined(_WIN32)
+// Declared by hand, windows.h clashes with raylib names
+__declspec(dllimport) int __stdcall QueryPerformanceCounter(long long *count);
+__declspec(dllimport) int __stdcall QueryPerformanceFrequency(long long *frequency);
+#else
+#include <time.h>
+#endif
+
+double ProfilerTime(void) {
+#if defined(_WIN32)
+    static long long frequency = 0;
+    long long counter;
+    if (frequency == 0) QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter / (double)frequency;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+}
+
+void BeginProfileZone(ProfileZone *zone) {
+    zone->start = ProfilerTime();
+}
+
+void EndProfileZone(ProfileZone *zone) {
+    zone->frameMs += (ProfilerTime() - zone->start) * 1000.0;
+}
+
+void FinishProfileZone(ProfileZone *zone) {
+    zone->smoothedMs += (zone->frameMs - zone->smoothedMs) * 0.05;
+    zone->frameMs = 0.0;
+}
+
+void ResetProfileHistogram(ProfileHistogram *histogram) {
+    const char *name = histogram->name;
+    memset(histogram, 0, sizeof(*histogram));
+    histogram->name = name;
+}
+
+void AddProfileSample(ProfileHistogram *histogram, int value) {
+    if (value < 0) value = 0;
+    histogram->bins[(value < PROFILER_BINS) ? value : PROFILER_BINS - 1]++;
+    histogram->samples++;
+    histogram->sum += value;
+    if (value > histogram->max) histogram->max = value;
+}
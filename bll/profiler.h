@@ -0,0 +1,35 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+// Lightweight in-game profiler: per-frame zone timings and value histograms.
+// Only collects data; the overlay that shows it lives with the game's draw code.
+
+#define PROFILER_BINS 16
+
+typedef struct {
+    const char *name;
+    double start;
+    double frameMs;     // time accumulated in the current frame
+    double smoothedMs;  // moving average over recent frames
+} ProfileZone;
+
+typedef struct {
+    const char *name;
+    int bins[PROFILER_BINS]; // value v lands in bin v, the last bin also takes anything larger
+    int samples;
+    int max;
+    long long sum;
+} ProfileHistogram;
+
+// Monotonic high-resolution clock in seconds
+double ProfilerTime(void);
+
+void BeginProfileZone(ProfileZone *zone);
+void EndProfileZone(ProfileZone *zone);
+// Folds this frame's time into the average and clears it, once per frame
+void FinishProfileZone(ProfileZone *zone);
+
+void ResetProfileHistogram(ProfileHistogram *histogram);
+void AddProfileSample(ProfileHistogram *histogram, int value);
+
+#endif // PROFILER_H
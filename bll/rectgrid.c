@@ -0,0 +1,134 @@
+#include "rectgrid.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static bool RecsOverlap(Rectangle a, Rectangle b) {
+    return a.x < b.x + b.width && a.x + a.width > b.x && a.y < b.y + b.height && a.y + a.height > b.y;
+}
+
+static bool CircleOverlapsRec(Vector2 c, float radius, Rectangle r) {
+    float nx = fmaxf(r.x, fminf(c.x, r.x + r.width));
+    float ny = fmaxf(r.y, fminf(c.y, r.y + r.height));
+    float dx = c.x - nx, dy = c.y - ny;
+    return dx*dx + dy*dy <= radius*radius;
+}
+
+static void CellRange(const RectGrid *grid, Rectangle r, int *x0, int *y0, int *x1, int *y1) {
+    *x0 = (int)floorf((r.x - grid->bounds.x) / grid->cellSize);
+    *y0 = (int)floorf((r.y - grid->bounds.y) / grid->cellSize);
+    *x1 = (int)floorf((r.x + r.width - grid->bounds.x) / grid->cellSize);
+    *y1 = (int)floorf((r.y + r.height - grid->bounds.y) / grid->cellSize);
+    if (*x0 < 0) *x0 = 0;
+    if (*y0 < 0) *y0 = 0;
+    if (*x1 >= grid->cols) *x1 = grid->cols - 1;
+    if (*y1 >= grid->rows) *y1 = grid->rows - 1;
+}
+
+void BuildRectGrid(RectGrid *grid, const Rectangle *rects, int count, float cellSize) {
+    UnloadRectGrid(grid);
+    if (count <= 0) return;
+    if (cellSize < 1.0f) cellSize = 1.0f;
+
+    float minX = rects[0].x, minY = rects[0].y;
+    float maxX = rects[0].x + rects[0].width, maxY = rects[0].y + rects[0].height;
+    for (int i = 1; i < count; i++) {
+        if (rects[i].x < minX) minX = rects[i].x;
+        if (rects[i].y < minY) minY = rects[i].y;
+        if (rects[i].x + rects[i].width > maxX) maxX = rects[i].x + rects[i].width;
+        if (rects[i].y + rects[i].height > maxY) maxY = rects[i].y + rects[i].height;
+    }
+
+    grid->bounds = (Rectangle){ minX, minY, maxX - minX, maxY - minY };
+    grid->cellSize = cellSize;
+    grid->cols = (int)(grid->bounds.width / cellSize) + 1;
+    grid->rows = (int)(grid->bounds.height / cellSize) + 1;
+    grid->count = count;
+
+    int cellCount = grid->cols * grid->rows;
+    grid->cellStart = calloc(cellCount + 1, sizeof(int));
+    grid->rects = malloc(sizeof(Rectangle) * count);
+    grid->stamps = calloc(count, sizeof(unsigned int));
+    if (grid->cellStart == NULL || grid->rects == NULL || grid->stamps == NULL) {
+        UnloadRectGrid(grid);
+        return;
+    }
+    memcpy(grid->rects, rects, sizeof(Rectangle) * count);
+
+    // Counting sort: tally rects per cell, prefix-sum into offsets, then scatter
+    int x0, y0, x1, y1;
+    int total = 0;
+    for (int i = 0; i < count; i++) {
+        CellRange(grid, rects[i], &x0, &y0, &x1, &y1);
+        for (int y = y0; y <= y1; y++)
+            for (int x = x0; x <= x1; x++) grid->cellStart[y * grid->cols + x + 1]++;
+        total += (x1 - x0 + 1) * (y1 - y0 + 1);
+    }
+    for (int c = 0; c < cellCount; c++) grid->cellStart[c + 1] += grid->cellStart[c];
+
+    grid->cellItems = malloc(sizeof(int) * total);
+    int *fill = malloc(sizeof(int) * cellCount);
+    if (grid->cellItems == NULL || fill == NULL) {
+        free(fill);
+        UnloadRectGrid(grid);
+        return;
+    }
+    memcpy(fill, grid->cellStart, sizeof(int) * cellCount);
+    for (int i = 0; i < count; i++) {
+        CellRange(grid, rects[i], &x0, &y0, &x1, &y1);
+        for (int y = y0; y <= y1; y++)
+            for (int x = x0; x <= x1; x++) grid->cellItems[fill[y * grid->cols + x]++] = i;
+    }
+    free(fill);
+}
+
+void UnloadRectGrid(RectGrid *grid) {
+    free(grid->cellStart);
+    free(grid->cellItems);
+    free(grid->rects);
+    free(grid->stamps);
+    memset(grid, 0, sizeof(*grid));
+}
+
+static int Query(RectGrid *grid, Rectangle area, bool circle, Vector2 center, float radius,
+                 int *results, int maxResults) {
+    if (grid->count == 0) return 0;
+    if (area.x > grid->bounds.x + grid->bounds.width || area.x + area.width < grid->bounds.x ||
+        area.y > grid->bounds.y + grid->bounds.height || area.y + area.height < grid->bounds.y) return 0;
+
+    if (++grid->stamp == 0) {
+        memset(grid->stamps, 0, sizeof(unsigned int) * grid->count);
+        grid->stamp = 1;
+    }
+
+    int x0, y0, x1, y1;
+    int found = 0;
+    CellRange(grid, area, &x0, &y0, &x1, &y1);
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            int cell = y * grid->cols + x;
+            for (int k = grid->cellStart[cell]; k < grid->cellStart[cell + 1]; k++) {
+                int i = grid->cellItems[k];
+                if (grid->stamps[i] == grid->stamp) continue;
+                grid->stamps[i] = grid->stamp;
+
+                Rectangle r = grid->rects[i];
+                bool hit = circle ? CircleOverlapsRec(center, radius, r) : RecsOverlap(area, r);
+                if (hit) {
+                    results[found++] = i;
+                    if (found == maxResults) return found;
+                }
+            }
+        }
+    }
+    return found;
+}
+
+int QueryRectGridRec(RectGrid *grid, Rectangle area, int *results, int maxResults) {
+    return Query(grid, area, false, (Vector2){0}, 0.0f, results, maxResults);
+}
+
+int QueryRectGridCircle(RectGrid *grid, Vector2 center, float radius, int *results, int maxResults) {
+    Rectangle area = { center.x - radius, center.y - radius, 2*radius, 2*radius };
+    return Query(grid, area, true, center, radius, results, maxResults);
+}
@@ -0,0 +1,30 @@
+#ifndef RECTGRID_H
+#define RECTGRID_H
+
+#include "raylib.h"
+
+// Static uniform-grid index over a set of rectangles. Built once when the
+// rectangles change; queries only visit the cells the query shape touches,
+// so their cost depends on local density rather than on the total count.
+typedef struct {
+    Rectangle bounds;       // area covered by the cells
+    float cellSize;
+    int cols;
+    int rows;
+    int *cellStart;         // cols*rows + 1 offsets into cellItems
+    int *cellItems;         // rect indices grouped by cell
+    Rectangle *rects;       // copy of the indexed rectangles
+    int count;
+    unsigned int *stamps;   // per-rect query marks, so rects spanning cells report once
+    unsigned int stamp;
+} RectGrid;
+
+void BuildRectGrid(RectGrid *grid, const Rectangle *rects, int count, float cellSize);
+void UnloadRectGrid(RectGrid *grid);
+
+// Write the indices of rects overlapping the query into results and return
+// how many were found (at most maxResults)
+int QueryRectGridRec(RectGrid *grid, Rectangle area, int *results, int maxResults);
+int QueryRectGridCircle(RectGrid *grid, Vector2 center, float radius, int *results, int maxResults);
+
+#endif // RECTGRID_H
@@ -0,0 +1,204 @@
+#include "rigidbody.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define PENETRATION_SLOP    0.5f
+#define POSITION_CORRECTION 0.8f
+
+void LoadRigidWorld(RigidWorld *world, int capacity, Rectangle bounds) {
+    UnloadRigidWorld(world);
+    if (capacity < 1) capacity = 1;
+
+    world->bodies = calloc(capacity, sizeof(RigidCircle));
+    world->order = malloc(sizeof(int) * capacity);
+    if (!world->bodies || !world->order) {
+        UnloadRigidWorld(world);
+        return;
+    }
+    world->capacity = capacity;
+    world->bounds = bounds;
+    world->restitution = 0.6f;
+    world->wallRestitution = 0.5f;
+}
+
+void UnloadRigidWorld(RigidWorld *world) {
+    free(world->bodies);
+    free(world->order);
+    memset(world, 0, sizeof(*world));
+}
+
+void ClearRigidWorld(RigidWorld *world) {
+    world->count = 0;
+    world->accumulator = 0.0f;
+    world->time = 0.0f;
+    world->substeps = world->pairTests = world->contacts = world->awake = 0;
+}
+
+int AddRigidCircle(RigidWorld *world, Vector2 position, float radius, float mass, float drag) {
+    if (world->count >= world->capacity) return -1;
+
+    int index = world->count++;
+    world->bodies[index] = (RigidCircle){
+        .position = position,
+        .radius = radius,
+        .invMass = (mass > 0.0f) ? 1.0f / mass : 0.0f,
+        .drag = drag,
+        .active = true,
+        .asleep = true
+    };
+    world->order[index] = index;
+    return index;
+}
+
+void WakeRigidCircle(RigidWorld *world, int index) {
+    if (index < 0 || index >= world->count) return;
+    world->bodies[index].asleep = false;
+    world->bodies[index].restTime = 0.0f;
+}
+
+void SetRigidVelocity(RigidWorld *world, int index, Vector2 velocity) {
+    if (index < 0 || index >= world->count) return;
+    world->bodies[index].velocity = velocity;
+    WakeRigidCircle(world, index);
+}
+
+// Bodies barely move within a substep, so the previous order is almost
+// sorted and insertion sort is close to linear
+static void SortByLeftEdge(RigidWorld *world) {
+    for (int i = 1; i < world->count; i++) {
+        int id = world->order[i];
+        float key = world->bodies[id].position.x - world->bodies[id].radius;
+        int j = i - 1;
+        while (j >= 0) {
+            const RigidCircle *other = &world->bodies[world->order[j]];
+            if (other->position.x - other->radius <= key) break;
+            world->order[j + 1] = world->order[j];
+            j--;
+        }
+        world->order[j + 1] = id;
+    }
+}
+
+static void ResolveContact(RigidWorld *world, RigidCircle *a, RigidCircle *b) {
+    float totalInvMass = a->invMass + b->invMass;
+    if (totalInvMass <= 0.0f) return;
+
+    float dx = b->position.x - a->position.x;
+    float dy = b->position.y - a->position.y;
+    float reach = a->radius + b->radius;
+    float distSq = dx*dx + dy*dy;
+    if (distSq >= reach*reach) return;
+
+    world->contacts++;
+    float dist = sqrtf(distSq);
+    Vector2 normal = (dist > 0.0001f) ? (Vector2){ dx / dist, dy / dist } : (Vector2){ 0.0f, -1.0f };
+
+    // A sleeping body only wakes when the other side is moving
+    if (a->asleep && !b->asleep) { a->asleep = false; a->restTime = 0.0f; }
+    if (b->asleep && !a->asleep) { b->asleep = false; b->restTime = 0.0f; }
+
+    float approach = (b->velocity.x - a->velocity.x) * normal.x + (b->velocity.y - a->velocity.y) * normal.y;
+    if (approach < 0.0f) {
+        float impulse = -(1.0f + world->restitution) * approach / totalInvMass;
+        a->velocity.x -= impulse * a->invMass * normal.x;
+        a->velocity.y -= impulse * a->invMass * normal.y;
+        b->velocity.x += impulse * b->invMass * normal.x;
+        b->velocity.y += impulse * b->invMass * normal.y;
+    }
+
+    float depth = reach - dist - PENETRATION_SLOP;
+    if (depth > 0.0f) {
+        float push = depth * POSITION_CORRECTION / totalInvMass;
+        a->position.x -= push * a->invMass * normal.x;
+        a->position.y -= push * a->invMass * normal.y;
+        b->position.x += push * b->invMass * normal.x;
+        b->position.y += push * b->invMass * normal.y;
+    }
+}
+
+static void Integrate(RigidWorld *world, float h) {
+    const Rectangle *bounds = &world->bounds;
+    for (int i = 0; i < world->count; i++) {
+        RigidCircle *body = &world->bodies[i];
+        if (!body->active || body->asleep) continue;
+
+        if (body->invMass > 0.0f) {
+            float keep = 1.0f / (1.0f + body->drag * h);
+            body->velocity.x *= keep;
+            body->velocity.y *= keep;
+        }
+        body->position.x += body->velocity.x * h;
+        body->position.y += body->velocity.y * h;
+
+        if (body->invMass > 0.0f) {
+            if (body->position.x - body->radius < bounds->x && body->velocity.x < 0.0f) {
+                body->position.x = bounds->x + body->radius;
+                body->velocity.x *= -world->wallRestitution;
+            } else if (body->position.x + body->radius > bounds->x + bounds->width && body->velocity.x > 0.0f) {
+                body->position.x = bounds->x + bounds->width - body->radius;
+                body->velocity.x *= -world->wallRestitution;
+            }
+        }
+        if (body->position.y + body->radius < bounds->y || body->position.y - body->radius > bounds->y + bounds->height) {
+            body->active = false;
+            continue;
+        }
+
+        float speedSq = body->velocity.x*body->velocity.x + body->velocity.y*body->velocity.y;
+        if (body->invMass == 0.0f) {
+            body->asleep = (speedSq == 0.0f);
+        } else if (speedSq < RIGID_SLEEP_SPEED * RIGID_SLEEP_SPEED) {
+            body->restTime += h;
+            if (body->restTime >= RIGID_SLEEP_TIME) {
+                body->asleep = true;
+                body->velocity = (Vector2){ 0.0f, 0.0f };
+            }
+        } else {
+            body->restTime = 0.0f;
+        }
+    }
+}
+
+static void Substep(RigidWorld *world, float h) {
+    Integrate(world, h);
+    SortByLeftEdge(world);
+
+    for (int i = 0; i < world->count; i++) {
+        RigidCircle *a = &world->bodies[world->order[i]];
+        if (!a->active) continue;
+        float right = a->position.x + a->radius;
+        for (int j = i + 1; j < world->count; j++) {
+            RigidCircle *b = &world->bodies[world->order[j]];
+            if (b->position.x - b->radius > right) break;
+            if (!b->active || (a->asleep && b->asleep)) continue;
+            world->pairTests++;
+            ResolveContact(world, a, b);
+        }
+    }
+}
+
+int StepRigidWorld(RigidWorld *world, float dt) {
+    world->substeps = world->pairTests = world->contacts = 0;
+
+    world->awake = 0;
+    for (int i = 0; i < world->count; i++) {
+        if (world->bodies[i].active && !world->bodies[i].asleep) world->awake++;
+    }
+    // Nothing moving: nothing to do, and no backlog to catch up on later
+    if (world->awake == 0) {
+        world->accumulator = 0.0f;
+        return 0;
+    }
+
+    world->accumulator += dt;
+    while (world->accumulator >= RIGID_SUBSTEP && world->substeps < RIGID_MAX_SUBSTEPS) {
+        if (world->drive != NULL) world->drive(world, world->time, RIGID_SUBSTEP, world->driveData);
+        Substep(world, RIGID_SUBSTEP);
+        world->time += RIGID_SUBSTEP;
+        world->accumulator -= RIGID_SUBSTEP;
+        world->substeps++;
+    }
+    if (world->substeps == RIGID_MAX_SUBSTEPS) world->accumulator = 0.0f;
+    return world->substeps;
+}
@@ -0,0 +1,65 @@
+#ifndef RIGIDBODY_H
+#define RIGIDBODY_H
+
+#include "raylib.h"
+
+// Small 2D rigid-body solver for circles (the bowling ball and pins). The
+// world advances in fixed substeps, finds candidate pairs with a
+// sweep-and-prune over x that stays nearly sorted between steps, and resolves
+// contacts with impulses. Bodies that stay slow fall asleep and are skipped
+// until something awake touches them, so a resting rack costs nothing.
+#define RIGID_SUBSTEP       (1.0f / 240.0f)
+#define RIGID_MAX_SUBSTEPS  8      // caps the frame cost after a hitch
+#define RIGID_SLEEP_SPEED   6.0f   // pixels per second
+#define RIGID_SLEEP_TIME    0.25f  // seconds below the sleep speed before sleeping
+
+typedef struct {
+    Vector2 position;
+    Vector2 velocity;
+    float radius;
+    float invMass;      // 0 for kinematic bodies, which are moved by their velocity only
+    float drag;         // share of velocity lost per second
+    float restTime;     // seconds spent below the sleep speed
+    bool active;
+    bool asleep;
+} RigidCircle;
+
+typedef struct RigidWorld RigidWorld;
+
+// Called before every substep with the world clock and the substep length,
+// so kinematic bodies can be driven at substep resolution
+typedef void (*RigidDriveFunc)(RigidWorld *world, float time, float h, void *data);
+
+struct RigidWorld {
+    RigidCircle *bodies;
+    int count;
+    int capacity;
+    int *order;         // body indices sorted by left edge for the sweep
+    Rectangle bounds;   // side walls bounce; bodies that leave over the top or bottom are removed
+    float restitution;
+    float wallRestitution;
+    float accumulator;
+    float time;         // seconds simulated, advanced one substep at a time
+    RigidDriveFunc drive;
+    void *driveData;
+    // Stats from the last frame
+    int substeps;
+    int pairTests;
+    int contacts;
+    int awake;
+};
+
+void LoadRigidWorld(RigidWorld *world, int capacity, Rectangle bounds);
+void UnloadRigidWorld(RigidWorld *world);
+void ClearRigidWorld(RigidWorld *world);
+
+// mass 0 makes a kinematic body. New bodies start asleep. Returns the index or -1 when full.
+int AddRigidCircle(RigidWorld *world, Vector2 position, float radius, float mass, float drag);
+void WakeRigidCircle(RigidWorld *world, int index);
+// Sets the velocity and wakes the body; this is how kinematic bodies are driven
+void SetRigidVelocity(RigidWorld *world, int index, Vector2 velocity);
+
+// Runs as many fixed substeps as dt covers and returns how many ran
+int StepRigidWorld(RigidWorld *world, float dt);
+
+#endif // RIGIDBODY_H
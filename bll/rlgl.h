@@ -40,6 +40,10 @@
 *           Enable framebuffer objects (fbo) support (enabled by default)
 *           Some GPUs could not support them despite the OpenGL version
 *
+*       #define RLGL_BATCH_STATS
+*           Report every non-empty render batch flush, with its cause, draw calls and vertices,
+*           to a callback set with rlSetFlushCallback()
+*
 *       #define RLGL_SHOW_GL_DETAILS_INFO
 *           Show OpenGL extensions and capabilities detailed logs on init
 *
@@ -422,6 +426,22 @@ typedef struct rlRenderBatch {
     float currentDepth;         // Current depth value for next draw
 } rlRenderBatch;
 
+#if defined(RLGL_BATCH_STATS)
+// Render batch flush causes, reported by rlDrawRenderBatch()
+typedef enum {
+    RL_FLUSH_EXPLICIT = 0,              // rlDrawRenderBatchActive(): end of frame, render texture switch
+    RL_FLUSH_SHADER,                    // rlSetShader() with a different shader
+    RL_FLUSH_BLEND_MODE,                // rlSetBlendMode() with a different mode
+    RL_FLUSH_DRAW_LIMIT,                // RL_DEFAULT_BATCH_DRAWCALLS draw calls reached (texture/mode changes)
+    RL_FLUSH_VERTEX_LIMIT,              // Vertex buffer full
+    RL_FLUSH_BATCH_SWITCH,              // rlSetRenderBatchActive()
+    RL_FLUSH_CAUSE_COUNT
+} rlFlushCause;
+
+// Flush callback: cause (rlFlushCause), draw calls issued and vertices uploaded
+typedef void (*rlFlushCallback)(int cause, int drawCalls, int vertexCount);
+#endif
+
 // OpenGL version
 typedef enum {
     RL_OPENGL_11 = 1,           // OpenGL 1.1
@@ -725,6 +745,9 @@ RLAPI void rlDrawRenderBatch(rlRenderBatch *batch);     // Draw render batch dat
 RLAPI void rlSetRenderBatchActive(rlRenderBatch *batch); // Set the active render batch for rlgl (NULL for default internal)
 RLAPI void rlDrawRenderBatchActive(void);               // Update and draw internal render batch
 RLAPI bool rlCheckRenderBatchLimit(int vCount);         // Check internal buffer overflow for a given number of vertex
+#if defined(RLGL_BATCH_STATS)
+RLAPI void rlSetFlushCallback(rlFlushCallback callback); // Set callback for every non-empty batch flush (NULL to stop)
+#endif
 
 RLAPI void rlSetTexture(unsigned int id);               // Set current texture for render batch and check buffers limits
 
@@ -1121,6 +1144,14 @@ static double rlCullDistanceFar = RL_CULL_DISTANCE_FAR;
 static rlglData RLGL = { 0 };
 #endif  // GRAPHICS_API_OPENGL_33 || GRAPHICS_API_OPENGL_ES2
 
+#if defined(RLGL_BATCH_STATS)
+static rlFlushCallback rlFlushReport = NULL;
+static int rlFlushReason = RL_FLUSH_EXPLICIT;   // Cause of the next rlDrawRenderBatch(), back to explicit after it
+#define RL_FLUSH_BECAUSE(cause) rlFlushReason = (cause)
+#else
+#define RL_FLUSH_BECAUSE(cause)
+#endif
+
 #if defined(GRAPHICS_API_OPENGL_ES2) && !defined(GRAPHICS_API_OPENGL_ES3)
 // NOTE: VAO functionality is exposed through extensions (OES)
 static PFNGLGENVERTEXARRAYSOESPROC glGenVertexArrays = NULL;
@@ -1470,7 +1501,11 @@ void rlBegin(int mode)
             }
         }
 
-        if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS) rlDrawRenderBatch(RLGL.currentBatch);
+        if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS)
+        {
+            RL_FLUSH_BECAUSE(RL_FLUSH_DRAW_LIMIT);
+            rlDrawRenderBatch(RLGL.currentBatch);
+        }
 
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].mode = mode;
         RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
@@ -1637,6 +1672,7 @@ void rlSetTexture(unsigned int id)
         if (RLGL.State.vertexCounter >=
             RLGL.currentBatch->vertexBuffer[RLGL.currentBatch->currentBuffer].elementCount*4)
         {
+            RL_FLUSH_BECAUSE(RL_FLUSH_VERTEX_LIMIT);
             rlDrawRenderBatch(RLGL.currentBatch);
         }
 #endif
@@ -1667,7 +1703,11 @@ void rlSetTexture(unsigned int id)
                 }
             }
 
-            if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS) rlDrawRenderBatch(RLGL.currentBatch);
+            if (RLGL.currentBatch->drawCounter >= RL_DEFAULT_BATCH_DRAWCALLS)
+            {
+                RL_FLUSH_BECAUSE(RL_FLUSH_DRAW_LIMIT);
+                rlDrawRenderBatch(RLGL.currentBatch);
+            }
 
             RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId = id;
             RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].vertexCount = 0;
@@ -2097,6 +2137,7 @@ void rlSetBlendMode(int mode)
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     if ((RLGL.State.currentBlendMode != mode) || ((mode == RL_BLEND_CUSTOM || mode == RL_BLEND_CUSTOM_SEPARATE) && RLGL.State.glCustomBlendModeModified))
     {
+        RL_FLUSH_BECAUSE(RL_FLUSH_BLEND_MODE);
         rlDrawRenderBatch(RLGL.currentBatch);
 
         switch (mode)
@@ -2904,6 +2945,11 @@ void rlUnloadRenderBatch(rlRenderBatch batch)
 void rlDrawRenderBatch(rlRenderBatch *batch)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+#if defined(RLGL_BATCH_STATS)
+    if ((rlFlushReport != NULL) && (RLGL.State.vertexCounter > 0)) rlFlushReport(rlFlushReason, batch->drawCounter, RLGL.State.vertexCounter);
+    rlFlushReason = RL_FLUSH_EXPLICIT;
+#endif
+
     // Update batch vertex buffers
     //------------------------------------------------------------------------------------------------------------
     // NOTE: If there is not vertex data, buffers doesn't need to be updated (vertexCount > 0)
@@ -3129,6 +3175,7 @@ void rlDrawRenderBatch(rlRenderBatch *batch)
 void rlSetRenderBatchActive(rlRenderBatch *batch)
 {
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
+    RL_FLUSH_BECAUSE(RL_FLUSH_BATCH_SWITCH);
     rlDrawRenderBatch(RLGL.currentBatch);
 
     if (batch != NULL) RLGL.currentBatch = batch;
@@ -3160,6 +3207,7 @@ bool rlCheckRenderBatchLimit(int vCount)
         int currentMode = RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].mode;
         int currentTexture = RLGL.currentBatch->draws[RLGL.currentBatch->drawCounter - 1].textureId;
 
+        RL_FLUSH_BECAUSE(RL_FLUSH_VERTEX_LIMIT);
         rlDrawRenderBatch(RLGL.currentBatch);    // NOTE: Stereo rendering is checked inside
 
         // Restore state of last batch so we can continue adding vertices
@@ -3171,6 +3219,14 @@ bool rlCheckRenderBatchLimit(int vCount)
     return overflow;
 }
 
+#if defined(RLGL_BATCH_STATS)
+// Set callback for every non-empty batch flush
+void rlSetFlushCallback(rlFlushCallback callback)
+{
+    rlFlushReport = callback;
+}
+#endif
+
 // Textures data management
 //-----------------------------------------------------------------------------------------
 // Convert image data to OpenGL texture (returns OpenGL valid Id)
@@ -4402,6 +4458,7 @@ void rlSetShader(unsigned int id, int *locs)
 #if defined(GRAPHICS_API_OPENGL_33) || defined(GRAPHICS_API_OPENGL_ES2)
     if (RLGL.State.currentShaderId != id)
     {
+        RL_FLUSH_BECAUSE(RL_FLUSH_SHADER);
         rlDrawRenderBatch(RLGL.currentBatch);
         RLGL.State.currentShaderId = id;
         RLGL.State.currentShaderLocs = locs;
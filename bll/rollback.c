@@ -0,0 +1,162 @@
+#include "rollback.h"
+#include "profiler.h"
+#include <string.h>
+
+#define HISTORY_MASK (ROLLBACK_HISTORY - 1)
+#define WINDOW_MASK (ROLLBACK_WINDOW - 1)
+
+bool LoadRollbackSession(RollbackSession *session, int localPlayer, size_t snapshotSize) {
+    UnloadRollbackSession(session);
+    session->localPlayer = localPlayer;
+    session->rollbackFrom = -1;
+    session->pendingChecksumFrame = -1;
+    session->checkedFrame = -1;
+    session->desyncFrame = -1;
+    for (int i = 0; i < ROLLBACK_WINDOW; i++) {
+        if (!LoadSnapshotStream(&session->snapshots[i], snapshotSize)) {
+            UnloadRollbackSession(session);
+            return false;
+        }
+    }
+    return true;
+}
+
+void UnloadRollbackSession(RollbackSession *session) {
+    for (int i = 0; i < ROLLBACK_WINDOW; i++) UnloadSnapshotStream(&session->snapshots[i]);
+    memset(session, 0, sizeof(*session));
+}
+
+static int RemotePlayer(const RollbackSession *session) {
+    return 1 - session->localPlayer;
+}
+
+void AddRemoteInput(RollbackSession *session, int frame, RollbackInput input) {
+    if (frame != session->remoteFrame) return;
+    // The peer never gets a window past our input, so this only trips on garbage
+    if (frame - session->frame >= ROLLBACK_HISTORY - 2 * ROLLBACK_WINDOW) return;
+
+    RollbackInput *slot = &session->inputs[frame & HISTORY_MASK][RemotePlayer(session)];
+    if (frame < session->frame && *slot != input) {
+        if (session->rollbackFrom < 0 || frame < session->rollbackFrom) session->rollbackFrom = frame;
+    }
+    *slot = input;
+    session->remoteFrame++;
+}
+
+void AckLocalInput(RollbackSession *session, int frames) {
+    if (frames > session->frame) frames = session->frame;
+    if (frames > session->peerFrame) session->peerFrame = frames;
+}
+
+int UnackedLocalFrame(const RollbackSession *session) {
+    // The peer ran the frames we have of theirs, so it cannot be missing our
+    // input from more than a window before them, whatever its acks said
+    int first = session->remoteFrame - ROLLBACK_WINDOW;
+    return (session->peerFrame > first) ? session->peerFrame : (first > 0) ? first : 0;
+}
+
+RollbackInput LocalInputAt(const RollbackSession *session, int frame) {
+    return session->inputs[frame & HISTORY_MASK][session->localPlayer];
+}
+
+int RollbackAdvantage(const RollbackSession *session) {
+    return session->frame - session->remoteFrame;
+}
+
+int ConfirmedRollbackFrame(const RollbackSession *session) {
+    // A frame's snapshot is final once every input before it is confirmed,
+    // it has been taken, and no rollback before it is still to be run
+    int last = session->frame - 1;
+    if (session->remoteFrame < last) last = session->remoteFrame;
+    if (session->rollbackFrom >= 0 && session->rollbackFrom < last) last = session->rollbackFrom;
+    return last;
+}
+
+unsigned long long GetRollbackChecksum(const RollbackSession *session, int frame) {
+    return session->checksums[frame & HISTORY_MASK];
+}
+
+// Compares the peer's latest checksum as soon as ours for that frame is final
+static void CheckDesync(RollbackSession *session) {
+    int frame = session->pendingChecksumFrame;
+    if (frame < 0 || frame > ConfirmedRollbackFrame(session)) return;
+    if (frame >= session->frame - ROLLBACK_HISTORY) {
+        session->checkedFrame = frame;
+        if (session->checksums[frame & HISTORY_MASK] != session->pendingChecksum && session->desyncFrame < 0) {
+            session->desyncFrame = frame;
+        }
+    }
+    session->pendingChecksumFrame = -1;
+}
+
+void AddRemoteChecksum(RollbackSession *session, int frame, unsigned long long checksum) {
+    if (frame <= session->checkedFrame || frame <= session->pendingChecksumFrame) return;
+    session->pendingChecksumFrame = frame;
+    session->pendingChecksum = checksum;
+    CheckDesync(session);
+}
+
+bool RollbackShouldWait(RollbackSession *session) {
+    if (session->frame - session->remoteFrame >= ROLLBACK_WINDOW) {
+        session->waits++;
+        return true;
+    }
+    // Both advantages include the same latency, so half their difference
+    // is how many frames this side runs ahead of the peer's clock
+    int ahead = (RollbackAdvantage(session) - session->peerAdvantage) / 2;
+    if (ahead >= 1 && !session->waited) {
+        session->waited = true;
+        session->waits++;
+        return true;
+    }
+    session->waited = false;
+    return false;
+}
+
+// Predicted frames get the remote player's last known buttons, less presses
+static void RunFrame(RollbackSession *session, int frame, bool resimulating, bool save) {
+    RollbackInput *inputs = session->inputs[frame & HISTORY_MASK];
+    if (frame >= session->remoteFrame) {
+        RollbackInput last = (session->remoteFrame > 0)
+            ? session->inputs[(session->remoteFrame - 1) & HISTORY_MASK][RemotePlayer(session)] : 0;
+        inputs[RemotePlayer(session)] = last & session->heldButtons;
+    }
+    if (save) {
+        SnapshotStream *snapshot = &session->snapshots[frame & WINDOW_MASK];
+        session->save(snapshot, session->user);
+        session->checksums[frame & HISTORY_MASK] = GetSnapshotChecksum(snapshot);
+    }
+    session->step(inputs, resimulating, session->user);
+}
+
+bool AdvanceRollback(RollbackSession *session, RollbackInput localInput) {
+    if (session->frame - session->remoteFrame >= ROLLBACK_WINDOW) return false;
+
+    session->depth = 0;
+    session->resimSeconds = 0.0;
+    if (session->rollbackFrom >= 0) {
+        int from = session->rollbackFrom;
+        session->rollbackFrom = -1;
+        double start = ProfilerTime();
+        if (session->load(&session->snapshots[from & WINDOW_MASK], session->user)) {
+            // The restored frame's snapshot is already right; the later ones are redone
+            for (int frame = from; frame < session->frame; frame++) RunFrame(session, frame, true, frame != from);
+        } else if (session->desyncFrame < 0) {
+            session->desyncFrame = from;
+        }
+        session->depth = session->frame - from;
+        session->resimSeconds = ProfilerTime() - start;
+
+        session->rollbacks++;
+        session->resimulatedFrames += session->depth;
+        session->totalResimSeconds += session->resimSeconds;
+        if (session->depth > session->maxDepth) session->maxDepth = session->depth;
+        if (session->resimSeconds > session->maxResimSeconds) session->maxResimSeconds = session->resimSeconds;
+    }
+
+    session->inputs[session->frame & HISTORY_MASK][session->localPlayer] = localInput;
+    RunFrame(session, session->frame, false, true);
+    session->frame++;
+    CheckDesync(session);
+    return true;
+}
@@ -0,0 +1,96 @@
+#ifndef ROLLBACK_H
+#define ROLLBACK_H
+
+#include "snapshot.h"
+#include <stdbool.h>
+
+// Rollback for a deterministic two-player simulation. Each frame runs as
+// soon as the local input is known; the remote player's input for frames
+// not heard about yet is predicted by holding over their last known
+// buttons. When the real remote input for a frame arrives and differs from
+// the prediction, the sim is restored from the snapshot taken at the start
+// of that frame and run forward again to the present. A snapshot is kept
+// for every frame in the window. Once every input before a frame is
+// confirmed its snapshot can no longer change, and the peers compare those
+// snapshots' checksums to catch a desync. Moving inputs and checksums
+// between the peers is left to the caller.
+#define ROLLBACK_PLAYERS 2
+#define ROLLBACK_WINDOW 32      // frames the sim may run past the last confirmed remote input, power of two
+#define ROLLBACK_HISTORY 128    // frames of inputs and checksums kept, power of two, at least four windows
+
+typedef unsigned char RollbackInput;    // eight buttons of one player for one frame
+
+// save and load are the sim's snapshot serializer. step runs one frame on
+// both players' inputs; resimulating is set while frames that were already
+// shown once are run again after a rollback.
+typedef void (*RollbackSaveFunc)(SnapshotStream *stream, void *user);
+typedef bool (*RollbackLoadFunc)(SnapshotStream *stream, void *user);
+typedef void (*RollbackStepFunc)(const RollbackInput *inputs, bool resimulating, void *user);
+
+typedef struct {
+    RollbackSaveFunc save;
+    RollbackLoadFunc load;
+    RollbackStepFunc step;
+    void *user;
+    int localPlayer;
+    RollbackInput heldButtons;  // remote buttons a prediction carries over; the others are presses
+
+    int frame;                  // next frame to run
+    int remoteFrame;            // frames of remote input received, all of them before this one
+    int peerFrame;              // frames of our input the peer reports having
+    int peerAdvantage;          // how far the peer reports running past our input
+    int rollbackFrom;           // earliest mispredicted frame still to be run again, -1 for none
+    bool waited;                // the last RollbackShouldWait held a frame back for time sync
+    RollbackInput inputs[ROLLBACK_HISTORY][ROLLBACK_PLAYERS];   // as run: confirmed or predicted
+    unsigned long long checksums[ROLLBACK_HISTORY];             // of each frame's starting snapshot
+    SnapshotStream snapshots[ROLLBACK_WINDOW];                  // state at the start of each frame
+
+    // Desync check
+    int pendingChecksumFrame;   // the peer's latest checksum, until ours for that frame is final
+    unsigned long long pendingChecksum;
+    int checkedFrame;           // latest frame compared, -1 for none
+    int desyncFrame;            // first frame whose checksum differed from the peer's, -1 while in sync
+
+    // The last AdvanceRollback
+    int depth;                  // frames run again before the new one, 0 without a rollback
+    double resimSeconds;        // restoring and running them
+    // Totals
+    long long rollbacks;
+    long long resimulatedFrames;
+    int maxDepth;
+    double totalResimSeconds;
+    double maxResimSeconds;
+    int waits;
+} RollbackSession;
+
+// snapshotSize reserves each frame's snapshot up front, so play allocates nothing
+bool LoadRollbackSession(RollbackSession *session, int localPlayer, size_t snapshotSize);
+void UnloadRollbackSession(RollbackSession *session);
+
+// Remote input for one frame. Frames must come in order; ones already known
+// are skipped, as is anything past a gap, which a later packet resends.
+void AddRemoteInput(RollbackSession *session, int frame, RollbackInput input);
+// The peer has our input for every frame before frames
+void AckLocalInput(RollbackSession *session, int frames);
+void AddRemoteChecksum(RollbackSession *session, int frame, unsigned long long checksum);
+
+// First frame of our input the peer may still lack; it and every later
+// frame up to the present go in the next packet
+int UnackedLocalFrame(const RollbackSession *session);
+RollbackInput LocalInputAt(const RollbackSession *session, int frame);
+// How far this side runs past the remote input it has, to report to the peer
+int RollbackAdvantage(const RollbackSession *session);
+// Last frame whose checksum is final, -1 for none yet
+int ConfirmedRollbackFrame(const RollbackSession *session);
+unsigned long long GetRollbackChecksum(const RollbackSession *session, int frame);
+
+// Call once for every frame that is due. True when the frame should be let
+// pass without running: the window is full, or this side runs ahead of
+// the peer and holds back every other frame until they meet.
+bool RollbackShouldWait(RollbackSession *session);
+
+// Runs the pending rollback, if any, then one new frame on localInput.
+// False when the window is full.
+bool AdvanceRollback(RollbackSession *session, RollbackInput localInput);
+
+#endif // ROLLBACK_H
@@ -0,0 +1,147 @@
+#include "snapshot.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECKSUM_PRIME 0x9E3779B97F4A7C15ull
+
+static bool Reserve(SnapshotStream *stream, size_t size) {
+    if (size <= stream->capacity) return true;
+    size_t capacity = stream->capacity ? stream->capacity : sizeof(SnapshotHeader);
+    while (capacity < size) capacity *= 2;
+    unsigned char *data = realloc(stream->data, capacity);
+    if (!data) return false;
+    stream->data = data;
+    stream->capacity = capacity;
+    return true;
+}
+
+bool LoadSnapshotStream(SnapshotStream *stream, size_t capacity) {
+    UnloadSnapshotStream(stream);
+    if (capacity < sizeof(SnapshotHeader)) capacity = sizeof(SnapshotHeader);
+    return Reserve(stream, capacity);
+}
+
+void UnloadSnapshotStream(SnapshotStream *stream) {
+    free(stream->data);
+    memset(stream, 0, sizeof(*stream));
+}
+
+void BeginSnapshotWrite(SnapshotStream *stream, unsigned int version) {
+    stream->reading = false;
+    stream->failed = !Reserve(stream, sizeof(SnapshotHeader));
+    stream->cursor = sizeof(SnapshotHeader);
+    stream->size = 0;
+    if (!stream->failed) {
+        SnapshotHeader header = { SNAPSHOT_MAGIC, SNAPSHOT_FORMAT, version, 0, 0 };
+        memcpy(stream->data, &header, sizeof(header));
+    }
+}
+
+bool EndSnapshotWrite(SnapshotStream *stream) {
+    if (stream->failed) return false;
+    SnapshotHeader header;
+    memcpy(&header, stream->data, sizeof(header));
+    header.payloadSize = (unsigned int)(stream->cursor - sizeof(header));
+    header.checksum = SnapshotChecksum(stream->data + sizeof(header), header.payloadSize);
+    memcpy(stream->data, &header, sizeof(header));
+    stream->size = stream->cursor;
+    return true;
+}
+
+bool BeginSnapshotRead(SnapshotStream *stream, unsigned int version) {
+    stream->reading = true;
+    stream->cursor = sizeof(SnapshotHeader);
+    stream->failed = true;
+    if (stream->size < sizeof(SnapshotHeader)) return false;
+
+    SnapshotHeader header;
+    memcpy(&header, stream->data, sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.format != SNAPSHOT_FORMAT || header.version != version) return false;
+    if (header.payloadSize != stream->size - sizeof(header)) return false;
+    if (header.checksum != SnapshotChecksum(stream->data + sizeof(header), header.payloadSize)) return false;
+
+    stream->failed = false;
+    return true;
+}
+
+bool EndSnapshotRead(SnapshotStream *stream) {
+    return !stream->failed && stream->cursor == stream->size;
+}
+
+unsigned long long GetSnapshotChecksum(const SnapshotStream *stream) {
+    if (stream->size < sizeof(SnapshotHeader)) return 0;
+    SnapshotHeader header;
+    memcpy(&header, stream->data, sizeof(header));
+    return header.checksum;
+}
+
+void SnapshotBytes(SnapshotStream *stream, void *data, size_t size) {
+    if (stream->failed || size == 0) return;
+    if (stream->reading) {
+        if (stream->cursor + size > stream->size) {
+            stream->failed = true;
+            return;
+        }
+        memcpy(data, stream->data + stream->cursor, size);
+    } else {
+        if (!Reserve(stream, stream->cursor + size)) {
+            stream->failed = true;
+            return;
+        }
+        memcpy(stream->data + stream->cursor, data, size);
+    }
+    stream->cursor += size;
+}
+
+static unsigned long long Mix(unsigned long long h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+unsigned long long SnapshotChecksum(const void *data, size_t size) {
+    const unsigned char *bytes = data;
+    unsigned long long lanes[4] = { 1, 2, 3, 4 };
+    size_t i = 0;
+
+    // Four multiply chains in flight instead of one
+    for (; i + 32 <= size; i += 32) {
+        for (int k = 0; k < 4; k++) {
+            unsigned long long word;
+            memcpy(&word, bytes + i + 8 * k, 8);
+            lanes[k] = (lanes[k] ^ word) * CHECKSUM_PRIME;
+        }
+    }
+    unsigned long long h = (unsigned long long)size;
+    for (int k = 0; k < 4; k++) h = (h ^ Mix(lanes[k])) * CHECKSUM_PRIME;
+    for (; i < size; i++) h = (h ^ bytes[i]) * CHECKSUM_PRIME;
+    return Mix(h);
+}
+
+bool SaveSnapshotFile(const SnapshotStream *stream, const char *fileName) {
+    if (stream->size == 0) return false;
+    FILE *file = fopen(fileName, "wb");
+    if (!file) return false;
+    bool ok = fwrite(stream->data, 1, stream->size, file) == stream->size;
+    return (fclose(file) == 0) && ok;
+}
+
+bool LoadSnapshotFile(SnapshotStream *stream, const char *fileName) {
+    FILE *file = fopen(fileName, "rb");
+    if (!file) return false;
+
+    bool ok = false;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        long length = ftell(file);
+        if (length >= (long)sizeof(SnapshotHeader) && fseek(file, 0, SEEK_SET) == 0 && Reserve(stream, (size_t)length)) {
+            ok = fread(stream->data, 1, (size_t)length, file) == (size_t)length;
+            stream->size = ok ? (size_t)length : 0;
+        }
+    }
+    fclose(file);
+    return ok;
+}
@@ -0,0 +1,60 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Versioned binary snapshots. A snapshot is a small header (magic, format
+// version, the caller's state version, payload size and checksum) followed
+// by whatever the caller streams through SnapshotBytes. The same
+// serialize function both writes and reads, depending on the stream's
+// direction, so the save and load paths cannot drift apart. The buffer is
+// reused between snapshots, so once it has grown a snapshot is a run of
+// memcpys. Data is stored in native byte order and layout; the state
+// version is what keeps an old or foreign snapshot from being read back.
+#define SNAPSHOT_MAGIC 0x534C4C42u  // "BLLS"
+#define SNAPSHOT_FORMAT 1
+
+typedef struct {
+    unsigned int magic;
+    unsigned int format;
+    unsigned int version;           // the caller's state version
+    unsigned int payloadSize;
+    unsigned long long checksum;    // SnapshotChecksum of the payload
+} SnapshotHeader;
+
+typedef struct {
+    unsigned char *data;            // header, then payload
+    size_t capacity;
+    size_t size;                    // bytes written, or bytes in the snapshot being read
+    size_t cursor;
+    bool reading;
+    bool failed;                    // out of memory while writing, or a short or mismatched read
+} SnapshotStream;
+
+bool LoadSnapshotStream(SnapshotStream *stream, size_t capacity);
+void UnloadSnapshotStream(SnapshotStream *stream);
+
+void BeginSnapshotWrite(SnapshotStream *stream, unsigned int version);
+// Fills in the header; false when the payload could not be stored
+bool EndSnapshotWrite(SnapshotStream *stream);
+
+// Checks the header and checksum before anything is handed out, so a
+// rejected snapshot leaves the caller's state untouched
+bool BeginSnapshotRead(SnapshotStream *stream, unsigned int version);
+// True when the whole payload was read back, and nothing more
+bool EndSnapshotRead(SnapshotStream *stream);
+
+// Payload checksum from the header of a finished snapshot, 0 when there is none
+unsigned long long GetSnapshotChecksum(const SnapshotStream *stream);
+
+// Copies size bytes into the stream when writing, out of it when reading
+void SnapshotBytes(SnapshotStream *stream, void *data, size_t size);
+
+// 64-bit hash of a block, eight bytes at a time over four independent lanes
+unsigned long long SnapshotChecksum(const void *data, size_t size);
+
+bool SaveSnapshotFile(const SnapshotStream *stream, const char *fileName);
+bool LoadSnapshotFile(SnapshotStream *stream, const char *fileName);
+
+#endif // SNAPSHOT_H
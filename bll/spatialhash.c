@@ -0,0 +1,132 @@
+#include "spatialhash.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+static int CellCoord(const SpatialHash *hash, float v) {
+    return (int)floorf(v / hash->cellSize);
+}
+
+static int Bucket(const SpatialHash *hash, int cx, int cy) {
+    unsigned int h = (unsigned int)cx * 73856093u ^ (unsigned int)cy * 19349663u;
+    return (int)(h & (unsigned int)(hash->tableSize - 1));
+}
+
+void LoadSpatialHash(SpatialHash *hash, int capacity, float cellSize) {
+    UnloadSpatialHash(hash);
+    if (capacity < 1) capacity = 1;
+
+    hash->cellSize = (cellSize < 1.0f) ? 1.0f : cellSize;
+    hash->capacity = capacity;
+    hash->tableSize = 1;
+    while (hash->tableSize < capacity * 2) hash->tableSize <<= 1;
+
+    hash->bucketStart = calloc(hash->tableSize + 1, sizeof(int));
+    hash->ids = malloc(sizeof(int) * capacity);
+    hash->points = malloc(sizeof(Vector2) * capacity);
+    hash->cellX = malloc(sizeof(int) * capacity);
+    hash->cellY = malloc(sizeof(int) * capacity);
+    hash->scratch = malloc(sizeof(int) * capacity);
+    if (!hash->bucketStart || !hash->ids || !hash->points || !hash->cellX || !hash->cellY || !hash->scratch) {
+        UnloadSpatialHash(hash);
+    }
+}
+
+void UnloadSpatialHash(SpatialHash *hash) {
+    free(hash->bucketStart);
+    free(hash->ids);
+    free(hash->points);
+    free(hash->cellX);
+    free(hash->cellY);
+    free(hash->scratch);
+    memset(hash, 0, sizeof(*hash));
+}
+
+void BuildSpatialHash(SpatialHash *hash, const Vector2 *points, const int *ids, int count) {
+    if (hash->bucketStart == NULL) return;
+    if (count > hash->capacity) count = hash->capacity;
+    hash->count = count;
+
+    // Counting sort by bucket: tally, prefix-sum, scatter
+    memset(hash->bucketStart, 0, sizeof(int) * (hash->tableSize + 1));
+    for (int i = 0; i < count; i++) {
+        int b = Bucket(hash, CellCoord(hash, points[i].x), CellCoord(hash, points[i].y));
+        hash->scratch[i] = b;
+        hash->bucketStart[b + 1]++;
+    }
+    for (int b = 0; b < hash->tableSize; b++) hash->bucketStart[b + 1] += hash->bucketStart[b];
+
+    for (int i = 0; i < count; i++) {
+        int slot = hash->bucketStart[hash->scratch[i]]++;
+        hash->ids[slot] = ids[i];
+        hash->points[slot] = points[i];
+        hash->cellX[slot] = CellCoord(hash, points[i].x);
+        hash->cellY[slot] = CellCoord(hash, points[i].y);
+    }
+
+    // The scatter advanced every start to its bucket's end; shift them back
+    for (int b = hash->tableSize; b > 0; b--) hash->bucketStart[b] = hash->bucketStart[b - 1];
+    hash->bucketStart[0] = 0;
+}
+
+int QuerySpatialHash(const SpatialHash *hash, Vector2 center, float radius, int *results, int maxResults) {
+    if (hash->count == 0) return 0;
+
+    int x0 = CellCoord(hash, center.x - radius), x1 = CellCoord(hash, center.x + radius);
+    int y0 = CellCoord(hash, center.y - radius), y1 = CellCoord(hash, center.y + radius);
+    float radiusSq = radius * radius;
+    int found = 0;
+
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            int b = Bucket(hash, cx, cy);
+            for (int k = hash->bucketStart[b]; k < hash->bucketStart[b + 1]; k++) {
+                if (hash->cellX[k] != cx || hash->cellY[k] != cy) continue;
+                float dx = hash->points[k].x - center.x;
+                float dy = hash->points[k].y - center.y;
+                if (dx*dx + dy*dy <= radiusSq) {
+                    results[found++] = hash->ids[k];
+                    if (found == maxResults) return found;
+                }
+            }
+        }
+    }
+    return found;
+}
+
+int QuerySpatialHashRec(const SpatialHash *hash, Rectangle area, int *results, int maxResults) {
+    if (hash->count == 0) return 0;
+
+    float right = area.x + area.width, bottom = area.y + area.height;
+    int x0 = CellCoord(hash, area.x), x1 = CellCoord(hash, right);
+    int y0 = CellCoord(hash, area.y), y1 = CellCoord(hash, bottom);
+    int found = 0;
+
+    // A rectangle spanning more cells than there are points is cheaper to
+    // answer by testing every point
+    if ((long long)(x1 - x0 + 1) * (y1 - y0 + 1) > hash->count) {
+        for (int k = 0; k < hash->count; k++) {
+            Vector2 p = hash->points[k];
+            if (p.x >= area.x && p.x <= right && p.y >= area.y && p.y <= bottom) {
+                results[found++] = hash->ids[k];
+                if (found == maxResults) return found;
+            }
+        }
+        return found;
+    }
+
+    for (int cy = y0; cy <= y1; cy++) {
+        for (int cx = x0; cx <= x1; cx++) {
+            int b = Bucket(hash, cx, cy);
+            for (int k = hash->bucketStart[b]; k < hash->bucketStart[b + 1]; k++) {
+                if (hash->cellX[k] != cx || hash->cellY[k] != cy) continue;
+                Vector2 p = hash->points[k];
+                if (p.x >= area.x && p.x <= right && p.y >= area.y && p.y <= bottom) {
+                    results[found++] = hash->ids[k];
+                    if (found == maxResults) return found;
+                }
+            }
+        }
+    }
+    return found;
+}
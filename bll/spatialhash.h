@@ -0,0 +1,35 @@
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+
+#include "raylib.h"
+
+// Spatial hash over moving points, rebuilt from scratch every frame with a
+// counting sort. Points are bucketed by hashed grid cell and stored sorted by
+// bucket, so a radius query only touches the cells the circle overlaps.
+typedef struct {
+    float cellSize;
+    int capacity;
+    int tableSize;      // bucket count, a power of two
+    int count;
+    int *bucketStart;   // tableSize + 1 offsets into the sorted arrays
+    int *ids;           // caller ids, sorted by bucket
+    Vector2 *points;    // positions, sorted the same way
+    int *cellX;         // cell of each sorted entry, to reject other cells sharing a bucket
+    int *cellY;
+    int *scratch;
+} SpatialHash;
+
+void LoadSpatialHash(SpatialHash *hash, int capacity, float cellSize);
+void UnloadSpatialHash(SpatialHash *hash);
+
+// Replaces the contents with count points; ids are handed back by queries
+void BuildSpatialHash(SpatialHash *hash, const Vector2 *points, const int *ids, int count);
+
+// Writes the ids of points within radius of center into results and returns
+// how many were found (at most maxResults)
+int QuerySpatialHash(const SpatialHash *hash, Vector2 center, float radius, int *results, int maxResults);
+
+// Same for points inside a rectangle, such as the part of the world in view
+int QuerySpatialHashRec(const SpatialHash *hash, Rectangle area, int *results, int maxResults);
+
+#endif // SPATIALHASH_H
@@ -0,0 +1,65 @@
+#include "thread.h"
+#include <stdlib.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+static DWORD WINAPI ThreadEntry(LPVOID param) {
+    Thread *thread = (Thread *)param;
+    thread->func(thread->arg);
+    return 0;
+}
+#else
+static void *ThreadEntry(void *param) {
+    Thread *thread = (Thread *)param;
+    thread->func(thread->arg);
+    return NULL;
+}
+#endif
+
+bool StartThread(Thread *thread, ThreadFunc func, void *arg) {
+    thread->func = func;
+    thread->arg = arg;
+#if defined(_WIN32)
+    thread->handle = CreateThread(NULL, 0, ThreadEntry, thread, 0, NULL);
+    return thread->handle != NULL;
+#else
+    pthread_t *handle = malloc(sizeof(pthread_t));
+    if (handle == NULL || pthread_create(handle, NULL, ThreadEntry, thread) != 0) {
+        free(handle);
+        thread->handle = NULL;
+        return false;
+    }
+    thread->handle = handle;
+    return true;
+#endif
+}
+
+void JoinThread(Thread *thread) {
+    if (thread->handle == NULL) return;
+#if defined(_WIN32)
+    WaitForSingleObject((HANDLE)thread->handle, INFINITE);
+    CloseHandle((HANDLE)thread->handle);
+#else
+    pthread_join(*(pthread_t *)thread->handle, NULL);
+    free(thread->handle);
+#endif
+    thread->handle = NULL;
+}
+
+int GetCpuCount(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (count > 0) ? (int)count : 1;
+#endif
+}
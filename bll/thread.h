@@ -0,0 +1,20 @@
+#ifndef THREAD_H
+#define THREAD_H
+
+#include <stdbool.h>
+
+// Minimal portable thread wrapper: Win32 threads on Windows, pthreads elsewhere
+typedef void (*ThreadFunc)(void *arg);
+
+typedef struct {
+    void *handle;
+    ThreadFunc func;
+    void *arg;
+} Thread;
+
+// The Thread must stay alive until JoinThread returns
+bool StartThread(Thread *thread, ThreadFunc func, void *arg);
+void JoinThread(Thread *thread);
+int GetCpuCount(void);
+
+#endif // THREAD_H
@@ -0,0 +1,79 @@
+#include "throwpath.h"
+#include <math.h>
+
+void BuildThrowPath(ThrowPath *path, Vector2 center, float a, float b, float angle, float angularSpeed,
+                    float minX, float maxX) {
+    const float sweep = 3.14159265f / 2.0f;
+    float ca = cosf(angle), sa = sinf(angle);
+
+    for (int i = 0; i <= THROW_PATH_SEGMENTS; i++) {
+        float t = sweep * i / THROW_PATH_SEGMENTS;
+        float x = a * cosf(t);
+        float y = b * sinf(t);
+        Vector2 p = { center.x + x * ca - y * sa, center.y - x * sa - y * ca };
+        if (p.x < minX) p.x = minX;
+        if (p.x > maxX) p.x = maxX;
+        path->points[i] = p;
+    }
+    path->duration = (angularSpeed > 0.0f) ? sweep / angularSpeed : 0.0f;
+    path->segmentTime = path->duration / THROW_PATH_SEGMENTS;
+}
+
+// Segment index and the fraction along it for a time, clamped to the path
+static int Locate(const ThrowPath *path, float time, float *fraction) {
+    if (path->segmentTime <= 0.0f || time <= 0.0f) { *fraction = 0.0f; return 0; }
+    float s = time / path->segmentTime;
+    if (s >= THROW_PATH_SEGMENTS) { *fraction = 1.0f; return THROW_PATH_SEGMENTS - 1; }
+    int k = (int)s;
+    *fraction = s - k;
+    return k;
+}
+
+Vector2 ThrowPathPosition(const ThrowPath *path, float time) {
+    float f;
+    int k = Locate(path, time, &f);
+    Vector2 p0 = path->points[k], p1 = path->points[k + 1];
+    return (Vector2){ p0.x + (p1.x - p0.x) * f, p0.y + (p1.y - p0.y) * f };
+}
+
+Vector2 ThrowPathVelocity(const ThrowPath *path, float time) {
+    if (path->segmentTime <= 0.0f || time >= path->duration) return (Vector2){ 0.0f, 0.0f };
+    float f;
+    int k = Locate(path, time, &f);
+    Vector2 p0 = path->points[k], p1 = path->points[k + 1];
+    return (Vector2){ (p1.x - p0.x) / path->segmentTime, (p1.y - p0.y) / path->segmentTime };
+}
+
+// Solves |p0 + s*(p1 - p0) - center| = radius for the entering root in [s0, 1]
+bool ThrowPathFirstHit(const ThrowPath *path, float fromTime, Vector2 center, float radius, float *hitTime) {
+    if (path->segmentTime <= 0.0f || fromTime >= path->duration) return false;
+
+    float s0;
+    int first = Locate(path, fromTime, &s0);
+    for (int k = first; k < THROW_PATH_SEGMENTS; k++, s0 = 0.0f) {
+        Vector2 p0 = path->points[k], p1 = path->points[k + 1];
+        float dx = p1.x - p0.x, dy = p1.y - p0.y;
+        float fx = p0.x - center.x, fy = p0.y - center.y;
+
+        float qa = dx*dx + dy*dy;
+        float qb = 2.0f * (fx*dx + fy*dy);
+        float qc = fx*fx + fy*fy - radius*radius;
+
+        // Already touching where this stretch starts
+        float sx = fx + dx * s0, sy = fy + dy * s0;
+        if (sx*sx + sy*sy <= radius*radius) {
+            *hitTime = (k + s0) * path->segmentTime;
+            return true;
+        }
+        if (qa <= 0.0f) continue;
+
+        float disc = qb*qb - 4.0f*qa*qc;
+        if (disc < 0.0f) continue;
+        float s = (-qb - sqrtf(disc)) / (2.0f * qa);
+        if (s >= s0 && s <= 1.0f) {
+            *hitTime = (k + s) * path->segmentTime;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,32 @@
+#ifndef THROWPATH_H
+#define THROWPATH_H
+
+#include "raylib.h"
+#include <stdbool.h>
+
+// The bowling throw as a precomputed polyline. The quarter ellipse (rotated
+// by the aim angle and clamped to the lane) is sampled once at launch into
+// equal-time segments, so the ball's position at any time is a lerp and hit
+// tests against pins are exact segment/circle intersections. Nothing depends
+// on the frame rate.
+#define THROW_PATH_SEGMENTS 48
+
+typedef struct {
+    Vector2 points[THROW_PATH_SEGMENTS + 1];
+    float segmentTime;  // seconds per segment
+    float duration;     // seconds from launch to the end of the path
+} ThrowPath;
+
+// Samples center + rotate((a*cos(t), b*sin(t)), angle) for t in [0, PI/2],
+// covered at angularSpeed radians per second, with x clamped to [minX, maxX]
+void BuildThrowPath(ThrowPath *path, Vector2 center, float a, float b, float angle, float angularSpeed,
+                    float minX, float maxX);
+
+Vector2 ThrowPathPosition(const ThrowPath *path, float time);
+Vector2 ThrowPathVelocity(const ThrowPath *path, float time);
+
+// Earliest time >= fromTime at which the path comes within radius of center.
+// Returns false when it never does before the end of the path.
+bool ThrowPathFirstHit(const ThrowPath *path, float fromTime, Vector2 center, float radius, float *hitTime);
+
+#endif // THROWPATH_H
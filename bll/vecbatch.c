@@ -0,0 +1,165 @@
+#include "vecbatch.h"
+#include <math.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+    #define VECBATCH_SSE2
+    #include <emmintrin.h>
+#endif
+
+// Every kernel walks the arrays as floats: two vectors per SSE register for
+// the componentwise ops, four vectors split into x and y lanes for the rest.
+// The scalar tail (and non-SSE builds) repeats the raymath expressions.
+
+void Vector2AddBatch(Vector2 *out, const Vector2 *a, const Vector2 *b, int count) {
+    int i = 0;
+#if defined(VECBATCH_SSE2)
+    for (; i + 2 <= count; i += 2) {
+        __m128 sum = _mm_add_ps(_mm_loadu_ps(&a[i].x), _mm_loadu_ps(&b[i].x));
+        _mm_storeu_ps(&out[i].x, sum);
+    }
+#endif
+    for (; i < count; i++) {
+        out[i].x = a[i].x + b[i].x;
+        out[i].y = a[i].y + b[i].y;
+    }
+}
+
+void Vector2SubtractBatch(Vector2 *out, const Vector2 *a, const Vector2 *b, int count) {
+    int i = 0;
+#if defined(VECBATCH_SSE2)
+    for (; i + 2 <= count; i += 2) {
+        __m128 difference = _mm_sub_ps(_mm_loadu_ps(&a[i].x), _mm_loadu_ps(&b[i].x));
+        _mm_storeu_ps(&out[i].x, difference);
+    }
+#endif
+    for (; i < count; i++) {
+        out[i].x = a[i].x - b[i].x;
+        out[i].y = a[i].y - b[i].y;
+    }
+}
+
+void Vector2ScaleBatch(Vector2 *out, const Vector2 *v, float scale, int count) {
+    int i = 0;
+#if defined(VECBATCH_SSE2)
+    __m128 s = _mm_set1_ps(scale);
+    for (; i + 2 <= count; i += 2) {
+        _mm_storeu_ps(&out[i].x, _mm_mul_ps(_mm_loadu_ps(&v[i].x), s));
+    }
+#endif
+    for (; i < count; i++) {
+        out[i].x = v[i].x * scale;
+        out[i].y = v[i].y * scale;
+    }
+}
+
+void Vector2MoveBatch(Vector2 *positions, const Vector2 *velocities, float dt, int count) {
+    int i = 0;
+#if defined(VECBATCH_SSE2)
+    __m128 s = _mm_set1_ps(dt);
+    for (; i + 2 <= count; i += 2) {
+        __m128 step = _mm_mul_ps(_mm_loadu_ps(&velocities[i].x), s);
+        _mm_storeu_ps(&positions[i].x, _mm_add_ps(_mm_loadu_ps(&positions[i].x), step));
+    }
+#endif
+    for (; i < count; i++) {
+        positions[i].x = positions[i].x + velocities[i].x * dt;
+        positions[i].y = positions[i].y + velocities[i].y * dt;
+    }
+}
+
+#if defined(VECBATCH_SSE2)
+// Four Vector2s from v into x and y lanes
+static inline void LoadLanes(const Vector2 *v, __m128 *x, __m128 *y) {
+    __m128 lo = _mm_loadu_ps(&v[0].x);   // x0 y0 x1 y1
+    __m128 hi = _mm_loadu_ps(&v[2].x);   // x2 y2 x3 y3
+    *x = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+    *y = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+static inline void StoreLanes(Vector2 *v, __m128 x, __m128 y) {
+    _mm_storeu_ps(&v[0].x, _mm_unpacklo_ps(x, y));
+    _mm_storeu_ps(&v[2].x, _mm_unpackhi_ps(x, y));
+}
+#endif
+
+void Vector2LengthBatch(float *out, const Vector2 *v, int count) {
+    int i = 0;
+#if defined(VECBATCH_SSE2)
+    for (; i + 4 <= count; i += 4) {
+        __m128 x, y;
+        LoadLanes(&v[i], &x, &y);
+        _mm_storeu_ps(&out[i], _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y))));
+    }
+#endif
+    for (; i < count; i++) {
+        out[i] = sqrtf((v[i].x*v[i].x) + (v[i].y*v[i].y));
+    }
+}
+
+void Vector2NormalizeBatch(Vector2 *out, const Vector2 *v, int count) {
+    int i = 0;
+#if defined(VECBATCH_SSE2)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        __m128 x, y;
+        LoadLanes(&v[i], &x, &y);
+        __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)));
+        // A true division, not _mm_rsqrt_ps, so the result is exact. Zero
+        // lengths are masked to +0 afterwards rather than branched around
+        __m128 nonzero = _mm_cmpgt_ps(length, zero);
+        __m128 inverse = _mm_div_ps(one, length);
+        StoreLanes(&out[i], _mm_and_ps(_mm_mul_ps(x, inverse), nonzero), _mm_and_ps(_mm_mul_ps(y, inverse), nonzero));
+    }
+#endif
+    for (; i < count; i++) {
+        Vector2 result = { 0 };
+        float length = sqrtf((v[i].x*v[i].x) + (v[i].y*v[i].y));
+        if (length > 0) {
+            float ilength = 1.0f/length;
+            result.x = v[i].x*ilength;
+            result.y = v[i].y*ilength;
+        }
+        out[i] = result;
+    }
+}
+
+#if defined(VECBATCH_SSE2)
+// A four-lane compare mask spelled out as hit bytes, and its population count
+static const unsigned char maskBytes[16][4] = {
+    {0,0,0,0}, {1,0,0,0}, {0,1,0,0}, {1,1,0,0}, {0,0,1,0}, {1,0,1,0}, {0,1,1,0}, {1,1,1,0},
+    {0,0,0,1}, {1,0,0,1}, {0,1,0,1}, {1,1,0,1}, {0,0,1,1}, {1,0,1,1}, {0,1,1,1}, {1,1,1,1}
+};
+static const int maskCounts[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+#endif
+
+int CheckCollisionCirclesBatch(Vector2 center, float radius, const Vector2 *centers, const float *radii,
+                               int count, unsigned char *hits) {
+    int total = 0;
+    int i = 0;
+#if defined(VECBATCH_SSE2)
+    const __m128 cx = _mm_set1_ps(center.x);
+    const __m128 cy = _mm_set1_ps(center.y);
+    const __m128 r = _mm_set1_ps(radius);
+    for (; i + 4 <= count; i += 4) {
+        __m128 x, y;
+        LoadLanes(&centers[i], &x, &y);
+        __m128 dx = _mm_sub_ps(x, cx);
+        __m128 dy = _mm_sub_ps(y, cy);
+        __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 radiusSum = _mm_add_ps(r, _mm_loadu_ps(&radii[i]));
+        int mask = _mm_movemask_ps(_mm_cmple_ps(distanceSquared, _mm_mul_ps(radiusSum, radiusSum)));
+        memcpy(&hits[i], maskBytes[mask], 4);
+        total += maskCounts[mask];
+    }
+#endif
+    for (; i < count; i++) {
+        float dx = centers[i].x - center.x;
+        float dy = centers[i].y - center.y;
+        float radiusSum = radius + radii[i];
+        hits[i] = (dx*dx + dy*dy) <= (radiusSum*radiusSum);
+        total += hits[i];
+    }
+    return total;
+}
@@ -0,0 +1,27 @@
+#ifndef VECBATCH_H
+#define VECBATCH_H
+
+#include "raylib.h"
+
+// Array versions of the raymath/raylib vector helpers the hot loops use,
+// four vectors at a time with SSE2 where the compiler targets it and plain
+// loops elsewhere. Results match the scalar functions bit for bit: the same
+// IEEE operations run in the same order, only several lanes at once. Output
+// arrays may alias the inputs.
+
+void Vector2AddBatch(Vector2 *out, const Vector2 *a, const Vector2 *b, int count);
+void Vector2SubtractBatch(Vector2 *out, const Vector2 *a, const Vector2 *b, int count);
+void Vector2ScaleBatch(Vector2 *out, const Vector2 *v, float scale, int count);
+void Vector2LengthBatch(float *out, const Vector2 *v, int count);
+// Zero vectors stay zero, as in Vector2Normalize
+void Vector2NormalizeBatch(Vector2 *out, const Vector2 *v, int count);
+
+// positions[i] += velocities[i] * dt, the bullet and enemy movement step
+void Vector2MoveBatch(Vector2 *positions, const Vector2 *velocities, float dt, int count);
+
+// One circle against many, as CheckCollisionCircles. hits[i] is set to 0 or
+// 1; returns how many hit.
+int CheckCollisionCirclesBatch(Vector2 center, float radius, const Vector2 *centers, const float *radii,
+                               int count, unsigned char *hits);
+
+#endif // VECBATCH_H
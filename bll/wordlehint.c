@@ -0,0 +1,313 @@
+#include "wordlehint.h"
+#include "thread.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#define MAX_HINT_THREADS 16
+
+typedef unsigned char Letters[DICTIONARY_WORD_LENGTH];
+
+static void Unpack(WordKey key, unsigned char *letters) {
+    for (int i = DICTIONARY_WORD_LENGTH - 1; i >= 0; i--) {
+        letters[i] = (unsigned char)(key & 31);
+        key >>= 5;
+    }
+}
+
+// Same rules as the game: exact matches first, then present letters while
+// the answer still has unmatched copies of them
+static int Feedback(const unsigned char *guess, const unsigned char *answer) {
+    unsigned char remaining[32] = {0};
+    int pattern = 0;
+    for (int i = 0; i < DICTIONARY_WORD_LENGTH; i++) {
+        if (guess[i] == answer[i]) pattern |= 2 << (2 * i);
+        else remaining[answer[i]]++;
+    }
+    for (int i = 0; i < DICTIONARY_WORD_LENGTH; i++) {
+        if (guess[i] != answer[i] && remaining[guess[i]] > 0) {
+            pattern |= 1 << (2 * i);
+            remaining[guess[i]]--;
+        }
+    }
+    return pattern;
+}
+
+static bool HasDistinctLetters(const unsigned char *word) {
+    unsigned int seen = 0;
+    for (int i = 0; i < DICTIONARY_WORD_LENGTH; i++) {
+        if (seen & (1u << word[i])) return false;
+        seen |= 1u << word[i];
+    }
+    return true;
+}
+
+int WordleFeedback(WordKey guess, WordKey answer) {
+    Letters g, a;
+    Unpack(guess, g);
+    Unpack(answer, a);
+    return Feedback(g, a);
+}
+
+int FilterWordleCandidates(const WordList *answers, const WordKey *guesses, const int *patterns,
+                           int guessCount, WordKey *out) {
+    Letters g[WORDLE_MAX_GUESSES];
+    if (guessCount > WORDLE_MAX_GUESSES) guessCount = WORDLE_MAX_GUESSES;
+    for (int k = 0; k < guessCount; k++) Unpack(guesses[k], g[k]);
+
+    int count = 0;
+    for (int i = 0; i < answers->count; i++) {
+        Letters a;
+        Unpack(answers->keys[i], a);
+        bool consistent = true;
+        for (int k = 0; k < guessCount && consistent; k++) {
+            consistent = (Feedback(g[k], a) == patterns[k]);
+        }
+        if (consistent) out[count++] = answers->keys[i];
+    }
+    return count;
+}
+
+// Candidates are stored one array per letter position plus a 26-bit letter
+// set per word, so the scoring loop below runs over contiguous bytes and
+// the compiler can vectorise it
+typedef struct {
+    unsigned char *letters[DICTIONARY_WORD_LENGTH];
+    unsigned int *sets;
+    int count;
+} CandidateSet;
+
+typedef struct {
+    const Letters *words;
+    int begin, end;
+    const CandidateSet *candidates;
+    int best;           // index into words
+    double bestScore;
+} ScoreJob;
+
+// For a guess without repeated letters, a letter that is not exact is present
+// exactly when the answer contains it anywhere: any other answer position
+// holding it cannot be exact, since the guess has that letter only once
+static void PatternsDistinct(const unsigned char *guess, const CandidateSet *set, unsigned short *patterns) {
+    for (int c = 0; c < set->count; c++) {
+        unsigned int letters = set->sets[c];
+        int pattern = 0;
+        for (int i = 0; i < DICTIONARY_WORD_LENGTH; i++) {
+            int exact = (set->letters[i][c] == guess[i]);
+            int present = (int)(letters >> guess[i]) & 1;
+            pattern |= (exact ? 2 : present) << (2 * i);
+        }
+        patterns[c] = (unsigned short)pattern;
+    }
+}
+
+// Letters that occur once in the guess still follow the rule above. A
+// repeated letter is present while the answer has spare copies of it: copies
+// at positions where the guess has a different letter (so no exact match used
+// them), minus those claimed by earlier marks of the same letter
+static void PatternsRepeated(const unsigned char *guess, const CandidateSet *set, unsigned short *patterns) {
+    int repeated = 0;
+    for (int i = 0; i < DICTIONARY_WORD_LENGTH; i++) {
+        for (int j = 0; j < DICTIONARY_WORD_LENGTH; j++) {
+            if (j != i && guess[j] == guess[i]) repeated |= 1 << i;
+        }
+    }
+
+    for (int c = 0; c < set->count; c++) {
+        unsigned char answer[DICTIONARY_WORD_LENGTH];
+        int exact[DICTIONARY_WORD_LENGTH];
+        for (int i = 0; i < DICTIONARY_WORD_LENGTH; i++) {
+            answer[i] = set->letters[i][c];
+            exact[i] = (answer[i] == guess[i]);
+        }
+
+        int pattern = 0;
+        for (int i = 0; i < DICTIONARY_WORD_LENGTH; i++) {
+            int present;
+            if (exact[i]) {
+                present = 0;
+            } else if (repeated & (1 << i)) {
+                int spare = 0;
+                for (int j = 0; j < DICTIONARY_WORD_LENGTH; j++) {
+                    if (answer[j] == guess[i] && guess[j] != guess[i]) spare++;
+                }
+                for (int j = 0; j < i; j++) {
+                    if (guess[j] == guess[i] && !exact[j]) spare--;
+                }
+                present = (spare > 0);
+            } else {
+                present = (int)(set->sets[c] >> guess[i]) & 1;
+            }
+            pattern |= (exact[i] ? 2 : present) << (2 * i);
+        }
+        patterns[c] = (unsigned short)pattern;
+    }
+}
+
+// Lower sum of n*log2(n) over pattern buckets means higher entropy
+static void ScoreRange(void *arg) {
+    ScoreJob *job = (ScoreJob *)arg;
+    const CandidateSet *set = job->candidates;
+    int histogram[WORDLE_PATTERNS];
+    unsigned short *patterns = malloc(sizeof(unsigned short) * set->count);
+    job->best = -1;
+    job->bestScore = 0.0;
+    if (patterns == NULL) return;
+
+    // Buckets are scored and emptied through the candidates' own patterns
+    // rather than a sweep of all of them, so few candidates cost little
+    memset(histogram, 0, sizeof(histogram));
+    for (int w = job->begin; w < job->end; w++) {
+        if (HasDistinctLetters(job->words[w])) PatternsDistinct(job->words[w], set, patterns);
+        else PatternsRepeated(job->words[w], set, patterns);
+
+        for (int c = 0; c < set->count; c++) histogram[patterns[c]]++;
+        bool solves = histogram[WORDLE_SOLVED] > 0;
+
+        double score = 0.0;
+        for (int c = 0; c < set->count; c++) {
+            int n = histogram[patterns[c]];
+            if (n > 1) score += n * log2((double)n);
+            histogram[patterns[c]] = 0;
+        }
+        // Prefer a guess that could itself be the answer when the information ties
+        if (solves) score -= 1e-6;
+        if (job->best < 0 || score < job->bestScore) {
+            job->best = w;
+            job->bestScore = score;
+        }
+    }
+    free(patterns);
+}
+
+typedef struct {
+    long long split;
+    int index;
+} RankedWord;
+
+static int CompareRanked(const void *a, const void *b) {
+    const RankedWord *x = a, *y = b;
+    if (x->split != y->split) return (x->split > y->split) ? -1 : 1;
+    return x->index - y->index;
+}
+
+// Cheap stand-in for entropy: a letter found in about half the candidates, or
+// in a spot where about half have it, splits them best. Keeps the limit words
+// that split best, in their original order so ties still go the same way.
+static int PruneGuesses(const WordKey *pool, int poolCount, const CandidateSet *set, int limit, WordKey *out) {
+    RankedWord *ranked = malloc(sizeof(RankedWord) * poolCount);
+    if (ranked == NULL) return 0;
+    long long n = set->count;
+    long long anywhere[32] = {0}, at[DICTIONARY_WORD_LENGTH][32] = {{0}};
+    for (int c = 0; c < set->count; c++) {
+        for (int l = 0; l < 32; l++) anywhere[l] += (set->sets[c] >> l) & 1;
+        for (int i = 0; i < DICTIONARY_WORD_LENGTH; i++) at[i][set->letters[i][c]]++;
+    }
+    for (int w = 0; w < poolCount; w++) {
+        Letters letters;
+        Unpack(pool[w], letters);
+        unsigned int seen = 0;
+        long long split = 0;
+        for (int i = 0; i < DICTIONARY_WORD_LENGTH; i++) {
+            split += at[i][letters[i]] * (n - at[i][letters[i]]);
+            if (!(seen & (1u << letters[i]))) split += anywhere[letters[i]] * (n - anywhere[letters[i]]);
+            seen |= 1u << letters[i];
+        }
+        ranked[w] = (RankedWord){ split, w };
+    }
+    qsort(ranked, poolCount, sizeof(RankedWord), CompareRanked);
+    if (limit > poolCount) limit = poolCount;
+    for (int w = 0; w < limit; w++) ranked[w].split = 0;
+    qsort(ranked, limit, sizeof(RankedWord), CompareRanked);
+    for (int w = 0; w < limit; w++) out[w] = pool[ranked[w].index];
+    free(ranked);
+    return limit;
+}
+
+WordleHint SuggestWordleGuess(const WordList *allowed, const WordKey *candidates, int candidateCount,
+                              int maxPairs, int threadCount) {
+    WordleHint hint = { 0, 0.0f, candidateCount };
+    if (candidateCount <= 0) return hint;
+    if (candidateCount <= 2) {
+        hint.guess = candidates[0];
+        hint.entropy = (candidateCount == 2) ? 1.0f : 0.0f;
+        return hint;
+    }
+
+    const WordKey *pool = (allowed != NULL && allowed->count > 0) ? allowed->keys : candidates;
+    int poolCount = (allowed != NULL && allowed->count > 0) ? allowed->count : candidateCount;
+
+    unsigned char *block = malloc((DICTIONARY_WORD_LENGTH + sizeof(unsigned int)) * candidateCount);
+    if (block == NULL) return hint;
+    CandidateSet set = { .count = candidateCount };
+    set.sets = (unsigned int *)block;
+    for (int i = 0; i < DICTIONARY_WORD_LENGTH; i++) {
+        set.letters[i] = block + sizeof(unsigned int) * candidateCount + i * candidateCount;
+    }
+    for (int c = 0; c < candidateCount; c++) {
+        Letters letters;
+        Unpack(candidates[c], letters);
+        set.sets[c] = 0;
+        for (int i = 0; i < DICTIONARY_WORD_LENGTH; i++) {
+            set.letters[i][c] = letters[i];
+            set.sets[c] |= 1u << letters[i];
+        }
+    }
+
+    WordKey *pruned = NULL;
+    if (maxPairs > 0 && (long long)poolCount * candidateCount > maxPairs) {
+        int limit = (maxPairs / candidateCount > 0) ? maxPairs / candidateCount : 1;
+        pruned = malloc(sizeof(WordKey) * limit);
+        int kept = (pruned != NULL) ? PruneGuesses(pool, poolCount, &set, limit, pruned) : 0;
+        if (kept > 0) {
+            pool = pruned;
+            poolCount = kept;
+        }
+    }
+    Letters *words = malloc(sizeof(Letters) * poolCount);
+    if (words == NULL) {
+        free(words);
+        free(pruned);
+        free(block);
+        return hint;
+    }
+    for (int i = 0; i < poolCount; i++) Unpack(pool[i], words[i]);
+
+    if (threadCount <= 0) threadCount = GetCpuCount();
+    if (threadCount > MAX_HINT_THREADS) threadCount = MAX_HINT_THREADS;
+    if (threadCount > poolCount) threadCount = poolCount;
+
+    ScoreJob jobs[MAX_HINT_THREADS];
+    Thread threads[MAX_HINT_THREADS];
+    bool started[MAX_HINT_THREADS] = {0};
+    for (int t = 0; t < threadCount; t++) {
+        jobs[t] = (ScoreJob){ words, poolCount * t / threadCount, poolCount * (t + 1) / threadCount, &set, -1, 0.0 };
+    }
+    // The calling thread takes the first slice; a worker that fails to start runs inline
+    for (int t = 1; t < threadCount; t++) {
+        started[t] = StartThread(&threads[t], ScoreRange, &jobs[t]);
+        if (!started[t]) ScoreRange(&jobs[t]);
+    }
+    ScoreRange(&jobs[0]);
+    for (int t = 1; t < threadCount; t++) {
+        if (started[t]) JoinThread(&threads[t]);
+    }
+
+    int best = -1;
+    double bestScore = 0.0;
+    for (int t = 0; t < threadCount; t++) {
+        if (jobs[t].best >= 0 && (best < 0 || jobs[t].bestScore < bestScore)) {
+            best = jobs[t].best;
+            bestScore = jobs[t].bestScore;
+        }
+    }
+    if (best >= 0) {
+        hint.guess = pool[best];
+        hint.entropy = (float)(log2((double)candidateCount) - bestScore / candidateCount);
+    }
+
+    free(words);
+    free(pruned);
+    free(block);
+    return hint;
+}
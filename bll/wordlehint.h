@@ -0,0 +1,37 @@
+#ifndef WORDLEHINT_H
+#define WORDLEHINT_H
+
+#include "dictionary.h"
+
+// Wordle hint engine. Feedback patterns are packed two bits per letter
+// (0: absent, 1: present elsewhere, 2: exact), ten bits for a whole word.
+// A hint is the allowed word whose pattern distribution over the remaining
+// candidate answers has the highest entropy, i.e. the best expected
+// information. Scoring is split across worker threads.
+#define WORDLE_PATTERNS (1 << (2 * DICTIONARY_WORD_LENGTH))
+#define WORDLE_SOLVED   0x2AA // every letter exact
+
+int WordleFeedback(WordKey guess, WordKey answer);
+
+#define WORDLE_MAX_GUESSES 8
+
+// Writes the answers consistent with every guess/pattern pair into out and
+// returns how many there are. Only the first WORDLE_MAX_GUESSES guesses count.
+int FilterWordleCandidates(const WordList *answers, const WordKey *guesses, const int *patterns,
+                           int guessCount, WordKey *out);
+
+typedef struct {
+    WordKey guess;      // 0 when there is nothing to suggest
+    float entropy;      // expected information in bits
+    int candidates;     // answers still possible before the hint is played
+} WordleHint;
+
+// Scores every word in allowed (or the candidates themselves when allowed is
+// empty) against the candidates. Work grows with guesses x candidates: past
+// maxPairs, only the guesses whose letters split the candidates most evenly
+// are scored, as many as fit. maxPairs <= 0 scores them all. threadCount <= 0
+// uses every core.
+WordleHint SuggestWordleGuess(const WordList *allowed, const WordKey *candidates, int candidateCount,
+                              int maxPairs, int threadCount);
+
+#endif // WORDLEHINT_H